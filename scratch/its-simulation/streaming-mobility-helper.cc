@@ -0,0 +1,154 @@
+#include "streaming-mobility-helper.h"
+#include "ns3/log.h"
+#include "ns3/fatal-error.h"
+#include "ns3/simulator.h"
+#include "ns3/node.h"
+
+#include <cmath>
+#include <cstdio>
+
+NS_LOG_COMPONENT_DEFINE ("StreamingNs2MobilityHelper");
+
+namespace ns3 {
+
+Ns2TraceStream::Ns2TraceStream(const std::string& fileName, Time window, NodeContainer nodes)
+    : m_fileName(fileName),
+      m_file(fileName.c_str()),
+      m_line(0),
+      m_window(window),
+      m_hasNext(false)
+{
+    if (!m_file.is_open()) {
+        NS_FATAL_ERROR("Could not open trace file " << fileName);
+    }
+    NS_ASSERT_MSG(window.IsStrictlyPositive(), "trace window must be positive");
+
+    // 与 Ns2MobilityHelper 相同, 使用 ConstantVelocityMobilityModel
+    for (NodeContainer::Iterator i = nodes.Begin(); i != nodes.End(); ++i) {
+        Ptr<ConstantVelocityMobilityModel> model = (*i)->GetObject<ConstantVelocityMobilityModel>();
+        if (model == 0) {
+            model = CreateObject<ConstantVelocityMobilityModel>();
+            (*i)->AggregateObject(model);
+        }
+        m_models.push_back(model);
+    }
+    m_stops.resize(m_models.size());
+}
+
+void
+Ns2TraceStream::Start(void)
+{
+    // 第一条带时间的命令之前是各节点的初始位置, 在 ReadNext 中直接设置
+    m_hasNext = ReadNext();
+    ReadWindow();
+}
+
+bool
+Ns2TraceStream::ReadNext(void)
+{
+    std::string line;
+    while (std::getline(m_file, line)) {
+        m_line++;
+        Ns2TraceCommand command;
+        char axis;
+        if (std::sscanf(line.c_str(), " $ns_ at %lf \"$node_(%u) setdest %lf %lf %lf\"",
+                        &command.time, &command.node, &command.a, &command.b, &command.c) == 5) {
+            command.kind = Ns2TraceCommand::SETDEST;
+        } else if (std::sscanf(line.c_str(), " $ns_ at %lf \"$node_(%u) set %c_ %lf\"",
+                               &command.time, &command.node, &axis, &command.b) == 4
+                   && axis >= 'X' && axis <= 'Z') {
+            command.kind = Ns2TraceCommand::SET_POS;
+            command.a = axis - 'X';
+        } else if (std::sscanf(line.c_str(), " $node_(%u) set %c_ %lf",
+                               &command.node, &axis, &command.b) == 3
+                   && axis >= 'X' && axis <= 'Z') {
+            // 不带时间的位置: 立即生效
+            command.time = Simulator::Now().GetSeconds();
+            command.kind = Ns2TraceCommand::SET_POS;
+            command.a = axis - 'X';
+            Apply(command);
+            continue;
+        } else {
+            continue;
+        }
+        if (command.node >= m_models.size()) {
+            continue;
+        }
+        m_next = command;
+        return true;
+    }
+    return false;
+}
+
+void
+Ns2TraceStream::ReadWindow(void)
+{
+    Time now = Simulator::Now();
+    Time end = now + m_window;
+    while (m_hasNext && Seconds(m_next.time) < end) {
+        Time delay = Seconds(m_next.time) - now;
+        if (delay.IsStrictlyNegative()) {
+            NS_LOG_WARN(m_fileName << ":" << m_line << ": trace is not sorted by time, command at "
+                        << m_next.time << "s applied at " << now.GetSeconds() << "s");
+            delay = Seconds(0);
+        }
+        Simulator::Schedule(delay, &Ns2TraceStream::Apply, Ptr<Ns2TraceStream>(this), m_next);
+        m_hasNext = ReadNext();
+    }
+    if (m_hasNext) {
+        Simulator::Schedule(m_window, &Ns2TraceStream::ReadWindow, Ptr<Ns2TraceStream>(this));
+    }
+}
+
+void
+Ns2TraceStream::Apply(Ns2TraceCommand command)
+{
+    Ptr<ConstantVelocityMobilityModel> model = m_models[command.node];
+    if (command.kind == Ns2TraceCommand::SET_POS) {
+        Vector position = model->GetPosition();
+        if (command.a == 0) {
+            position.x = command.b;
+        } else if (command.a == 1) {
+            position.y = command.b;
+        } else {
+            position.z = command.b;
+        }
+        model->SetPosition(position);
+        return;
+    }
+
+    // 新的 setdest 取消尚未到达的目的地
+    Simulator::Cancel(m_stops[command.node]);
+    Vector position = model->GetPosition();
+    double dx = command.a - position.x;
+    double dy = command.b - position.y;
+    double distance = std::sqrt(dx * dx + dy * dy);
+    if (command.c <= 0 || distance == 0) {
+        model->SetVelocity(Vector(0, 0, 0));
+        return;
+    }
+    model->SetVelocity(Vector(command.c * dx / distance, command.c * dy / distance, 0));
+    m_stops[command.node] = Simulator::Schedule(Seconds(distance / command.c), &Ns2TraceStream::Stop,
+                                                Ptr<Ns2TraceStream>(this), command.node);
+}
+
+void
+Ns2TraceStream::Stop(uint32_t node)
+{
+    m_models[node]->SetVelocity(Vector(0, 0, 0));
+}
+
+StreamingNs2MobilityHelper::StreamingNs2MobilityHelper(std::string fileName, Time window)
+    : m_fileName(fileName),
+      m_window(window)
+{
+}
+
+void
+StreamingNs2MobilityHelper::Install(NodeContainer nodes) const
+{
+    Ptr<Ns2TraceStream> stream = Create<Ns2TraceStream>(m_fileName, m_window, nodes);
+    stream->Start();
+}
+
+} // namespace ns3
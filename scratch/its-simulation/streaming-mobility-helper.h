@@ -0,0 +1,77 @@
+#ifndef STREAMING_MOBILITY_HELPER_H
+#define STREAMING_MOBILITY_HELPER_H
+
+#include "ns3/constant-velocity-mobility-model.h"
+#include "ns3/event-id.h"
+#include "ns3/node-container.h"
+#include "ns3/nstime.h"
+#include "ns3/ptr.h"
+#include "ns3/simple-ref-count.h"
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace ns3 {
+
+// 一条带时间的 ns-2 轨迹命令
+struct Ns2TraceCommand {
+    enum Kind {
+        SETDEST,    // "$node_(i) setdest x y speed"
+        SET_POS     // "$node_(i) set X_ v"
+    };
+
+    double time;
+    uint32_t node;
+    Kind kind;
+    double a;   // setdest: x; set: 坐标轴 (0, 1, 2)
+    double b;   // setdest: y; set: 坐标值
+    double c;   // setdest: speed
+};
+
+// 按时间窗流式读取的 ns-2 轨迹 (由 Install 创建, 被事件引用而存活)
+class Ns2TraceStream : public SimpleRefCount<Ns2TraceStream> {
+public:
+    Ns2TraceStream(const std::string& fileName, Time window, NodeContainer nodes);
+
+    // 读取初始位置, 并调度第一个时间窗
+    void Start(void);
+
+private:
+    // 调度 [Now, Now + window) 内的命令, 然后在窗口结束时读取下一个
+    void ReadWindow(void);
+
+    // 读取下一条带时间的命令到 m_next, 文件结束时返回 false
+    bool ReadNext(void);
+
+    void Apply(Ns2TraceCommand command);
+
+    void Stop(uint32_t node);
+
+    std::string m_fileName;
+    std::ifstream m_file;
+    uint64_t m_line;
+    Time m_window;
+    std::vector<Ptr<ConstantVelocityMobilityModel>> m_models;
+    std::vector<EventId> m_stops;   // 每个节点到达目的地的事件
+    Ns2TraceCommand m_next;
+    bool m_hasNext;
+};
+
+// Ns2MobilityHelper 的流式版本: 不再一次读入整个轨迹并为每个节点调度全部事件,
+// 只保留下一个时间窗的命令. 要求轨迹按时间排序 (SUMO traceExporter.py 的输出即是如此).
+class StreamingNs2MobilityHelper {
+public:
+    StreamingNs2MobilityHelper(std::string fileName, Time window = Seconds(10.0));
+
+    // 轨迹中的 node_(i) 驱动 nodes 中的第 i 个节点
+    void Install(NodeContainer nodes) const;
+
+private:
+    std::string m_fileName;
+    Time m_window;
+};
+
+} // namespace ns3
+
+#endif /* STREAMING_MOBILITY_HELPER_H */
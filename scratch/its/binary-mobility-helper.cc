@@ -0,0 +1,165 @@
+#include "binary-mobility-helper.h"
+
+#include <cstdio>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace ns3 {
+namespace vanet {
+
+// positions this close are the same, the model drifts by rounding only
+static const double Position_Tolerance = 1e-3;
+
+const uint32_t WaypointTrace::Magic;
+const uint32_t WaypointTrace::Version;
+
+WaypointTrace::WaypointTrace (const std::string& fileName)
+  : m_map (MAP_FAILED),
+    m_size (0),
+    m_header (0),
+    m_nodes (0),
+    m_waypoints (0)
+{
+  int fd = open (fileName.c_str (), O_RDONLY);
+  if (fd < 0)
+    {
+      NS_FATAL_ERROR ("Could not open waypoint trace " << fileName);
+    }
+  struct stat st;
+  if (fstat (fd, &st) != 0 || (size_t) st.st_size < sizeof (Header))
+    {
+      close (fd);
+      NS_FATAL_ERROR (fileName << " is not a waypoint trace");
+    }
+  m_size = st.st_size;
+  m_map = mmap (0, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close (fd);
+  if (m_map == MAP_FAILED)
+    {
+      NS_FATAL_ERROR ("Could not map waypoint trace " << fileName);
+    }
+
+  m_header = static_cast<const Header *> (m_map);
+  if (m_header->magic != Magic || m_header->version != Version)
+    {
+      NS_FATAL_ERROR (fileName << " is not a version " << Version << " waypoint trace");
+    }
+  size_t tableEnd = sizeof (Header) + (size_t) m_header->nNodes * sizeof (NodeEntry);
+  NS_ABORT_MSG_IF (tableEnd > m_size, "waypoint trace " << fileName << " is truncated");
+  m_nodes = reinterpret_cast<const NodeEntry *> (static_cast<const uint8_t *> (m_map) + sizeof (Header));
+  m_waypoints = reinterpret_cast<const Waypoint *> (static_cast<const uint8_t *> (m_map) + tableEnd);
+
+  // the table is checked once, so the accessors need not
+  uint64_t nWaypoints = (m_size - tableEnd) / sizeof (Waypoint);
+  for (uint32_t i = 0; i < m_header->nNodes; i++)
+    {
+      NS_ABORT_MSG_IF (m_nodes[i].first > nWaypoints || m_nodes[i].count > nWaypoints - m_nodes[i].first,
+		       "waypoint trace " << fileName << " is truncated");
+    }
+}
+
+WaypointTrace::~WaypointTrace ()
+{
+  munmap (m_map, m_size);
+}
+
+bool
+WaypointTrace::IsWaypointTrace (const std::string& fileName)
+{
+  std::FILE *file = std::fopen (fileName.c_str (), "rb");
+  if (file == 0)
+    {
+      return false;
+    }
+  uint32_t magic = 0;
+  bool ok = std::fread (&magic, sizeof (magic), 1, file) == 1 && magic == Magic;
+  std::fclose (file);
+  return ok;
+}
+
+uint32_t
+WaypointTrace::GetNNodes () const
+{
+  return m_header->nNodes;
+}
+
+uint64_t
+WaypointTrace::GetNWaypoints (uint32_t node) const
+{
+  return m_nodes[node].count;
+}
+
+const WaypointTrace::Waypoint *
+WaypointTrace::GetWaypoints (uint32_t node) const
+{
+  return m_waypoints + m_nodes[node].first;
+}
+
+BinaryMobilityHelper::BinaryMobilityHelper (const std::string& fileName)
+  : m_trace (Create<WaypointTrace> (fileName))
+{
+}
+
+void
+BinaryMobilityHelper::Install (NodeContainer::Iterator first, NodeContainer::Iterator last) const
+{
+  uint32_t node = 0;
+  for (; first != last && node < m_trace->GetNNodes (); ++first, ++node)
+    {
+      Ptr<Node> object = *first;
+      Ptr<ConstantVelocityMobilityModel> model = object->GetObject<ConstantVelocityMobilityModel> ();
+      if (model == 0)
+	{
+	  model = CreateObject<ConstantVelocityMobilityModel> ();
+	  object->AggregateObject (model);
+	}
+      if (m_trace->GetNWaypoints (node) == 0) continue;
+
+      const WaypointTrace::Waypoint& wp = m_trace->GetWaypoints (node)[0];
+      model->SetPosition (Vector (wp.x, wp.y, wp.z));
+      Simulator::Schedule (Seconds (wp.time) - Simulator::Now (), &BinaryMobilityHelper::Advance,
+			   Ptr<const WaypointTrace> (m_trace), model, node, (uint64_t) 0);
+    }
+}
+
+void
+BinaryMobilityHelper::Advance (Ptr<const WaypointTrace> trace, Ptr<ConstantVelocityMobilityModel> model, uint32_t node, uint64_t index)
+{
+  uint64_t count = trace->GetNWaypoints (node);
+  const WaypointTrace::Waypoint *wp = trace->GetWaypoints (node);
+
+  // waypoints sharing a time are a jump, the last one is where the node is
+  while (index + 1 < count && wp[index + 1].time <= wp[index].time)
+    {
+      index++;
+    }
+
+  Vector position (wp[index].x, wp[index].y, wp[index].z);
+  if (CalculateDistance (model->GetPosition (), position) > Position_Tolerance)
+    {
+      model->SetPosition (position);
+    }
+
+  // stands still after the last waypoint
+  Vector velocity (0.0, 0.0, 0.0);
+  if (index + 1 < count)
+    {
+      const WaypointTrace::Waypoint& next = wp[index + 1];
+      double dt = next.time - wp[index].time;
+      velocity = Vector ((next.x - wp[index].x) / dt, (next.y - wp[index].y) / dt, (next.z - wp[index].z) / dt);
+      Simulator::Schedule (Seconds (next.time) - Simulator::Now (), &BinaryMobilityHelper::Advance,
+			   trace, model, node, index + 1);
+    }
+
+  // a waypoint on a straight stretch is no course change
+  Vector current = model->GetVelocity ();
+  if (current.x != velocity.x || current.y != velocity.y || current.z != velocity.z)
+    {
+      model->SetVelocity (velocity);
+    }
+}
+
+} // namespace vanet
+} // namespace ns3
@@ -0,0 +1,123 @@
+#ifndef SCRATCH_VANET_CS_VFC_BINARY_MOBILITY_HELPER_H_
+#define SCRATCH_VANET_CS_VFC_BINARY_MOBILITY_HELPER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/mobility-module.h"
+
+namespace ns3 {
+namespace vanet {
+
+/**
+ * \brief Read-only memory mapping of a waypoint trace written by
+ * convert-mobility.py.
+ *
+ * Nothing is parsed or copied when the trace is opened, the pages of a node
+ * are only read once the simulation reaches its waypoints.
+ */
+class WaypointTrace : public SimpleRefCount<WaypointTrace>
+{
+public:
+  struct Waypoint
+  {
+    double	time;	///< s
+    double	x;	///< m
+    double	y;	///< m
+    double	z;	///< m
+  };
+
+  /**
+   * \brief Map a trace, NS_FATAL_ERROR if it is not a valid waypoint trace
+   * \param fileName the trace
+   */
+  WaypointTrace (const std::string& fileName);
+
+  ~WaypointTrace ();
+
+  /**
+   * \param fileName a mobility trace
+   * \return whether the file starts like a waypoint trace
+   */
+  static bool IsWaypointTrace (const std::string& fileName);
+
+  uint32_t GetNNodes () const;
+
+  uint64_t GetNWaypoints (uint32_t node) const;
+
+  /**
+   * \param node index of the node in the trace
+   * \return the waypoints of the node, sorted by time
+   */
+  const Waypoint * GetWaypoints (uint32_t node) const;
+
+private:
+  struct Header
+  {
+    uint32_t	magic;
+    uint32_t	version;
+    uint32_t	nNodes;
+    uint32_t	reserved;
+  };
+
+  struct NodeEntry
+  {
+    uint64_t	first;	///< index of the first waypoint of the node
+    uint64_t	count;	///< waypoints of the node
+  };
+
+  static const uint32_t Magic = 0x54505756; ///< "VWPT"
+  static const uint32_t Version = 1;
+
+  void *m_map; ///< mapping of the whole file
+  size_t m_size; ///< bytes mapped
+  const Header *m_header; ///< start of the mapping
+  const NodeEntry *m_nodes; ///< node table, after the header
+  const Waypoint *m_waypoints; ///< waypoints, after the node table
+};
+
+/**
+ * \brief Drop-in replacement of Ns2MobilityHelper for waypoint traces.
+ *
+ * Every node gets a ConstantVelocityMobilityModel, as with
+ * Ns2MobilityHelper, and at most one pending event: the one of its next
+ * waypoint, which schedules the one after. Installing costs O(nodes)
+ * whatever the length of the trace.
+ */
+class BinaryMobilityHelper
+{
+public:
+  /**
+   * \param fileName waypoint trace, see convert-mobility.py
+   */
+  BinaryMobilityHelper (const std::string& fileName);
+
+  /**
+   * \brief Drive the nodes of a range, the n-th one by the n-th node of the trace
+   * \param first first node
+   * \param last end of the range
+   * \return none
+   */
+  void Install (NodeContainer::Iterator first, NodeContainer::Iterator last) const;
+
+private:
+  /**
+   * \brief Reach a waypoint and head for the next one
+   * \param trace the trace, kept mapped by the pending events
+   * \param model mobility model of the node
+   * \param node index of the node in the trace
+   * \param index index of the waypoint reached
+   * \return none
+   */
+  static void Advance (Ptr<const WaypointTrace> trace, Ptr<ConstantVelocityMobilityModel> model, uint32_t node, uint64_t index);
+
+  Ptr<WaypointTrace> m_trace; ///< the mapped trace
+};
+
+} // namespace vanet
+} // namespace ns3
+
+#endif /* SCRATCH_VANET_CS_VFC_BINARY_MOBILITY_HELPER_H_ */
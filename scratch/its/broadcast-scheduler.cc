@@ -0,0 +1,64 @@
+#include "vanet-cs-vfc.h"
+#include "broadcast-scheduler.h"
+#include "cs-vfc-scheduler.h"
+#include "ncb-scheduler.h"
+#include "ma-scheduler.h"
+
+namespace ns3 {
+namespace vanet {
+
+BroadcastScheduler *
+BroadcastScheduler::Create (const std::string& schemeName, VanetCsVfcExperiment *experiment)
+{
+  if (schemeName.compare(Scheme_1) == 0)
+    {
+      return new CsVfcScheduler (experiment);
+    }
+  else if (schemeName.compare(Scheme_2) == 0)
+    {
+      return new NcbScheduler (experiment);
+    }
+  else if (schemeName.compare(Scheme_3) == 0)
+    {
+      return new MaScheduler (experiment);
+    }
+  NS_FATAL_ERROR ("Unknown scheme name: " << schemeName);
+  return 0;
+}
+
+BroadcastScheduler::BroadcastScheduler (VanetCsVfcExperiment *experiment)
+  : m_experiment (experiment)
+{
+}
+
+BroadcastScheduler::~BroadcastScheduler ()
+{
+}
+
+void
+BroadcastScheduler::OnSubmit (uint32_t obuIdx, uint32_t reqIdx)
+{
+}
+
+void
+BroadcastScheduler::FillTickRecord (TickRecord& record) const
+{
+}
+
+void
+BroadcastScheduler::Save (CheckpointWriter& writer) const
+{
+}
+
+void
+BroadcastScheduler::Load (CheckpointReader& reader)
+{
+}
+
+void
+BroadcastScheduler::RebuildFromCaches (void)
+{
+}
+
+} // namespace vanet
+} // namespace ns3
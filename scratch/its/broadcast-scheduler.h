@@ -0,0 +1,102 @@
+#ifndef SCRATCH_VANET_CS_VFC_BROADCAST_SCHEDULER_H_
+#define SCRATCH_VANET_CS_VFC_BROADCAST_SCHEDULER_H_
+
+#include <cstdint>
+#include <string>
+
+#include "ns3/ptr.h"
+#include "ns3/packet.h"
+#include "ns3/address.h"
+
+class VanetCsVfcExperiment;
+struct TickRecord;
+
+namespace ns3 {
+namespace vanet {
+
+class CheckpointWriter;
+class CheckpointReader;
+
+/**
+ * \brief Scheduling scheme driven by the experiment (cs-vfc, ncb or ma).
+ *
+ * The experiment keeps the state shared by every scheme (vehicle requests
+ * and caches, fog clusters, statistics) and calls into exactly one scheduler,
+ * chosen once from the scheme name. Everything that only one scheme needs
+ * lives in its scheduler, so the other schemes never allocate it.
+ */
+class BroadcastScheduler
+{
+public:
+  /**
+   * \brief Create the scheduler of a scheme
+   * \param schemeName scheme name, "cs-vfc", "ncb" or "ma"
+   * \param experiment the experiment the scheduler works on
+   * \return a new scheduler, owned by the caller
+   */
+  static BroadcastScheduler * Create (const std::string& schemeName, VanetCsVfcExperiment *experiment);
+
+  virtual ~BroadcastScheduler ();
+
+  /**
+   * \brief Called every scheduling period, after the fog data is updated
+   * \return none
+   */
+  virtual void OnTick (void) = 0;
+
+  /**
+   * \brief Called for every packet received by the packet sink of a node
+   * \param nodeId id of the receiving node
+   * \param packet the received packet
+   * \param srcAddr source address
+   * \param destAddr destination address
+   * \return none
+   */
+  virtual void OnReceive (uint32_t nodeId, Ptr<const Packet> packet, const Address & srcAddr, const Address & destAddr) = 0;
+
+  /**
+   * \brief Called once for every request a vehicle submits
+   * \param obuIdx index of the vehicle
+   * \param reqIdx index of the requested data
+   * \return none
+   */
+  virtual void OnSubmit (uint32_t obuIdx, uint32_t reqIdx);
+
+  /**
+   * \brief Fill the scheme specific fields of the record of the last tick
+   * \param record the record, its common fields already set
+   * \return none
+   */
+  virtual void FillTickRecord (TickRecord& record) const;
+
+  /**
+   * \brief Write the state the scheme carries from one tick to the next
+   * \param writer the checkpoint, positioned after the shared state
+   * \return none
+   */
+  virtual void Save (CheckpointWriter& writer) const;
+
+  /**
+   * \brief Read back the state written by Save, called on a fresh scheduler
+   * \param reader the checkpoint, positioned after the shared state
+   * \return none
+   */
+  virtual void Load (CheckpointReader& reader);
+
+  /**
+   * \brief Called on a fresh scheduler when a checkpoint of another scheme
+   * is restored, after the caches of the vehicles are read back
+   * \return none
+   */
+  virtual void RebuildFromCaches (void);
+
+protected:
+  BroadcastScheduler (VanetCsVfcExperiment *experiment);
+
+  VanetCsVfcExperiment *m_experiment; ///< the experiment holding the shared state
+};
+
+} // namespace vanet
+} // namespace ns3
+
+#endif /* SCRATCH_VANET_CS_VFC_BROADCAST_SCHEDULER_H_ */
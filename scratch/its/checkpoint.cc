@@ -0,0 +1,237 @@
+#include "checkpoint.h"
+
+#include "ns3/fatal-error.h"
+
+namespace ns3 {
+namespace vanet {
+
+CheckpointWriter::CheckpointWriter (const std::string& fileName)
+  : m_fileName (fileName),
+    m_tmpFileName (fileName + ".tmp"),
+    m_file (std::fopen (m_tmpFileName.c_str (), "wb"))
+{
+  if (m_file == 0)
+    {
+      NS_FATAL_ERROR ("Could not create checkpoint " << m_tmpFileName);
+    }
+}
+
+CheckpointWriter::~CheckpointWriter ()
+{
+  if (m_file != 0)
+    {
+      // never committed, drop the partial file
+      std::fclose (m_file);
+      std::remove (m_tmpFileName.c_str ());
+    }
+}
+
+void
+CheckpointWriter::WriteBytes (const void *data, size_t size)
+{
+  if (size != 0 && std::fwrite (data, 1, size, m_file) != size)
+    {
+      NS_FATAL_ERROR ("Could not write checkpoint " << m_tmpFileName);
+    }
+}
+
+void
+CheckpointWriter::Write (bool v)
+{
+  Write (static_cast<uint8_t> (v ? 1 : 0));
+}
+
+void
+CheckpointWriter::Write (uint8_t v)
+{
+  WriteBytes (&v, sizeof (v));
+}
+
+void
+CheckpointWriter::Write (uint32_t v)
+{
+  WriteBytes (&v, sizeof (v));
+}
+
+void
+CheckpointWriter::Write (uint64_t v)
+{
+  WriteBytes (&v, sizeof (v));
+}
+
+void
+CheckpointWriter::Write (int64_t v)
+{
+  WriteBytes (&v, sizeof (v));
+}
+
+void
+CheckpointWriter::Write (double v)
+{
+  WriteBytes (&v, sizeof (v));
+}
+
+void
+CheckpointWriter::Write (const std::string& v)
+{
+  Write (static_cast<uint64_t> (v.size ()));
+  WriteBytes (v.data (), v.size ());
+}
+
+void
+CheckpointWriter::Write (const Vector3D& v)
+{
+  Write (v.x);
+  Write (v.y);
+  Write (v.z);
+}
+
+void
+CheckpointWriter::Write (const RequestStatus& v)
+{
+  Write (v.completed);
+  Write (v.submitTime);
+  Write (v.satisfiedTime);
+}
+
+void
+CheckpointWriter::Write (const ReqQueueItem& v)
+{
+  // the name is derived from the indices
+  Write (v.vehIndex);
+  Write (v.reqDataIndex);
+}
+
+void
+CheckpointWriter::Commit ()
+{
+  bool ok = std::fflush (m_file) == 0;
+  ok = (std::fclose (m_file) == 0) && ok;
+  m_file = 0;
+  if (!ok || std::rename (m_tmpFileName.c_str (), m_fileName.c_str ()) != 0)
+    {
+      std::remove (m_tmpFileName.c_str ());
+      NS_FATAL_ERROR ("Could not write checkpoint " << m_fileName);
+    }
+}
+
+CheckpointReader::CheckpointReader (const std::string& fileName)
+  : m_fileName (fileName),
+    m_file (std::fopen (fileName.c_str (), "rb"))
+{
+  if (m_file == 0)
+    {
+      NS_FATAL_ERROR ("Could not open checkpoint " << m_fileName);
+    }
+}
+
+CheckpointReader::~CheckpointReader ()
+{
+  std::fclose (m_file);
+}
+
+void
+CheckpointReader::ReadBytes (void *data, size_t size)
+{
+  if (size != 0 && std::fread (data, 1, size, m_file) != size)
+    {
+      NS_FATAL_ERROR ("Checkpoint " << m_fileName << " is truncated");
+    }
+}
+
+const std::string&
+CheckpointReader::GetFileName () const
+{
+  return m_fileName;
+}
+
+void
+CheckpointReader::Read (bool& v)
+{
+  uint8_t byte;
+  Read (byte);
+  v = byte != 0;
+}
+
+void
+CheckpointReader::Read (uint8_t& v)
+{
+  ReadBytes (&v, sizeof (v));
+}
+
+void
+CheckpointReader::Read (uint32_t& v)
+{
+  ReadBytes (&v, sizeof (v));
+}
+
+void
+CheckpointReader::Read (uint64_t& v)
+{
+  ReadBytes (&v, sizeof (v));
+}
+
+void
+CheckpointReader::Read (int64_t& v)
+{
+  ReadBytes (&v, sizeof (v));
+}
+
+void
+CheckpointReader::Read (double& v)
+{
+  ReadBytes (&v, sizeof (v));
+}
+
+void
+CheckpointReader::Read (std::string& v)
+{
+  uint64_t size;
+  Read (size);
+  v.resize (size);
+  if (size != 0)
+    {
+      ReadBytes (&v[0], size);
+    }
+}
+
+void
+CheckpointReader::Read (Vector3D& v)
+{
+  Read (v.x);
+  Read (v.y);
+  Read (v.z);
+}
+
+void
+CheckpointReader::Read (RequestStatus& v)
+{
+  Read (v.completed);
+  Read (v.submitTime);
+  Read (v.satisfiedTime);
+}
+
+void
+CheckpointReader::Read (ReqQueueItem& v)
+{
+  Read (v.vehIndex);
+  Read (v.reqDataIndex);
+  v.genName ();
+}
+
+void
+CheckpointReader::Read (std::vector<bool>& v)
+{
+  uint64_t size;
+  Read (size);
+  v.resize (size);
+  for (uint64_t i = 0; i < size; i++)
+    {
+      bool e;
+      Read (e);
+      v[i] = e;
+    }
+}
+
+} // namespace vanet
+} // namespace ns3
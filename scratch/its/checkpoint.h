@@ -0,0 +1,239 @@
+#ifndef SCRATCH_VANET_CS_VFC_CHECKPOINT_H_
+#define SCRATCH_VANET_CS_VFC_CHECKPOINT_H_
+
+#include <cstdint>
+#include <cstdio>
+#include <list>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "ns3/vector.h"
+#include "custom-type.h"
+#include "stats.h"
+
+namespace ns3 {
+namespace vanet {
+
+/**
+ * \brief Binary writer of a simulation checkpoint.
+ *
+ * Values are written in host byte order, a checkpoint is only meant to be
+ * restored on the machine that wrote it. The file is written aside and
+ * renamed by Commit, so an interrupted run never leaves a partial checkpoint
+ * under the final name.
+ */
+class CheckpointWriter
+{
+public:
+  /**
+   * \brief Start a checkpoint, NS_FATAL_ERROR if it cannot be created
+   * \param fileName final name of the checkpoint
+   */
+  CheckpointWriter (const std::string& fileName);
+
+  ~CheckpointWriter ();
+
+  void Write (bool v);
+  void Write (uint8_t v);
+  void Write (uint32_t v);
+  void Write (uint64_t v);
+  void Write (int64_t v);
+  void Write (double v);
+  void Write (const std::string& v);
+  void Write (const Vector3D& v);
+  void Write (const RequestStatus& v);
+  void Write (const ReqQueueItem& v);
+
+  template <typename T>
+  void Write (const std::vector<T>& v);
+  template <typename T>
+  void Write (const std::list<T>& v);
+  template <typename T>
+  void Write (const std::set<T>& v);
+  template <typename K, typename V>
+  void Write (const std::map<K, V>& v);
+
+  /**
+   * \brief Write raw bytes
+   * \param data the bytes
+   * \param size number of bytes
+   * \return none
+   */
+  void WriteBytes (const void *data, size_t size);
+
+  /**
+   * \brief Close the checkpoint and move it to its final name,
+   * NS_FATAL_ERROR on failure
+   * \return none
+   */
+  void Commit ();
+
+private:
+  std::string m_fileName; ///< final name
+  std::string m_tmpFileName; ///< name while being written
+  std::FILE *m_file; ///< file being written, 0 once committed
+};
+
+/**
+ * \brief Reader of a checkpoint written by CheckpointWriter.
+ *
+ * Every Read mirrors the Write of the same type; reading past the end of the
+ * file is a fatal error.
+ */
+class CheckpointReader
+{
+public:
+  /**
+   * \brief Open a checkpoint, NS_FATAL_ERROR if it cannot be opened
+   * \param fileName name of the checkpoint
+   */
+  CheckpointReader (const std::string& fileName);
+
+  ~CheckpointReader ();
+
+  void Read (bool& v);
+  void Read (uint8_t& v);
+  void Read (uint32_t& v);
+  void Read (uint64_t& v);
+  void Read (int64_t& v);
+  void Read (double& v);
+  void Read (std::string& v);
+  void Read (Vector3D& v);
+  void Read (RequestStatus& v);
+  void Read (ReqQueueItem& v);
+
+  template <typename T>
+  void Read (std::vector<T>& v);
+  void Read (std::vector<bool>& v);
+  template <typename T>
+  void Read (std::list<T>& v);
+  template <typename T>
+  void Read (std::set<T>& v);
+  template <typename K, typename V>
+  void Read (std::map<K, V>& v);
+
+  /**
+   * \brief Read raw bytes
+   * \param data buffer receiving the bytes
+   * \param size number of bytes
+   * \return none
+   */
+  void ReadBytes (void *data, size_t size);
+
+  const std::string& GetFileName () const;
+
+private:
+  std::string m_fileName; ///< name of the checkpoint
+  std::FILE *m_file; ///< file being read
+};
+
+template <typename T>
+void
+CheckpointWriter::Write (const std::vector<T>& v)
+{
+  Write (static_cast<uint64_t> (v.size ()));
+  for (const T& e : v)
+    {
+      Write (e);
+    }
+}
+
+template <typename T>
+void
+CheckpointWriter::Write (const std::list<T>& v)
+{
+  Write (static_cast<uint64_t> (v.size ()));
+  for (const T& e : v)
+    {
+      Write (e);
+    }
+}
+
+template <typename T>
+void
+CheckpointWriter::Write (const std::set<T>& v)
+{
+  Write (static_cast<uint64_t> (v.size ()));
+  for (const T& e : v)
+    {
+      Write (e);
+    }
+}
+
+template <typename K, typename V>
+void
+CheckpointWriter::Write (const std::map<K, V>& v)
+{
+  Write (static_cast<uint64_t> (v.size ()));
+  for (const std::pair<const K, V>& e : v)
+    {
+      Write (e.first);
+      Write (e.second);
+    }
+}
+
+template <typename T>
+void
+CheckpointReader::Read (std::vector<T>& v)
+{
+  uint64_t size;
+  Read (size);
+  v.resize (size);
+  for (T& e : v)
+    {
+      Read (e);
+    }
+}
+
+template <typename T>
+void
+CheckpointReader::Read (std::list<T>& v)
+{
+  uint64_t size;
+  Read (size);
+  v.clear ();
+  for (uint64_t i = 0; i < size; i++)
+    {
+      T e;
+      Read (e);
+      v.push_back (e);
+    }
+}
+
+template <typename T>
+void
+CheckpointReader::Read (std::set<T>& v)
+{
+  uint64_t size;
+  Read (size);
+  v.clear ();
+  for (uint64_t i = 0; i < size; i++)
+    {
+      T e;
+      Read (e);
+      // written in order, so every element goes to the end
+      v.insert (v.end (), e);
+    }
+}
+
+template <typename K, typename V>
+void
+CheckpointReader::Read (std::map<K, V>& v)
+{
+  uint64_t size;
+  Read (size);
+  v.clear ();
+  for (uint64_t i = 0; i < size; i++)
+    {
+      K key;
+      Read (key);
+      Read (v[key]);
+    }
+}
+
+} // namespace vanet
+} // namespace ns3
+
+#endif /* SCRATCH_VANET_CS_VFC_CHECKPOINT_H_ */
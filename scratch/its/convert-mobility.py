@@ -0,0 +1,192 @@
+#!/usr/bin/env python3
+#
+# Convert an ns-2 TCL movement trace or a SUMO FCD export into the binary
+# waypoint format read by vanet::BinaryMobilityHelper.
+#
+# Layout, little endian:
+#
+#   header     uint32 magic "VWPT", uint32 version (1), uint32 nodes, uint32 0
+#   node table nodes x { uint64 first waypoint, uint64 waypoints }
+#   waypoints  { double time, double x, double y, double z }, grouped by node
+#              and sorted by time within a node
+#
+# A node stands at its first waypoint from t=0 and moves in a straight line
+# from every waypoint to the next one; two waypoints with the same time are a
+# jump. The n-th node of the trace drives the n-th node passed to Install,
+# the same as with Ns2MobilityHelper. SUMO vehicles are numbered in the order
+# they first appear.
+#
+# Example:
+#
+#   python3 scratch/its/convert-mobility.py mobility/mobility.tcl mobility/mobility.wpt
+#   python3 scratch/its/convert-mobility.py --format fcd fcd.xml mobility/mobility.wpt
+#   ./waf --run "its --traceFile=mobility/mobility.wpt"
+#
+
+import argparse
+import math
+import os
+import re
+import struct
+import sys
+import xml.etree.ElementTree as ElementTree
+from array import array
+
+MAGIC = 0x54505756  # "VWPT"
+VERSION = 1
+
+INITIAL_RE = re.compile(r'^\s*\$node_\((\d+)\)\s+set\s+([XYZ])_\s+(\S+)')
+SETDEST_RE = re.compile(r'^\s*\$ns_\s+at\s+(\S+)\s+"\s*\$node_\((\d+)\)\s+setdest\s+(\S+)\s+(\S+)\s+(\S+)\s*"')
+SETPOS_RE = re.compile(r'^\s*\$ns_\s+at\s+(\S+)\s+"\s*\$node_\((\d+)\)\s+set\s+([XYZ])_\s+(\S+)\s*"')
+
+AXIS = {"X": 0, "Y": 1, "Z": 2}
+
+
+def parse_args():
+    parser = argparse.ArgumentParser(description="convert a mobility trace to binary waypoints")
+    parser.add_argument("input", help="ns-2 TCL trace or SUMO FCD XML")
+    parser.add_argument("output", help="binary waypoint file to write")
+    parser.add_argument("--format", choices=["auto", "ns2", "fcd"], default="auto",
+                        help="input format, guessed from the file name by default")
+    return parser.parse_args()
+
+
+class Ns2Node:
+    """ns-2 setdest semantics: move towards a destination at a speed, stop there."""
+
+    def __init__(self):
+        self.initial = [0.0, 0.0, 0.0]
+        self.events = []  # (time, order, kind, args)
+
+    def waypoints(self):
+        wps = []  # [time, x, y, z]
+        pos = list(self.initial)
+        start = 0.0
+        velocity = None  # None when standing
+        arrival = 0.0
+        dest = None
+        wps.append([0.0] + pos)
+
+        def position_at(t):
+            if velocity is None:
+                return list(pos)
+            if t >= arrival:
+                return list(dest)
+            return [pos[i] + velocity[i] * (t - start) for i in range(3)]
+
+        def add(t, p):
+            if wps[-1][0] == t and wps[-1][1:] == p:
+                return
+            wps.append([t] + p)
+
+        for t, _, kind, args in sorted(self.events):
+            current = position_at(t)
+            # a new command cuts the leg still in progress
+            if velocity is not None and arrival > t:
+                wps.pop()
+            add(t, current)
+            velocity = None
+            pos = current
+            if kind == "setdest":
+                target = [args[0], args[1], current[2]]
+                dist = math.sqrt(sum((target[i] - current[i]) ** 2 for i in range(3)))
+                if args[2] > 0 and dist > 0:
+                    start = t
+                    arrival = t + dist / args[2]
+                    dest = target
+                    velocity = [(target[i] - current[i]) / (arrival - t) for i in range(3)]
+                    wps.append([arrival] + target)
+            else:
+                pos = list(current)
+                pos[args[0]] = args[1]
+                add(t, list(pos))
+        return wps
+
+
+def read_ns2(path):
+    nodes = {}
+    order = 0
+    with open(path) as f:
+        for line in f:
+            m = SETDEST_RE.match(line)
+            if m:
+                node = nodes.setdefault(int(m.group(2)), Ns2Node())
+                node.events.append((float(m.group(1)), order, "setdest",
+                                    (float(m.group(3)), float(m.group(4)), float(m.group(5)))))
+                order += 1
+                continue
+            m = SETPOS_RE.match(line)
+            if m:
+                node = nodes.setdefault(int(m.group(2)), Ns2Node())
+                node.events.append((float(m.group(1)), order, "set",
+                                    (AXIS[m.group(3)], float(m.group(4)))))
+                order += 1
+                continue
+            m = INITIAL_RE.match(line)
+            if m:
+                node = nodes.setdefault(int(m.group(1)), Ns2Node())
+                node.initial[AXIS[m.group(2)]] = float(m.group(3))
+    count = max(nodes) + 1 if nodes else 0
+    result = []
+    for i in range(count):
+        data = array("d")
+        if i in nodes:
+            for wp in nodes[i].waypoints():
+                data.extend(wp)
+        result.append(data)
+    return result
+
+
+def read_fcd(path):
+    ids = {}
+    result = []
+    time = 0.0
+    # streamed, an FCD export of a city does not fit in memory as a tree
+    for event, elem in ElementTree.iterparse(path, events=("start", "end")):
+        if event == "start":
+            if elem.tag == "timestep":
+                time = float(elem.get("time"))
+            continue
+        if elem.tag == "vehicle":
+            vid = elem.get("id")
+            if vid not in ids:
+                ids[vid] = len(result)
+                result.append(array("d"))
+            result[ids[vid]].extend((time, float(elem.get("x")), float(elem.get("y")),
+                                     float(elem.get("z", 0.0))))
+            elem.clear()
+        elif elem.tag == "timestep":
+            elem.clear()
+    return result
+
+
+def write_waypoints(path, nodes):
+    tmp = path + ".tmp"
+    with open(tmp, "wb") as f:
+        f.write(struct.pack("<IIII", MAGIC, VERSION, len(nodes), 0))
+        first = 0
+        for data in nodes:
+            count = len(data) // 4
+            f.write(struct.pack("<QQ", first, count))
+            first += count
+        for data in nodes:
+            if sys.byteorder != "little":
+                data.byteswap()
+            f.write(data.tobytes())
+    os.replace(tmp, path)
+    return first
+
+
+def main():
+    args = parse_args()
+    fmt = args.format
+    if fmt == "auto":
+        fmt = "fcd" if args.input.endswith(".xml") else "ns2"
+    nodes = read_ns2(args.input) if fmt == "ns2" else read_fcd(args.input)
+    waypoints = write_waypoints(args.output, nodes)
+    print("%s: %d nodes, %d waypoints" % (args.output, len(nodes), waypoints))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
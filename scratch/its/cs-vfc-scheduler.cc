@@ -0,0 +1,1186 @@
+#include "vanet-cs-vfc.h"
+#include "cs-vfc-scheduler.h"
+
+namespace ns3 {
+namespace vanet {
+
+CsVfcScheduler::CsVfcScheduler (VanetCsVfcExperiment *experiment)
+  : BroadcastScheduler (experiment),
+    m_graphSize (0),
+    m_cliqueSize (0)
+{
+  datasNeededForDecodingPerClique.resize(m_experiment->m_nObuNodes);
+}
+
+void
+CsVfcScheduler::OnTick ()
+{
+  clock_t startTime = 0;
+  if (LogIsEnabled (LOG_CLIQUE_TIME))
+    {
+      startTime = clock();
+    }
+
+  m_graphSize = 0;
+  m_cliqueSize = 0;
+
+  // update fog request set cache set
+  vector<VertexNode> vertices;
+  for (uint32_t i = 0; i < m_experiment->m_nRsuNodes; i++)
+    {
+      for (uint32_t req : m_experiment->fogsReqs[i])
+	{
+	  VertexNode vn(i, req);
+	  vertices.push_back(vn);
+	}
+    }
+
+  if (vertices.empty()) return;
+
+  m_graphSize = vertices.size();
+  graph = GraphMatrix<VertexNode> (vertices, vertices.size());
+
+  // add edge using condition 1, 2, 3
+  VertexNode vn1;
+  VertexNode vn2;
+  EdgeNode<> en = {.type = EdgeType::NOT_SET, .weight = 1};
+  for (uint32_t i = 0; i < m_experiment->m_nRsuNodes; i++)
+    {
+      vn1.fogIndex = i;
+      for (uint32_t req1 : m_experiment->fogsReqs[i])
+	{
+	  vn1.reqDataIndex = req1;
+	  vn1.genName();
+	  for (uint32_t j = i + 1; j < m_experiment->m_nRsuNodes; j++)
+	    {
+	      vn2.fogIndex = j;
+	      if (m_experiment->fogsReqs[j].count(req1)) // condition 1
+		{
+		  vn2.reqDataIndex = req1;
+		  vn2.genName();
+		  en.type = EdgeType::CONDITION_1;
+		  graph.addEdge(vn1, vn2, en);
+		}
+	      for (uint32_t req2 : m_experiment->fogsReqs[j])
+		{
+		  vn2.reqDataIndex = req2;
+		  vn2.genName();
+		  if ((m_experiment->fogsCaches[j].count(req1) && m_experiment->fogsCaches[i].count(req2))) // condition 2
+		    {
+		      en.type = EdgeType::CONDITION_2;
+		      graph.addEdge(vn1, vn2, en);
+		    }
+		  else if ((m_experiment->fogsReqs[j].count(req1) && m_experiment->fogsCaches[i].count(req2))
+		      || (m_experiment->fogsCaches[j].count(req1) && m_experiment->fogsReqs[i].count(req2))) // condition 3
+		    {
+		      en.type = EdgeType::CONDITION_3;
+		      graph.addEdge(vn1, vn2, en);
+		    }
+		}
+	    }
+	}
+    }
+  if (LogIsEnabled (LOG_EDGE))
+    {
+      graph.printEdge();
+    }
+
+#if Search_Clique
+//  std::vector<std::vector<VertexNode>> cliques = graphM.getCliquesWithBA(Num_Cliques);
+  cliques.clear();
+  cliques = graph.getCliques(Num_Cliques);
+  for (const std::vector<VertexNode>& clique : cliques)
+    {
+      m_cliqueSize = std::max<uint32_t> (m_cliqueSize, clique.size());
+    }
+  if (LogIsEnabled (LOG_CLIQUES))
+    {
+      std::cout << "sim time:" << Simulator::Now().GetSeconds() << ", ";
+      graph.printCliques(cliques);
+      std::cout << "DbSize:" << m_experiment->globalDbSize << std::endl;
+    }
+#endif
+
+  if (LogIsEnabled (LOG_CLIQUE_TIME))
+    {
+      clock_t endTime = clock();
+      cout << "sim time: " << Now().GetSeconds() << ", clock: " << (double)(endTime - startTime) / CLOCKS_PER_SEC << endl;
+    }
+
+  // broadcast clique to vehicles
+  broadcastId2cliqueMap.clear();
+  isDecoding.clear();
+  for (std::vector<VertexNode> clique : cliques)
+    {
+      m_experiment->currentBroadcastId++;
+      broadcastId2cliqueMap[m_experiment->currentBroadcastId] = clique;
+      isDecoding[m_experiment->currentBroadcastId] = false;
+    }
+
+  for (uint32_t i = 0; i < m_experiment->m_nObuNodes; i++)
+    {
+      datasNeededForDecodingPerClique[i].clear();
+    }
+
+  fogIdx2FogReqInCliqueMaps.clear();
+  std::map<uint32_t, std::vector<VertexNode>>::iterator iter = broadcastId2cliqueMap.begin();
+  for (; iter != broadcastId2cliqueMap.end(); iter++)
+    {
+      std::vector<VertexNode> clique = iter->second;
+
+      m_experiment->m_requestStats.IncBroadcastPkts();
+
+      std::map<uint32_t, uint32_t> fogIdx2FogReqInCliqueMap;
+      std::set<uint32_t> broadcastData;
+      for (VertexNode vertex : clique)
+	{
+	  broadcastData.insert(vertex.reqDataIndex);
+	  fogIdx2FogReqInCliqueMap.insert(make_pair(vertex.fogIndex, vertex.reqDataIndex));
+
+	  for (uint32_t obuIdx : m_experiment->fogCluster[vertex.fogIndex])
+	    {
+	      std::set<uint32_t> datasNeeded;
+	      datasNeeded.insert(broadcastData.begin(), broadcastData.end());
+	      if (m_experiment->vehsReqs[obuIdx].count(vertex.reqDataIndex))
+		{
+		  datasNeeded.erase(vertex.reqDataIndex);
+		}
+	      for (uint32_t cache : m_experiment->vehsCaches[obuIdx])
+		{
+		  datasNeeded.erase(cache);
+		}
+	      datasNeededForDecodingPerClique[obuIdx].insert(make_pair(iter->first, datasNeeded));
+	    }
+	}
+      fogIdx2FogReqInCliqueMaps.insert(make_pair(iter->first, fogIdx2FogReqInCliqueMap));
+
+      if (broadcastData.size() == 0) continue;
+
+#if Lte_Enable
+
+//      using vanet::PacketHeader;
+//      PacketHeader header;
+//      header.SetType(PacketHeader::MessageType::DATA_C2V);
+//      header.SetBroadcastId(iter->first);
+//
+//      Ptr<UdpSender> sender = CreateObject<UdpSender>();
+//      sender->SetNode(m_remoteHost);
+//      sender->SetDataSize(Packet_Size);
+//      sender->SetHeader(header);
+//      for (uint32_t i = 0; i < m_nObuNodes; i++)
+//	{
+//	  using vanet::PacketTagData;
+//	  PacketTagData *pktTag = new PacketTagData();
+//	  for (uint32_t data : broadcastData)
+//	    {
+//	      pktTag->AddDataIdx(data);
+//	    }
+//
+//	  sender->SetRemote(m_ueInterface.GetAddress(i), m_dlPort);
+//	  sender->SetPacketTag(pktTag);
+//	  sender->Start();
+//
+//	  Simulator::ScheduleNow (&UdpSender::Send, sender);
+//	}
+
+      for (uint32_t i = 0; i < m_experiment->m_nObuNodes; i++)
+	{
+	  Ptr<UdpSender> sender = CreateObject<UdpSender>();
+	  sender->SetNode(m_experiment->m_remoteHost);
+	  sender->SetRemote(m_experiment->m_ueInterface.GetAddress(i) , m_experiment->m_dlPort);
+	  sender->SetDataSize(Packet_Size);
+	  sender->Start();
+	  using vanet::PacketHeader;
+	  PacketHeader header;
+	  header.SetType(PacketHeader::MessageType::DATA_C2V);
+	  header.SetBroadcastId(iter->first);
+	  sender->SetHeader(header);
+
+	  using vanet::PacketTagData;
+	  PacketTagData *pktTag = new PacketTagData();
+	  for (uint32_t data : broadcastData)
+	    {
+	      pktTag->AddDataIdx(data);
+	    }
+	  sender->SetPacketTag(pktTag);
+
+	  Simulator::ScheduleNow (&UdpSender::Send, sender);
+	}
+#else
+      Ptr<UdpSender> sender = CreateObject<UdpSender>();
+      sender->SetNode(m_experiment->m_remoteHost);
+      sender->SetRemote(Ipv4Address ("10.2.255.255"), m_experiment->m_dlPort);
+      sender->SetDataSize(Packet_Size);
+      sender->Start();
+      using vanet::PacketHeader;
+      PacketHeader header;
+      header.SetType(PacketHeader::MessageType::DATA_C2V);
+      header.SetBroadcastId(iter->first);
+      sender->SetHeader(header);
+
+      using vanet::PacketTagData;
+      PacketTagData *pktTag = new PacketTagData();
+      for (uint32_t data : broadcastData)
+	{
+	  pktTag->AddDataIdx(data);
+	}
+      sender->SetPacketTag(pktTag);
+
+      Simulator::ScheduleNow (&UdpSender::Send, sender);
+#endif
+    }
+}
+
+void
+CsVfcScheduler::Decode (bool isEncoded, uint32_t broadcastId)
+{
+  if (!isEncoded)
+    {
+      if (broadcastId2cliqueMap.count(broadcastId) == 0) return;
+      for (VertexNode vertex : broadcastId2cliqueMap.at(broadcastId))
+	{
+	  for (uint32_t obuIdx : m_experiment->fogCluster[vertex.fogIndex])
+	    {
+	      if (m_experiment->vehsReqs[obuIdx].count(vertex.reqDataIndex))
+		{
+		  m_experiment->vehsReqs[obuIdx].erase(vertex.reqDataIndex);
+		  m_experiment->vehsCaches[obuIdx].insert(vertex.reqDataIndex);
+
+		  m_experiment->RecordStats(obuIdx, vertex.reqDataIndex);
+
+//		  map<uint32_t, std::set<uint32_t>>::iterator iter = datasNeededForDecodingPerClique[obuIdx].begin();
+//		  for (; iter != datasNeededForDecodingPerClique[obuIdx].end(); iter++)
+//		    {
+//		      iter->second.erase(vertex.reqDataIndex);
+//		      if (iter->second.size() == 0)
+//			{
+//			  if (fogIdx2FogReqInCliqueMaps.count(iter->first)
+//			      && fogIdx2FogReqInCliqueMaps.at(iter->first).count(vertex.fogIndex))
+//			    {
+//			      uint32_t fogReqIdx = fogIdx2FogReqInCliqueMaps.at(iter->first).at(vertex.fogIndex);
+//			      if (vehsReqs[obuIdx].count(fogReqIdx) != 0)
+//				{
+//				  vehsReqs[obuIdx].erase(fogReqIdx);
+//				  vehsCaches[obuIdx].insert(fogReqIdx);
+//				  RecordStats(obuIdx, fogReqIdx);
+//				}
+//			    }
+//			}
+//		    }
+
+		  map<uint32_t, std::set<uint32_t>>::iterator iter = datasNeededForDecodingPerClique[obuIdx].find(broadcastId);
+		  if (iter != datasNeededForDecodingPerClique[obuIdx].end())
+		    {
+		      iter->second.erase(vertex.reqDataIndex);
+		      if (iter->second.size() == 0)
+			{
+			  if (fogIdx2FogReqInCliqueMaps.count(iter->first)
+			      && fogIdx2FogReqInCliqueMaps.at(iter->first).count(vertex.fogIndex))
+			    {
+			      uint32_t fogReqIdx = fogIdx2FogReqInCliqueMaps.at(iter->first).at(vertex.fogIndex);
+			      if (m_experiment->vehsReqs[obuIdx].count(fogReqIdx) != 0)
+				{
+				  m_experiment->vehsReqs[obuIdx].erase(fogReqIdx);
+				  m_experiment->vehsCaches[obuIdx].insert(fogReqIdx);
+				  m_experiment->RecordStats(obuIdx, fogReqIdx);
+				}
+			    }
+			}
+		    }
+		}
+	    }
+
+//	  for (uint32_t i = 0; i < m_nObuNodes; i++)
+//	    {
+//	      if (vehsReqs[i].count(data))
+//		{
+//		  vehsReqs[i].erase(data);
+//		  vehsCaches[i].insert(data);
+//
+//		  RecordStats(obuIdx, vertex.reqDataIndex);
+//		}
+//	    }
+	}
+    }
+#if 1
+  else
+    {
+      std::set<uint32_t> fogIdxsInCliques; // fog nodes index covered by a clique
+      if (broadcastId2cliqueMap.count(broadcastId) == 0) return;
+      std::vector<VertexNode> clique = broadcastId2cliqueMap.at(broadcastId);
+      for (VertexNode vertex : clique)
+	{
+	  fogIdxsInCliques.insert(vertex.fogIndex);
+	}
+      uint32_t size = clique.size();
+#if 0
+      for (uint32_t i = 0; i < size; i++)
+	{
+	  VertexNode vertex = clique[i];
+	  for (uint32_t obuIdx : m_experiment->fogCluster[vertex.fogIndex])
+	    {
+	      if (m_experiment->vehsReqs[obuIdx].count(vertex.reqDataIndex))
+		{
+		  map<uint32_t, std::set<uint32_t>>::iterator it = datasNeededForDecodingPerClique[obuIdx].find(broadcastId);
+		  NS_ASSERT (it != datasNeededForDecodingPerClique[obuIdx].end());
+//		  it->second.erase(vertex.reqDataIndex);
+
+		  for (uint32_t data : it->second)
+		    {
+		      if (m_experiment->vehsCaches[obuIdx].count(data))
+			{
+			  it->second.erase(data);
+			}
+		      else if (m_experiment->fogsCaches[vertex.fogIndex].count(data))
+			{
+			  for (uint32_t obuIdx1 : m_experiment->fogCluster[vertex.fogIndex])
+			    {
+			      if (obuIdx == obuIdx1) continue;
+			      if (m_experiment->vehsCaches[obuIdx1].count(data))
+				{
+				  Ptr<UdpSender> sender = CreateObject<UdpSender>();
+				  sender->SetNode(m_experiment->m_obuNodes.Get(obuIdx1));
+				  sender->SetRemote(m_experiment->m_rsu80211pInterfaces.GetAddress(vertex.fogIndex), m_experiment->m_v2IPort);
+				  sender->SetDataSize(Packet_Size);
+				  sender->Start();
+				  using vanet::PacketHeader;
+				  PacketHeader header;
+				  header.SetType(PacketHeader::MessageType::DATA_V2F);
+				  header.SetBroadcastId(broadcastId);
+				  sender->SetHeader(header);
+
+				  using vanet::PacketTagData;
+				  PacketTagData *pktTagV2f = new PacketTagData();
+				  pktTagV2f->SetCurrentEdgeType(EdgeType::NOT_SET);
+				  pktTagV2f->SetNextActionType(PacketTagData::NextActionType::F2V);
+				  pktTagV2f->AddDataIdx(data);
+				  sender->SetPacketTag(pktTagV2f);
+
+				  Simulator::ScheduleNow (&UdpSender::Send, sender);
+
+				  break;
+				}
+			    }
+			}
+		    }
+		}
+	    }
+	}
+#endif
+
+      for (uint32_t i = 0; i < size; i++)
+	{
+	  VertexNode vertex1 = clique[i];
+	  for (uint32_t j = i + 1; j < size; j++)
+	    {
+	      VertexNode vertex2 = clique[j];
+	      EdgeType edgeType = graph.getEdgeType(vertex1, vertex2);
+	      switch(edgeType)
+	      {
+		case EdgeType::CONDITION_1:
+		  {
+		    bool flag = false;
+		    for (uint32_t k = 0; k < m_experiment->m_nRsuNodes; k++)
+		      {
+			if (flag) break; //avoid sending packet repeatly
+
+			if (k == vertex1.fogIndex
+			    || k == vertex2.fogIndex
+			    || 0 == fogIdxsInCliques.count(k)) continue;
+
+			if (m_experiment->fogsCaches[k].count(vertex1.reqDataIndex))
+			  {
+			    for (uint32_t obuIdx : m_experiment->fogCluster[k])
+			      {
+				if (m_experiment->vehsCaches[obuIdx].count(vertex1.reqDataIndex))
+				  {
+				    Ptr<UdpSender> sender = CreateObject<UdpSender>();
+				    sender->SetNode(m_experiment->m_obuNodes.Get(obuIdx));
+				    sender->SetRemote(m_experiment->m_rsu80211pInterfaces.GetAddress(k), m_experiment->m_v2IPort);
+				    sender->SetDataSize(Packet_Size);
+				    sender->Start();
+				    using vanet::PacketHeader;
+				    PacketHeader header;
+				    header.SetType(PacketHeader::MessageType::DATA_V2F);
+				    header.SetBroadcastId(broadcastId);
+				    sender->SetHeader(header);
+
+				    using vanet::PacketTagData;
+				    PacketTagData *pktTagV2f = new PacketTagData();
+				    pktTagV2f->SetCurrentEdgeType(EdgeType::CONDITION_1);
+				    pktTagV2f->SetNextActionType(PacketTagData::NextActionType::F2F);
+				    pktTagV2f->AddRsuWaitingServedIdx(vertex1.fogIndex);
+				    pktTagV2f->AddRsuWaitingServedIdx(vertex2.fogIndex);
+				    pktTagV2f->AddDataIdx(vertex1.reqDataIndex);
+				    sender->SetPacketTag(pktTagV2f);
+
+				    Simulator::ScheduleNow (&UdpSender::Send, sender);
+
+				    flag = true;
+				    break;
+				  }
+			      }
+			  }
+		      }
+		    break;
+		  }
+		case EdgeType::CONDITION_2:
+		  {
+		    bool flag1 = false;
+		    for (uint32_t obuIdx : m_experiment->fogCluster[vertex1.fogIndex])
+		      {
+			if (flag1) break; //avoid sending packet repeatly
+
+			if (m_experiment->vehsCaches[obuIdx].count(vertex2.reqDataIndex))
+			  {
+			    Ptr<UdpSender> sender = CreateObject<UdpSender>();
+			    sender->SetNode(m_experiment->m_obuNodes.Get(obuIdx));
+			    sender->SetRemote(m_experiment->m_rsu80211pInterfaces.GetAddress(vertex1.fogIndex), m_experiment->m_v2IPort);
+			    sender->SetDataSize(Packet_Size);
+			    sender->Start();
+			    using vanet::PacketHeader;
+			    PacketHeader header;
+			    header.SetType(PacketHeader::MessageType::DATA_V2F);
+			    header.SetBroadcastId(broadcastId);
+			    sender->SetHeader(header);
+
+			    using vanet::PacketTagData;
+			    PacketTagData *pktTagV2f = new PacketTagData();
+			    pktTagV2f->SetCurrentEdgeType(EdgeType::CONDITION_2);
+			    pktTagV2f->SetNextActionType(PacketTagData::NextActionType::F2V);
+			    pktTagV2f->AddDataIdx(vertex2.reqDataIndex);
+			    sender->SetPacketTag(pktTagV2f);
+
+			    Simulator::ScheduleNow (&UdpSender::Send, sender);
+
+			    flag1 = true;
+			    break;
+			  }
+		      }
+
+		    bool flag2 = false;
+		    for (uint32_t obuIdx : m_experiment->fogCluster[vertex2.fogIndex])
+		      {
+			if (flag2) break; //avoid sending packet repeatly
+
+			if (m_experiment->vehsCaches[obuIdx].count(vertex1.reqDataIndex))
+			  {
+			    Ptr<UdpSender> sender = CreateObject<UdpSender>();
+			    sender->SetNode(m_experiment->m_obuNodes.Get(obuIdx));
+			    sender->SetRemote(m_experiment->m_rsu80211pInterfaces.GetAddress(vertex2.fogIndex), m_experiment->m_v2IPort);
+			    sender->SetDataSize(Packet_Size);
+			    sender->Start();
+			    using vanet::PacketHeader;
+			    PacketHeader header;
+			    header.SetType(PacketHeader::MessageType::DATA_V2F);
+			    header.SetBroadcastId(broadcastId);
+			    sender->SetHeader(header);
+
+			    using vanet::PacketTagData;
+			    PacketTagData *pktTagV2f = new PacketTagData();
+			    pktTagV2f->SetCurrentEdgeType(EdgeType::CONDITION_2);
+			    pktTagV2f->SetNextActionType(PacketTagData::NextActionType::F2V);
+			    pktTagV2f->AddDataIdx(vertex1.reqDataIndex);
+			    sender->SetPacketTag(pktTagV2f);
+
+			    Simulator::ScheduleNow (&UdpSender::Send, sender);
+
+			    flag2 = true;
+			    break;
+			  }
+		      }
+		    break;
+		  }
+		case EdgeType::CONDITION_3:
+		  {
+		    bool flag1 = false;
+		    for (uint32_t obuIdx : m_experiment->fogCluster[vertex1.fogIndex])
+		      {
+			if (flag1) break; //avoid sending packet repeatly
+
+			if (m_experiment->vehsCaches[obuIdx].count(vertex2.reqDataIndex))
+			  {
+			    Ptr<UdpSender> sender = CreateObject<UdpSender>();
+			    sender->SetNode(m_experiment->m_obuNodes.Get(obuIdx));
+			    sender->SetRemote(m_experiment->m_rsu80211pInterfaces.GetAddress(vertex1.fogIndex), m_experiment->m_v2IPort);
+			    sender->SetDataSize(Packet_Size);
+			    sender->Start();
+			    using vanet::PacketHeader;
+			    PacketHeader header;
+			    header.SetType(PacketHeader::MessageType::DATA_V2F);
+			    header.SetBroadcastId(broadcastId);
+			    sender->SetHeader(header);
+
+			    using vanet::PacketTagData;
+			    PacketTagData *pktTagV2f = new PacketTagData();
+			    pktTagV2f->SetCurrentEdgeType(EdgeType::CONDITION_3);
+			    pktTagV2f->SetNextActionType(PacketTagData::NextActionType::F2V);
+			    pktTagV2f->AddRsuWaitingServedIdx(vertex2.fogIndex);
+			    pktTagV2f->AddDataIdx(vertex2.reqDataIndex);
+			    sender->SetPacketTag(pktTagV2f);
+
+			    Simulator::ScheduleNow (&UdpSender::Send, sender);
+
+			    flag1 = true;
+			    break;
+			  }
+		      }
+
+		    bool flag2 = false;
+		    for (uint32_t obuIdx : m_experiment->fogCluster[vertex2.fogIndex])
+		      {
+			if (flag2) break; //avoid sending packet repeatly
+
+			if (m_experiment->vehsCaches[obuIdx].count(vertex1.reqDataIndex))
+			  {
+			    Ptr<UdpSender> sender = CreateObject<UdpSender>();
+			    sender->SetNode(m_experiment->m_obuNodes.Get(obuIdx));
+			    sender->SetRemote(m_experiment->m_rsu80211pInterfaces.GetAddress(vertex2.fogIndex), m_experiment->m_v2IPort);
+			    sender->SetDataSize(Packet_Size);
+			    sender->Start();
+			    using vanet::PacketHeader;
+			    PacketHeader header;
+			    header.SetType(PacketHeader::MessageType::DATA_V2F);
+			    header.SetBroadcastId(broadcastId);
+			    sender->SetHeader(header);
+
+			    using vanet::PacketTagData;
+			    PacketTagData *pktTagV2f = new PacketTagData();
+			    pktTagV2f->SetCurrentEdgeType(EdgeType::CONDITION_3);
+			    pktTagV2f->SetNextActionType(PacketTagData::NextActionType::F2V);
+			    pktTagV2f->AddDataIdx(vertex1.reqDataIndex);
+			    sender->SetPacketTag(pktTagV2f);
+
+			    Simulator::ScheduleNow (&UdpSender::Send, sender);
+
+			    flag2 = true;
+			    break;
+			  }
+		      }
+		    break;
+		  }
+		default:
+		  break;
+	      }
+	    }
+	}
+    }
+#endif
+}
+
+void
+CsVfcScheduler::OnReceive (uint32_t nodeId, Ptr<const Packet> packet, const Address & srcAddr, const Address & destAddr)
+{
+//  receive_count++;
+//
+//  size_t start = context.find("/", 0);
+//  start = context.find("/", start + 1);
+//  size_t end = context.find("/", start + 1);
+//  std::string nodeIdStr = context.substr(start + 1, end - start - 1);
+//  uint32_t nodeId = 0;
+//  sscanf(nodeIdStr.c_str(), "%d", &nodeId);
+//
+////  Ptr<Node> node = NodeList::GetNode(nodeId);
+//
+  LogLine oss (LOG_RECEIVE);
+  if (oss.IsEnabled ())
+    {
+      oss << "sim time:" << Simulator::Now ().GetSeconds () << ", clock: " << (double)(clock()) / CLOCKS_PER_SEC;
+    }
+  if (oss.IsEnabled () && LogIsEnabled (LOG_RECEIVE_ADDRESS))
+    {
+      if (InetSocketAddress::IsMatchingType (srcAddr))
+	{
+	  InetSocketAddress inetSrcAddr = InetSocketAddress::ConvertFrom (srcAddr);
+	  oss << " src: " << inetSrcAddr.GetIpv4 ();
+	}
+      if (InetSocketAddress::IsMatchingType (destAddr))
+	{
+	  InetSocketAddress inetDestAddr = InetSocketAddress::ConvertFrom (destAddr);
+	  oss << " dest: " << inetDestAddr.GetIpv4 ();
+	}
+    }
+  using vanet::PacketHeader;
+  PacketHeader recvHeader;
+  Ptr<Packet> pktCopy = packet->Copy();
+  pktCopy->RemoveHeader(recvHeader);
+
+  oss << " bId: " << recvHeader.GetBroadcastId();
+
+  if (oss.IsEnabled () && LogIsEnabled (LOG_MSG_TYPE))
+    {
+      switch (recvHeader.GetType())
+      {
+	case PacketHeader::MessageType::NOT_SET:
+	  oss << " MessageType::NOT_SET ";
+	  break;
+	case PacketHeader::MessageType::REQUEST:
+	  oss << " MessageType::REQUEST ";
+	  break;
+	case PacketHeader::MessageType::DATA_C2V:
+	  oss << " MessageType::DATA_C2V ";
+	  break;
+	case PacketHeader::MessageType::DATA_V2F:
+	  oss << " MessageType::DATA_V2F ";
+	  break;
+	case PacketHeader::MessageType::DATA_F2F:
+	  oss << " MessageType::DATA_F2F ";
+	  break;
+	case PacketHeader::MessageType::DATA_F2V:
+	  oss << " MessageType::DATA_F2V ";
+	  break;
+	default:
+	  NS_ASSERT_MSG(false, "MessageType must be NOT_SET, REQUEST, DATA_C2V, DATA_V2F, DATA_F2F or DATA_F2V");
+      }
+    }
+
+  if (recvHeader.GetType() == PacketHeader::MessageType::REQUEST)
+    {
+      uint32_t pktSize = pktCopy->GetSize();
+      uint8_t buffer[pktSize];
+      pktCopy->CopyData(buffer, pktSize);
+      vanet::ByteBuffer bytes(buffer, pktSize);
+
+      m_experiment->ApplyVehicleUpload(bytes);
+
+      if (oss.IsEnabled () && LogIsEnabled (LOG_CLOUD_DATA))
+	{
+	  vanet::ByteBuffer idBytes(buffer, pktSize);
+	  uint32_t obuId = idBytes.ReadU32();
+	  uint32_t obuIdx = m_experiment->GetObuIndex(obuId);
+	  Vector3D obuPos = m_experiment->vehsMobInfoInCloud[obuIdx];
+	  oss << " veh_id=" << obuId
+	      << " veh_pos_x=" << obuPos.x
+	      << " veh_pos_y=" << obuPos.y;
+	  oss << std::endl;
+	  oss << "requests:";
+	  for (uint32_t req : m_experiment->vehsReqsInCloud[obuIdx])
+	    {
+	      oss << " " << req;
+	    }
+	  oss << std::endl;
+	  oss << "caches:";
+	  for (uint32_t cache : m_experiment->vehsCachesInCloud[obuIdx])
+	    {
+	      oss << " " << cache;
+	    }
+	}
+    }
+  else if (recvHeader.GetType() == PacketHeader::MessageType::DATA_C2V)
+    {
+      using vanet::PacketTagData;
+      PacketTagData pktTagC2v;
+      pktCopy->RemovePacketTag(pktTagC2v);
+      PacketTagData::IndexSpan reqIds = pktTagC2v.GetDataIdxs();
+      uint32_t broadcastDataNum = reqIds.size();
+
+      if (broadcastDataNum == 0) return;
+
+      // Judging whether the broadcasted data is encoded or not
+      bool isEncoded = broadcastDataNum == 1 ? false : true;
+
+      if (!isDecoding[recvHeader.GetBroadcastId()])
+	{
+//	  for (uint32_t i = 0; i < m_nObuNodes; i++)
+//	    {
+//	      std::set<uint32_t> datasNeeded;
+//	      datasNeeded.insert(reqIds.begin(), reqIds.end());
+//	      uint32_t fogReqIdx = fogIdx2FogReqInCliqueMaps.at(recvHeader.GetBroadcastId()).at(vehIdx2FogIdxMap.at(i));
+//	      datasNeeded.erase(fogReqIdx);
+//	      for (uint32_t cache : vehsCaches[i])
+//		{
+//		  datasNeeded.erase(cache);
+//		}
+//	      datasNeededForDecodingPerClique[i].insert(make_pair(recvHeader.GetBroadcastId(), datasNeeded));
+//	    }
+
+	  isDecoding[recvHeader.GetBroadcastId()] = true;
+	  Decode(isEncoded, recvHeader.GetBroadcastId());
+	}
+    }
+  else if (recvHeader.GetType() == PacketHeader::MessageType::DATA_V2F)
+    {
+      using vanet::PacketTagData;
+      PacketTagData pktTagV2f;
+      pktCopy->RemovePacketTag(pktTagV2f);
+
+//      std::cout << oss.str ();
+//      std::cout << V2F "fogIdx:" << nodeId <<",";
+//      pktTag.Print(std::cout);
+//      std::cout << endl;
+
+      EdgeType edgeType = pktTagV2f.GetCurrentEdgeType();
+      PacketTagData::NextActionType nextAction = pktTagV2f.GetNextActionType();
+
+      PrintEdgeType(edgeType, oss);
+
+      if (edgeType == EdgeType::NOT_SET)
+	{
+	  if (nextAction == PacketTagData::NextActionType::F2V)
+	    {
+	      Ptr<UdpSender> sender = CreateObject<UdpSender>();
+	      sender->SetNode(NodeList::GetNode(nodeId));
+	      sender->SetRemote(Ipv4Address("10.3.255.255"), m_experiment->m_i2VPort);
+	      sender->SetDataSize(Packet_Size);
+	      sender->Start();
+	      using vanet::PacketHeader;
+	      PacketHeader header;
+	      header.SetType(PacketHeader::MessageType::DATA_F2V);
+	      header.SetBroadcastId(recvHeader.GetBroadcastId());
+	      sender->SetHeader(header);
+
+	      using vanet::PacketTagData;
+	      PacketTagData *pktTagF2v = new PacketTagData();
+	      pktTagF2v->SetCurrentEdgeType(EdgeType::NOT_SET);
+	      pktTagF2v->SetNextActionType(PacketTagData::NextActionType::NOT_SET);
+	      pktTagF2v->SetFogId(nodeId);
+	      pktTagF2v->SetDataIdxs(pktTagV2f.GetDataIdxs());
+	      sender->SetPacketTag(pktTagF2v);
+
+	      Simulator::ScheduleNow (&UdpSender::Send, sender);
+	    }
+	}
+      else if (edgeType == EdgeType::CONDITION_1)
+	{
+	  PacketTagData::IndexSpan rsuWaitingServedIdxs = pktTagV2f.GetRsuWaitingServedIdxs();
+	  for (uint32_t rsuIdx : rsuWaitingServedIdxs)
+	    {
+	      Ptr<UdpSender> sender = CreateObject<UdpSender>();
+	      sender->SetNode(NodeList::GetNode(nodeId));
+	      sender->SetRemote(m_experiment->m_rsuCsmaInterfaces.GetAddress(rsuIdx), m_experiment->m_i2IPort);
+	      sender->SetDataSize(Packet_Size);
+	      sender->Start();
+	      using vanet::PacketHeader;
+	      PacketHeader header;
+	      header.SetType(PacketHeader::MessageType::DATA_F2F);
+	      header.SetBroadcastId(recvHeader.GetBroadcastId());
+	      sender->SetHeader(header);
+
+	      using vanet::PacketTagData;
+	      PacketTagData *pktTagF2f = new PacketTagData();
+	      pktTagF2f->SetCurrentEdgeType(EdgeType::CONDITION_1);
+	      pktTagF2f->SetDataIdxs(pktTagV2f.GetDataIdxs());
+	      sender->SetPacketTag(pktTagF2f);
+
+	      Simulator::ScheduleNow (&UdpSender::Send, sender);
+	    }
+	}
+//      else if (nextAction == PacketTagData::NextActionType::F2V)
+      else if (edgeType == EdgeType::CONDITION_2)
+	{
+	  Ptr<UdpSender> sender = CreateObject<UdpSender>();
+	  sender->SetNode(NodeList::GetNode(nodeId));
+	  sender->SetRemote(Ipv4Address("10.3.255.255"), m_experiment->m_i2VPort);
+	  sender->SetDataSize(Packet_Size);
+	  sender->Start();
+	  using vanet::PacketHeader;
+	  PacketHeader header;
+	  header.SetType(PacketHeader::MessageType::DATA_F2V);
+	  header.SetBroadcastId(recvHeader.GetBroadcastId());
+	  sender->SetHeader(header);
+
+	  using vanet::PacketTagData;
+	  PacketTagData *pktTagF2v = new PacketTagData();
+	  pktTagF2v->SetCurrentEdgeType(EdgeType::CONDITION_2);
+	  pktTagF2v->SetNextActionType(PacketTagData::NextActionType::NOT_SET);
+	  pktTagF2v->SetFogId(nodeId);
+	  pktTagF2v->SetDataIdxs(pktTagV2f.GetDataIdxs());
+	  sender->SetPacketTag(pktTagF2v);
+
+	  Simulator::ScheduleNow (&UdpSender::Send, sender);
+	}
+      else if (edgeType == EdgeType::CONDITION_3)
+	{
+	  if (nextAction == PacketTagData::NextActionType::F2V)
+	    {
+	      Ptr<UdpSender> sender = CreateObject<UdpSender>();
+	      sender->SetNode(NodeList::GetNode(nodeId));
+	      sender->SetRemote(Ipv4Address("10.3.255.255"), m_experiment->m_i2VPort);
+	      sender->SetDataSize(Packet_Size);
+	      sender->Start();
+	      using vanet::PacketHeader;
+	      PacketHeader header;
+	      header.SetType(PacketHeader::MessageType::DATA_F2V);
+	      header.SetBroadcastId(recvHeader.GetBroadcastId());
+	      sender->SetHeader(header);
+
+	      using vanet::PacketTagData;
+	      PacketTagData *pktTagF2v = new PacketTagData();
+	      pktTagF2v->SetCurrentEdgeType(EdgeType::CONDITION_3);
+	      pktTagF2v->SetNextActionType(PacketTagData::NextActionType::V2F);
+	      pktTagF2v->SetFogId(nodeId);
+	      pktTagF2v->SetRsuWaitingServedIdxs(pktTagV2f.GetRsuWaitingServedIdxs());
+	      pktTagF2v->SetDataIdxs(pktTagV2f.GetDataIdxs());
+	      sender->SetPacketTag(pktTagF2v);
+
+	      Simulator::ScheduleNow (&UdpSender::Send, sender);
+	    }
+	  else if (nextAction == PacketTagData::NextActionType::F2F)
+	    {
+	      PacketTagData::IndexSpan rsuWaitingServedIdxs = pktTagV2f.GetRsuWaitingServedIdxs();
+	      for (uint32_t rsuIdx : rsuWaitingServedIdxs)
+		{
+		  Ptr<UdpSender> sender = CreateObject<UdpSender>();
+		  sender->SetNode(NodeList::GetNode(nodeId));
+		  sender->SetRemote(m_experiment->m_rsuCsmaInterfaces.GetAddress(rsuIdx), m_experiment->m_i2IPort);
+		  sender->SetDataSize(Packet_Size);
+		  sender->Start();
+		  using vanet::PacketHeader;
+		  PacketHeader header;
+		  header.SetType(PacketHeader::MessageType::DATA_F2F);
+		  header.SetBroadcastId(recvHeader.GetBroadcastId());
+		  sender->SetHeader(header);
+
+		  using vanet::PacketTagData;
+		  PacketTagData *pktTagF2f = new PacketTagData();
+		  pktTagF2f->SetCurrentEdgeType(EdgeType::CONDITION_3);
+		  pktTagF2f->SetDataIdxs(pktTagV2f.GetDataIdxs());
+		  sender->SetPacketTag(pktTagF2f);
+
+		  Simulator::ScheduleNow (&UdpSender::Send, sender);
+		}
+	    }
+	}
+
+    }
+  else if (recvHeader.GetType() == PacketHeader::MessageType::DATA_F2F)
+    {
+      using vanet::PacketTagData;
+      PacketTagData pktTagF2f;
+      pktCopy->RemovePacketTag(pktTagF2f);
+
+//      std::cout << oss.str ();
+//      std::cout << " F2F fogIdx:" << nodeId <<",";
+//      pktTag.Print(std::cout);
+//      std::cout << endl;
+
+      EdgeType edgeType = pktTagF2f.GetCurrentEdgeType();
+
+      PrintEdgeType(edgeType, oss);
+
+      if (edgeType == EdgeType::CONDITION_1)
+	{
+	  Ptr<UdpSender> sender = CreateObject<UdpSender>();
+	  sender->SetNode(NodeList::GetNode(nodeId));
+	  sender->SetRemote(Ipv4Address ("10.3.255.255"), m_experiment->m_i2VPort);
+	  sender->SetDataSize(Packet_Size);
+	  sender->Start();
+	  using vanet::PacketHeader;
+	  PacketHeader header;
+	  header.SetType(PacketHeader::MessageType::DATA_F2V);
+	  header.SetBroadcastId(recvHeader.GetBroadcastId());
+	  sender->SetHeader(header);
+
+	  using vanet::PacketTagData;
+	  PacketTagData *pktTagF2v = new PacketTagData();
+	  pktTagF2v->SetCurrentEdgeType(EdgeType::CONDITION_1);
+	  pktTagF2v->SetNextActionType(PacketTagData::NextActionType::NOT_SET);
+	  pktTagF2v->SetFogId(nodeId);
+	  pktTagF2v->SetDataIdxs(pktTagF2f.GetDataIdxs());
+	  sender->SetPacketTag(pktTagF2v);
+
+	  Simulator::ScheduleNow (&UdpSender::Send, sender);
+	}
+      else if (edgeType == EdgeType::CONDITION_3)
+	{
+	  Ptr<UdpSender> sender = CreateObject<UdpSender>();
+	  sender->SetNode(NodeList::GetNode(nodeId));
+	  sender->SetRemote(Ipv4Address ("10.3.255.255"), m_experiment->m_i2VPort);
+	  sender->SetDataSize(Packet_Size);
+	  sender->Start();
+	  using vanet::PacketHeader;
+	  PacketHeader header;
+	  header.SetType(PacketHeader::MessageType::DATA_F2V);
+	  header.SetBroadcastId(recvHeader.GetBroadcastId());
+	  sender->SetHeader(header);
+
+	  using vanet::PacketTagData;
+	  PacketTagData *pktTagF2v = new PacketTagData();
+	  pktTagF2v->SetCurrentEdgeType(EdgeType::CONDITION_3);
+	  pktTagF2v->SetNextActionType(PacketTagData::NextActionType::NOT_SET);
+	  pktTagF2v->SetFogId(nodeId);
+	  pktTagF2v->SetDataIdxs(pktTagF2f.GetDataIdxs());
+	  sender->SetPacketTag(pktTagF2v);
+
+	  Simulator::ScheduleNow (&UdpSender::Send, sender);
+	}
+    }
+  else if (recvHeader.GetType() == PacketHeader::MessageType::DATA_F2V)
+    {
+      using vanet::PacketTagData;
+      PacketTagData pktTagF2v;
+      pktCopy->RemovePacketTag(pktTagF2v);
+
+      uint32_t fogId = pktTagF2v.GetFogId();
+      Ptr<Node> rsu = NodeList::GetNode(fogId);
+      Ptr<MobilityModel> rsuMobility = rsu->GetObject<MobilityModel> ();
+      Vector pos_rsu = rsuMobility->GetPosition ();
+
+      Ptr<Node> obu = NodeList::GetNode(nodeId);
+      Ptr<MobilityModel> obuMobility = obu->GetObject<MobilityModel> ();
+      Vector pos_obu = obuMobility->GetPosition ();
+
+      if (CalculateDistance (pos_obu, pos_rsu) > Device_Transmission_Range )
+	{
+	  return;
+	}
+
+      uint32_t fogIdx = m_experiment->fogId2FogIdxMap.at(pktTagF2v.GetFogId());
+      uint32_t obuIdx = m_experiment->GetObuIndex(nodeId);
+      uint32_t broadcastId = recvHeader.GetBroadcastId();
+      EdgeType edgeType = pktTagF2v.GetCurrentEdgeType();
+      PacketTagData::NextActionType nextAction = pktTagF2v.GetNextActionType();
+
+      PrintEdgeType(edgeType, oss);
+
+      if (edgeType == EdgeType::CONDITION_1)
+	{
+	  PacketTagData::IndexSpan dataIdxs = pktTagF2v.GetDataIdxs();
+	  for (uint32_t dataIdx : dataIdxs)
+	    {
+	      if (m_experiment->vehsReqs[obuIdx].count(dataIdx) != 0)
+		{
+//		  vehsCaches[obuIdx].insert(dataIdx);
+//		  map<uint32_t, std::set<uint32_t>>::iterator iter = datasNeededForDecodingPerClique[obuIdx].begin();
+//		  for (; iter != datasNeededForDecodingPerClique[obuIdx].end(); iter++)
+//		    {
+//		      iter->second.erase(dataIdx);
+//		      if (iter->second.size() == 0)
+//			{
+//			  if (fogIdx2FogReqInCliqueMaps.count(iter->first)
+//			      && fogIdx2FogReqInCliqueMaps.at(iter->first).count(fogIdx))
+//			    {
+//			      uint32_t fogReqIdx = fogIdx2FogReqInCliqueMaps.at(iter->first).at(fogIdx);
+//			      if (vehsReqs[obuIdx].count(fogReqIdx) != 0)
+//				{
+//				  vehsReqs[obuIdx].erase(fogReqIdx);
+//				  vehsCaches[obuIdx].insert(fogReqIdx);
+//				  RecordStats(obuIdx, fogReqIdx);
+//				}
+//			    }
+//			}
+//		    }
+
+		  m_experiment->vehsReqs[obuIdx].erase(dataIdx);
+		  m_experiment->RecordStats(obuIdx, dataIdx);
+
+		  m_experiment->vehsCaches[obuIdx].insert(dataIdx);
+		  map<uint32_t, std::set<uint32_t>>::iterator iter = datasNeededForDecodingPerClique[obuIdx].find(broadcastId);
+//		  NS_ASSERT (iter != datasNeededForDecodingPerClique[obuIdx].end());
+		  if (iter != datasNeededForDecodingPerClique[obuIdx].end())
+		    {
+		      iter->second.erase(dataIdx);
+		      if (iter->second.size() == 0)
+			{
+			  if (fogIdx2FogReqInCliqueMaps.count(iter->first)
+			      && fogIdx2FogReqInCliqueMaps.at(iter->first).count(fogIdx))
+			    {
+			      uint32_t fogReqIdx = fogIdx2FogReqInCliqueMaps.at(iter->first).at(fogIdx);
+			      if (m_experiment->vehsReqs[obuIdx].count(fogReqIdx) != 0)
+				{
+				  m_experiment->vehsReqs[obuIdx].erase(fogReqIdx);
+				  m_experiment->vehsCaches[obuIdx].insert(fogReqIdx);
+				  m_experiment->RecordStats(obuIdx, fogReqIdx);
+				}
+			    }
+			}
+		    }
+
+		  m_experiment->vehsReqs[obuIdx].erase(dataIdx);
+		  m_experiment->RecordStats(obuIdx, dataIdx);
+		}
+	    }
+	}
+      else if (edgeType == EdgeType::CONDITION_2)
+	{
+	  if (fogIdx2FogReqInCliqueMaps.count(broadcastId) == 0) return;
+	  PacketTagData::IndexSpan dataIdxs = pktTagF2v.GetDataIdxs();
+	  for (uint32_t dataIdx : dataIdxs)
+	    {
+
+//	      vehsCaches[obuIdx].insert(dataIdx);
+//	      map<uint32_t, std::set<uint32_t>>::iterator iter = datasNeededForDecodingPerClique[obuIdx].begin();
+//	      for (; iter != datasNeededForDecodingPerClique[obuIdx].end(); iter++)
+//		{
+//		  iter->second.erase(dataIdx);
+//		  if (iter->second.size() == 0)
+//		    {
+//		      if (fogIdx2FogReqInCliqueMaps.count(iter->first)
+//			  && fogIdx2FogReqInCliqueMaps.at(iter->first).count(fogIdx))
+//			{
+//			  uint32_t fogReqIdx = fogIdx2FogReqInCliqueMaps.at(iter->first).at(fogIdx);
+//			  if (vehsReqs[obuIdx].count(fogReqIdx) != 0)
+//			    {
+//			      vehsReqs[obuIdx].erase(fogReqIdx);
+//			      vehsCaches[obuIdx].insert(fogReqIdx);
+//			      RecordStats(obuIdx, fogReqIdx);
+//			    }
+//			}
+//		    }
+//		}
+//	      if (vehsReqs[obuIdx].count(dataIdx) != 0)
+//		{
+//		  vehsReqs[obuIdx].erase(dataIdx);
+//		  vehsCaches[obuIdx].insert(dataIdx);
+//		  RecordStats(obuIdx, dataIdx);
+//		}
+
+	      map<uint32_t, std::set<uint32_t>>::iterator iter = datasNeededForDecodingPerClique[obuIdx].find(broadcastId);
+//	      NS_ASSERT (iter != datasNeededForDecodingPerClique[obuIdx].end());
+	      if (iter != datasNeededForDecodingPerClique[obuIdx].end())
+		{
+		  iter->second.erase(dataIdx);
+		  if (iter->second.size() == 0)
+		    {
+		      if (fogIdx2FogReqInCliqueMaps.count(iter->first)
+			  && fogIdx2FogReqInCliqueMaps.at(iter->first).count(fogIdx))
+			{
+			  uint32_t fogReqIdx = fogIdx2FogReqInCliqueMaps.at(iter->first).at(fogIdx);
+			  if (m_experiment->vehsReqs[obuIdx].count(fogReqIdx) != 0)
+			    {
+			      m_experiment->vehsReqs[obuIdx].erase(fogReqIdx);
+			      m_experiment->vehsCaches[obuIdx].insert(fogReqIdx);
+			      m_experiment->RecordStats(obuIdx, fogReqIdx);
+			    }
+			}
+		    }
+		}
+
+	      if (m_experiment->vehsReqs[obuIdx].count(dataIdx) != 0)
+		{
+		  m_experiment->vehsReqs[obuIdx].erase(dataIdx);
+		  m_experiment->vehsCaches[obuIdx].insert(dataIdx);
+		  m_experiment->RecordStats(obuIdx, dataIdx);
+		}
+	    }
+	}
+      else if (edgeType == EdgeType::CONDITION_3)
+	{
+	  if (fogIdx2FogReqInCliqueMaps.count(recvHeader.GetBroadcastId()) == 0) return;
+	  PacketTagData::IndexSpan dataIdxs = pktTagF2v.GetDataIdxs();
+	  for (uint32_t dataIdx : dataIdxs)
+	    {
+//	      vehsCaches[obuIdx].insert(dataIdx);
+//	      map<uint32_t, std::set<uint32_t>>::iterator iter = datasNeededForDecodingPerClique[obuIdx].begin();
+//	      for (; iter != datasNeededForDecodingPerClique[obuIdx].end(); iter++)
+//		{
+//		  iter->second.erase(dataIdx);
+//		  if (iter->second.size() == 0)
+//		    {
+//		      if (fogIdx2FogReqInCliqueMaps.count(iter->first)
+//			  && fogIdx2FogReqInCliqueMaps.at(iter->first).count(fogIdx))
+//			{
+//			  uint32_t fogReqIdx = fogIdx2FogReqInCliqueMaps.at(iter->first).at(fogIdx);
+//			  if (vehsReqs[obuIdx].count(fogReqIdx) != 0)
+//			    {
+//			      vehsReqs[obuIdx].erase(fogReqIdx);
+//			      vehsCaches[obuIdx].insert(fogReqIdx);
+//			      RecordStats(obuIdx, fogReqIdx);
+//			    }
+//			}
+//		    }
+//		}
+//	      if (vehsReqs[obuIdx].count(dataIdx) != 0)
+//		{
+//		  vehsReqs[obuIdx].erase(dataIdx);
+//		  RecordStats(obuIdx, dataIdx);
+//		}
+
+	      map<uint32_t, std::set<uint32_t>>::iterator iter = datasNeededForDecodingPerClique[obuIdx].find(broadcastId);
+//	      NS_ASSERT (iter != datasNeededForDecodingPerClique[obuIdx].end());
+	      if (iter != datasNeededForDecodingPerClique[obuIdx].end())
+		{
+		  iter->second.erase(dataIdx);
+		  if (iter->second.size() == 0)
+		    {
+		      if (fogIdx2FogReqInCliqueMaps.count(iter->first)
+			  && fogIdx2FogReqInCliqueMaps.at(iter->first).count(fogIdx))
+			{
+			  uint32_t fogReqIdx = fogIdx2FogReqInCliqueMaps.at(iter->first).at(fogIdx);
+			  if (m_experiment->vehsReqs[obuIdx].count(fogReqIdx) != 0)
+			    {
+			      m_experiment->vehsReqs[obuIdx].erase(fogReqIdx);
+			      m_experiment->vehsCaches[obuIdx].insert(fogReqIdx);
+			      m_experiment->RecordStats(obuIdx, fogReqIdx);
+			    }
+			}
+		    }
+		}
+
+	      if (m_experiment->vehsReqs[obuIdx].count(dataIdx) != 0)
+		{
+		  m_experiment->vehsReqs[obuIdx].erase(dataIdx);
+		  m_experiment->vehsCaches[obuIdx].insert(dataIdx);
+		  m_experiment->RecordStats(obuIdx, dataIdx);
+		}
+
+	      if (nextAction == PacketTagData::NextActionType::V2F)
+		{
+		  if (pktTagF2v.GetRsuWaitingServedIdxs().size() != 0)
+		    {
+		      Ptr<UdpSender> sender = CreateObject<UdpSender>();
+		      sender->SetNode(NodeList::GetNode(nodeId));
+		      sender->SetRemote(m_experiment->m_rsu80211pInterfaces.GetAddress(fogIdx), m_experiment->m_v2IPort);
+		      sender->SetDataSize(Packet_Size);
+		      sender->Start();
+		      using vanet::PacketHeader;
+		      PacketHeader header;
+		      header.SetType(PacketHeader::MessageType::DATA_V2F);
+		      header.SetBroadcastId(recvHeader.GetBroadcastId());
+		      sender->SetHeader(header);
+
+		      using vanet::PacketTagData;
+		      PacketTagData *pktTagV2f = new PacketTagData();
+		      pktTagV2f->SetCurrentEdgeType(EdgeType::CONDITION_3);
+		      pktTagV2f->SetNextActionType(PacketTagData::NextActionType::F2F);
+		      pktTagV2f->SetRsuWaitingServedIdxs(pktTagF2v.GetRsuWaitingServedIdxs());
+		      pktTagV2f->SetDataIdxs(dataIdxs);
+		      sender->SetPacketTag(pktTagV2f);
+
+		      Simulator::ScheduleNow (&UdpSender::Send, sender);
+		    }
+		}
+	    }
+	}
+    }
+  oss << " DbSize:" << m_experiment->globalDbSize;
+  if (oss.IsEnabled ())
+    {
+      NS_LOG_UNCOND(oss.str());
+    }
+}
+
+void
+CsVfcScheduler::FillTickRecord (TickRecord& record) const
+{
+  record.graphSize = m_graphSize;
+  record.cliqueSize = m_cliqueSize;
+}
+
+void
+CsVfcScheduler::PrintEdgeType (const EdgeType& edgeType, LogLine& oss)
+{
+  if (oss.IsEnabled () && LogIsEnabled (LOG_EDGE_TYPE))
+    {
+      switch (edgeType)
+      {
+	case EdgeType::NOT_SET:
+	  oss << " EdgeType::NOT_SET ";
+	  break;
+	case EdgeType::CONDITION_1:
+	  oss << " EdgeType::CONDITION_1 ";
+	  break;
+	case EdgeType::CONDITION_2:
+	  oss << " EdgeType::CONDITION_2 ";
+	  break;
+	case EdgeType::CONDITION_3:
+	  oss << " EdgeType::CONDITION_3 ";
+	  break;
+	default:
+	  NS_ASSERT_MSG(false, "EdgeType must be NOT_SET, CONDITION_1, CONDITION_2, or CONDITION_3");
+      }
+    }
+}
+
+} // namespace vanet
+} // namespace ns3
@@ -0,0 +1,49 @@
+#ifndef SCRATCH_VANET_CS_VFC_CS_VFC_SCHEDULER_H_
+#define SCRATCH_VANET_CS_VFC_CS_VFC_SCHEDULER_H_
+
+#include <cstdint>
+#include <map>
+#include <set>
+#include <sstream>
+#include <vector>
+
+#include "graph.hpp"
+#include "log-category.h"
+#include "broadcast-scheduler.h"
+
+namespace ns3 {
+namespace vanet {
+
+/**
+ * \brief Scheme "cs-vfc": build the fog request graph, search cliques and
+ * broadcast one coded packet per clique, forwarded by the fog nodes.
+ */
+class CsVfcScheduler : public BroadcastScheduler
+{
+public:
+  CsVfcScheduler (VanetCsVfcExperiment *experiment);
+
+  virtual void OnTick (void);
+  virtual void OnReceive (uint32_t nodeId, Ptr<const Packet> packet, const Address & srcAddr, const Address & destAddr);
+  virtual void FillTickRecord (TickRecord& record) const;
+
+private:
+  void Decode (bool isEncoded, uint32_t broadcastId);
+
+  void PrintEdgeType (const EdgeType& edgeType, LogLine& oss);
+
+  std::map<uint32_t, bool> isDecoding;  // clique status
+  GraphMatrix<VertexNode> graph;
+  std::vector<std::vector<VertexNode>> cliques;
+  std::map<uint32_t, std::vector<VertexNode>> broadcastId2cliqueMap;
+  std::vector<std::map<uint32_t, std::set<uint32_t>>> datasNeededForDecodingPerClique;
+  std::map<uint32_t, std::map<uint32_t, uint32_t>> fogIdx2FogReqInCliqueMaps;
+
+  uint32_t m_graphSize; ///< vertices of the graph built on the last tick
+  uint32_t m_cliqueSize; ///< vertices of the largest clique found on the last tick
+};
+
+} // namespace vanet
+} // namespace ns3
+
+#endif /* SCRATCH_VANET_CS_VFC_CS_VFC_SCHEDULER_H_ */
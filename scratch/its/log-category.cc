@@ -0,0 +1,98 @@
+#include "ns3/fatal-error.h"
+#include "log-category.h"
+
+namespace ns3 {
+namespace vanet {
+
+uint32_t g_logCategories = LOG_FINAL_REQUEST;
+
+static const struct
+{
+  const char *name;
+  LogCategory category;
+} g_logCategoryNames[] =
+{
+  { "receive",		LOG_RECEIVE },
+  { "receive-address",	LOG_RECEIVE_ADDRESS },
+  { "msg-type",		LOG_MSG_TYPE },
+  { "edge-type",	LOG_EDGE_TYPE },
+  { "cloud-data",	LOG_CLOUD_DATA },
+  { "initial-request",	LOG_INITIAL_REQUEST },
+  { "initial-cache",	LOG_INITIAL_CACHE },
+  { "request",		LOG_REQUEST },
+  { "final-request",	LOG_FINAL_REQUEST },
+  { "final-cache",	LOG_FINAL_CACHE },
+  { "fog-cluster",	LOG_FOG_CLUSTER },
+  { "edge",		LOG_EDGE },
+  { "cliques",		LOG_CLIQUES },
+  { "clique-time",	LOG_CLIQUE_TIME },
+  { "broadcast",	LOG_BROADCAST },
+  { "all",		LOG_ALL },
+  { "none",		LOG_NONE },
+};
+
+void
+LogSetCategories (const std::string& spec)
+{
+  uint32_t categories = LOG_NONE;
+  std::string::size_type cur = 0;
+  while (cur <= spec.size ())
+    {
+      std::string::size_type next = spec.find ('|', cur);
+      if (next == std::string::npos)
+	{
+	  next = spec.size ();
+	}
+      std::string name = spec.substr (cur, next - cur);
+      cur = next + 1;
+      if (name.empty ())
+	{
+	  continue;
+	}
+
+      bool found = false;
+      for (const auto& entry : g_logCategoryNames)
+	{
+	  if (name.compare (entry.name) == 0)
+	    {
+	      categories |= entry.category;
+	      found = true;
+	      break;
+	    }
+	}
+      if (!found)
+	{
+	  NS_FATAL_ERROR ("Unknown log category \"" << name << "\"");
+	}
+    }
+  g_logCategories = categories;
+}
+
+LogLine::LogLine (LogCategory category)
+  : m_os (LogIsEnabled (category) ? new std::ostringstream () : 0)
+{
+}
+
+LogLine::~LogLine ()
+{
+  delete m_os;
+}
+
+LogLine &
+LogLine::operator<< (std::ostream & (*manip) (std::ostream &))
+{
+  if (m_os != 0)
+    {
+      manip (*m_os);
+    }
+  return *this;
+}
+
+std::string
+LogLine::str (void) const
+{
+  return m_os != 0 ? m_os->str () : std::string ();
+}
+
+} // namespace vanet
+} // namespace ns3
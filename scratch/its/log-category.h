@@ -0,0 +1,98 @@
+#ifndef SCRATCH_VANET_CS_VFC_LOG_CATEGORY_H_
+#define SCRATCH_VANET_CS_VFC_LOG_CATEGORY_H_
+
+#include <cstdint>
+#include <ostream>
+#include <sstream>
+#include <string>
+
+namespace ns3 {
+namespace vanet {
+
+/**
+ * Diagnostic output of the experiment, selected at run time with --log,
+ * e.g. --log="cliques|fog-cluster", --log=all or --log=none.
+ */
+enum LogCategory
+{
+  LOG_NONE			= 0x00000000,
+  LOG_RECEIVE			= 0x00000001, ///< "receive": one line per received packet
+  LOG_RECEIVE_ADDRESS		= 0x00000002, ///< "receive-address": addresses in the receive line
+  LOG_MSG_TYPE			= 0x00000004, ///< "msg-type": message type in the receive line
+  LOG_EDGE_TYPE			= 0x00000008, ///< "edge-type": edge type in the receive line
+  LOG_CLOUD_DATA		= 0x00000010, ///< "cloud-data": uploaded vehicle info in the receive line
+  LOG_INITIAL_REQUEST		= 0x00000020, ///< "initial-request": initial requests of every vehicle
+  LOG_INITIAL_CACHE		= 0x00000040, ///< "initial-cache": initial caches of every vehicle
+  LOG_REQUEST			= 0x00000080, ///< "request": requests of every vehicle on every tick
+  LOG_FINAL_REQUEST		= 0x00000100, ///< "final-request": unsatisfied requests at the end
+  LOG_FINAL_CACHE		= 0x00000200, ///< "final-cache": incomplete caches at the end
+  LOG_FOG_CLUSTER		= 0x00000400, ///< "fog-cluster": vehicles of every fog on every tick
+  LOG_EDGE			= 0x00000800, ///< "edge": edges of the cs-vfc graph
+  LOG_CLIQUES			= 0x00001000, ///< "cliques": cliques found by cs-vfc
+  LOG_CLIQUE_TIME		= 0x00002000, ///< "clique-time": time spent building the graph and searching cliques
+  LOG_BROADCAST			= 0x00004000, ///< "broadcast": packets chosen by ncb and ma
+  LOG_ALL			= 0x00007fff
+};
+
+extern uint32_t g_logCategories; ///< enabled categories, LOG_FINAL_REQUEST by default
+
+/**
+ * \param category a category
+ * \return true if the category is enabled; a single test, nothing is formatted
+ */
+inline bool
+LogIsEnabled (LogCategory category)
+{
+  return (g_logCategories & category) != 0;
+}
+
+/**
+ * \brief Enable exactly the categories named in spec, separated by '|'
+ * \param spec category names, "all" or "none"
+ * \return none
+ */
+void LogSetCategories (const std::string& spec);
+
+/**
+ * \brief A log line which is only built when its category is enabled.
+ *
+ * When disabled, no stream is created and every insertion is a single test.
+ * Arguments are still evaluated, so expensive ones should be guarded with
+ * IsEnabled ().
+ */
+class LogLine
+{
+public:
+  LogLine (LogCategory category);
+  ~LogLine ();
+
+  bool IsEnabled (void) const { return m_os != 0; }
+
+  template <typename T>
+  LogLine & operator<< (const T& value)
+  {
+    if (m_os != 0)
+      {
+	*m_os << value;
+      }
+    return *this;
+  }
+
+  LogLine & operator<< (std::ostream & (*manip) (std::ostream &));
+
+  /**
+   * \return the line built so far, empty when disabled
+   */
+  std::string str (void) const;
+
+private:
+  LogLine (const LogLine&);
+  LogLine & operator= (const LogLine&);
+
+  std::ostringstream *m_os;
+};
+
+} // namespace vanet
+} // namespace ns3
+
+#endif /* SCRATCH_VANET_CS_VFC_LOG_CATEGORY_H_ */
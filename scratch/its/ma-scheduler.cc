@@ -0,0 +1,326 @@
+#include "vanet-cs-vfc.h"
+#include "ma-scheduler.h"
+#include "checkpoint.h"
+
+namespace ns3 {
+namespace vanet {
+
+MaScheduler::MaScheduler (VanetCsVfcExperiment *experiment)
+  : BroadcastScheduler (experiment),
+    mwVehsCachesMatrix (0)
+{
+  if(!libMAInitialize())
+  {
+    NS_FATAL_ERROR ("Could not initialize libMA!");
+  }
+  if(!libMADecodeInitialize())
+  {
+    NS_FATAL_ERROR ("Could not initialize libMADecode!");
+  }
+
+  FillCachesMatrix (m_experiment->vehsInitialCaches);
+}
+
+MaScheduler::~MaScheduler ()
+{
+  delete mwVehsCachesMatrix;
+
+  libMATerminate();
+
+  libMADecodeTerminate();
+
+  mclTerminateApplication();
+}
+
+void
+MaScheduler::FillCachesMatrix (const std::vector<std::set<uint32_t>>& caches)
+{
+  uint32_t globalDbSize = m_experiment->globalDbSize;
+  uint32_t nObuNodes = m_experiment->m_nObuNodes;
+  mwSize dims[3] = {globalDbSize, globalDbSize, nObuNodes};
+  delete mwVehsCachesMatrix;
+  mwVehsCachesMatrix = new mwArray(3, dims, mxDOUBLE_CLASS);
+  for (uint32_t obuIdx = 0; obuIdx < nObuNodes; obuIdx++)
+    {
+      uint32_t k = 1;
+      for (uint32_t i = 0; i < globalDbSize; i++)
+	{
+	  if (caches[obuIdx].count(i))
+	    {
+	      (*mwVehsCachesMatrix)(k, i + 1, obuIdx + 1) = 1.0;
+	      k += 1;
+	    }
+	}
+    }
+}
+
+void
+MaScheduler::Save (CheckpointWriter& writer) const
+{
+  writer.Write (dataToBroadcast);
+
+  // the cache matrix is updated by every decode, so it is saved whole
+  std::vector<double> elements(mwVehsCachesMatrix->NumberOfElements());
+  mwVehsCachesMatrix->GetData(elements.data(), elements.size());
+  writer.Write (static_cast<uint64_t> (elements.size()));
+  writer.WriteBytes (elements.data(), elements.size() * sizeof (double));
+}
+
+void
+MaScheduler::Load (CheckpointReader& reader)
+{
+  reader.Read (dataToBroadcast);
+
+  uint64_t size;
+  reader.Read (size);
+  NS_ASSERT_MSG (size == mwVehsCachesMatrix->NumberOfElements(), "cache matrix of checkpoint " << reader.GetFileName() << " does not fit");
+  std::vector<double> elements(size);
+  reader.ReadBytes (elements.data(), size * sizeof (double));
+  mwVehsCachesMatrix->SetData(elements.data(), size);
+}
+
+void
+MaScheduler::RebuildFromCaches ()
+{
+  // the checkpoint of another scheme carries no matrix, only the data
+  // every vehicle has decoded so far; a vehicle that has not submitted
+  // yet still holds its initial caches
+  std::vector<std::set<uint32_t>> caches = m_experiment->vehsCaches;
+  for (uint32_t obuIdx = 0; obuIdx < m_experiment->m_nObuNodes; obuIdx++)
+    {
+      if (m_experiment->isFirstSubmit[obuIdx])
+	{
+	  caches[obuIdx] = m_experiment->vehsInitialCaches[obuIdx];
+	}
+    }
+  FillCachesMatrix (caches);
+}
+
+void
+MaScheduler::OnTick ()
+{
+  std::set<uint32_t> vehs;
+  for (uint32_t i = 0; i < m_experiment->m_nObuNodes; i++)
+    {
+      if (m_experiment->vehsStatus[i]) vehs.insert(i);
+    }
+  if (vehs.size() == 0) return;
+
+  bool flag = true;
+  for (uint32_t veh : vehs)
+    {
+      if (!m_experiment->vehsReqs[veh].empty())
+	{
+	  flag = false;
+	  break;
+	}
+    }
+  if (flag) return;
+
+  mwSize dims[3] = {m_experiment->globalDbSize, m_experiment->globalDbSize, vehs.size()};
+  mwArray mwVehsCachesMatrixTmp(3, dims, mxDOUBLE_CLASS);
+  mwArray mwTick(1, 1, mxUINT32_CLASS);
+  uint32_t k = 1;
+  for (uint32_t veh : vehs)
+    {
+      for (uint32_t i = 1; i <= m_experiment->globalDbSize; i++)
+	{
+	  for (uint32_t j = 1; j <= m_experiment->globalDbSize; j++)
+	    {
+	      mwVehsCachesMatrixTmp(i, j, k) = (*mwVehsCachesMatrix)(i, j, veh + 1);
+	    }
+	}
+      k += 1;
+    }
+
+  mwTick(1, 1) = Num_Cliques;
+
+  mwArray mwResult1(mxUINT32_CLASS);
+  mwArray mwResult2(1, 1, mxUINT32_CLASS);
+  MA(2, mwResult1, mwResult2, mwVehsCachesMatrixTmp, mwTick);
+
+  bool logBroadcast = LogIsEnabled (LOG_BROADCAST);
+  if (logBroadcast)
+    {
+      cout << "sim time " << Now().GetSeconds() << " ----------------------------" << endl;
+    }
+  uint32_t time = mwResult2.Get(1, 1);
+  for (uint32_t i = 1; i <= time; i++)
+    {
+      m_experiment->currentBroadcastId++;
+      if (logBroadcast)
+	{
+	  std::cout << "bID " << m_experiment->currentBroadcastId << ":";
+	}
+
+      for (uint32_t j = 1; j <= m_experiment->globalDbSize; j++)
+	{
+	  if (logBroadcast)
+	    {
+	      std::cout << " " << mwResult1(i, j);
+	    }
+
+	  if ((uint32_t)mwResult1(i, j) == 1)
+	    {
+	      dataToBroadcast[m_experiment->currentBroadcastId].push_back(j - 1);
+	    }
+	}
+      if (logBroadcast)
+	{
+	  std::cout << std::endl;
+	}
+
+      m_experiment->m_requestStats.IncBroadcastPkts();
+
+      Ptr<UdpSender> sender = CreateObject<UdpSender>();
+      sender->SetNode(m_experiment->m_remoteHost);
+      sender->SetRemote(Ipv4Address ("10.2.255.255"), m_experiment->m_dlPort);
+      sender->SetDataSize(Packet_Size);
+      sender->Start();
+      using vanet::PacketHeader;
+      PacketHeader header;
+      header.SetType(PacketHeader::MessageType::DATA_C2V);
+      header.SetBroadcastId(m_experiment->currentBroadcastId);
+      sender->SetHeader(header);
+
+      using vanet::PacketTagData;
+      PacketTagData *pktTag = new PacketTagData();
+      for (uint32_t data : dataToBroadcast[m_experiment->currentBroadcastId])
+	{
+	  pktTag->AddDataIdx(data);
+	}
+      sender->SetPacketTag(pktTag);
+
+      Simulator::ScheduleNow (&UdpSender::Send, sender);
+    }
+}
+
+void
+MaScheduler::OnReceive (uint32_t nodeId, Ptr<const Packet> packet, const Address & srcAddr, const Address & destAddr)
+{
+  uint32_t obuIdx = m_experiment->GetObuIndex(nodeId);
+  if (!m_experiment->vehsStatus[obuIdx]) return;
+
+  LogLine oss (LOG_RECEIVE);
+  if (oss.IsEnabled ())
+    {
+      oss << "sim time:" << Simulator::Now ().GetSeconds () << ", clock: " << (double)(clock()) / CLOCKS_PER_SEC;
+    }
+  if (oss.IsEnabled () && LogIsEnabled (LOG_RECEIVE_ADDRESS))
+    {
+      if (InetSocketAddress::IsMatchingType (srcAddr))
+	{
+	  InetSocketAddress inetSrcAddr = InetSocketAddress::ConvertFrom (srcAddr);
+	  oss << " src: " << inetSrcAddr.GetIpv4 ();
+	}
+      if (InetSocketAddress::IsMatchingType (destAddr))
+	{
+	  InetSocketAddress inetDestAddr = InetSocketAddress::ConvertFrom (destAddr);
+	  oss << " dest: " << inetDestAddr.GetIpv4 ();
+	}
+    }
+
+  using vanet::PacketHeader;
+  PacketHeader recvHeader;
+  Ptr<Packet> pktCopy = packet->Copy();
+  pktCopy->RemoveHeader(recvHeader);
+
+  uint32_t broadcastId = recvHeader.GetBroadcastId();
+
+  oss << " bId: " << broadcastId;
+
+  if (oss.IsEnabled () && LogIsEnabled (LOG_MSG_TYPE))
+    {
+      switch (recvHeader.GetType())
+      {
+	case PacketHeader::MessageType::DATA_C2V:
+	  oss << " MessageType::DATA_C2V ";
+	  break;
+	case PacketHeader::MessageType::DATA_V2F:
+	  oss << " MessageType::DATA_V2F ";
+	  break;
+	case PacketHeader::MessageType::DATA_F2V:
+	  oss << " MessageType::DATA_F2V ";
+	  break;
+	default:
+	  NS_ASSERT_MSG(false, "MessageType must be DATA_C2V, DATA_V2F or DATA_F2V");
+      }
+    }
+
+  if (recvHeader.GetType() == PacketHeader::MessageType::DATA_C2V)
+    {
+      using vanet::PacketTagData;
+      PacketTagData pktTagC2v;
+      pktCopy->RemovePacketTag(pktTagC2v);
+      PacketTagData::IndexSpan datasIdxBroadcast = pktTagC2v.GetDataIdxs();
+      uint32_t broadcastDataNum = datasIdxBroadcast.size();
+
+      if (broadcastDataNum == 0) return;
+
+      mwArray vehCacheMatrix(m_experiment->globalDbSize, m_experiment->globalDbSize, mxDOUBLE_CLASS);
+      for (uint32_t i = 1; i <= m_experiment->globalDbSize; i++)
+	{
+	  for (uint32_t j = 1; j <= m_experiment->globalDbSize; j++)
+	    {
+	      vehCacheMatrix(i, j) = (*mwVehsCachesMatrix)(i, j, obuIdx + 1);
+	    }
+	}
+
+      mwArray mwDatasIdxBroadcast(1, m_experiment->globalDbSize, mxDOUBLE_CLASS);
+      for (uint32_t dataIdx : datasIdxBroadcast)
+	{
+	  mwDatasIdxBroadcast(1, dataIdx + 1) = 1.0;
+	}
+
+//      cout << "vehCacheMatrix[" << obuIdx + 1 << "]:" << endl;
+//      for (uint32_t i = 1; i <= globalDbSize; i++)
+//	{
+//	  for (uint32_t j = 1; j <= globalDbSize; j++)
+//	    {
+//	      cout << " " << vehCacheMatrix(i, j);
+//	    }
+//	  cout << endl;
+//	}
+//      cout << "mwDatasIdxBroadcast:";
+//      for (uint32_t i = 1; i <= globalDbSize; i++)
+//	{
+//	  cout << " " << mwDatasIdxBroadcast(1, i);
+//	}
+//      cout << endl;
+
+
+      mwArray mwResult1(mxUINT32_CLASS);
+      mwArray mwResult2(mxUINT32_CLASS);
+      mwArray mwResult3(mxDOUBLE_CLASS);
+      MADecode(3, mwResult1, mwResult2, mwResult3, vehCacheMatrix, mwDatasIdxBroadcast);
+      uint32_t flag = mwResult1(1, 1);
+      if (flag == 1)
+	{
+	  uint32_t dataToCached = mwResult2(1, 1);
+	  dataToCached -= 1;
+
+	  oss << " dataToCached: " << dataToCached;
+
+	  m_experiment->vehsCaches[obuIdx].insert(dataToCached);
+	  m_experiment->vehsReqs[obuIdx].erase(dataToCached);
+	  m_experiment->RecordStats(obuIdx, dataToCached);
+	}
+
+      for (uint32_t i = 1; i <= m_experiment->globalDbSize; i++)
+	{
+	  for (uint32_t j = 1; j <= m_experiment->globalDbSize; j++)
+	    {
+	      (*mwVehsCachesMatrix)(i, j, obuIdx + 1) = mwResult3(i, j);
+	    }
+	}
+    }
+
+  oss << " DbSize:" << m_experiment->globalDbSize;
+  if (oss.IsEnabled ())
+    {
+      NS_LOG_UNCOND(oss.str());
+    }
+}
+
+} // namespace vanet
+} // namespace ns3
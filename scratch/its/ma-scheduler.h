@@ -0,0 +1,50 @@
+#ifndef SCRATCH_VANET_CS_VFC_MA_SCHEDULER_H_
+#define SCRATCH_VANET_CS_VFC_MA_SCHEDULER_H_
+
+#include <cstdint>
+#include <map>
+#include <set>
+#include <vector>
+
+#include <mclmcrrt.h>
+#include <mclcppclass.h>
+#include <matrix.h>
+#include "libMA.h"
+#include "libMADecode.h"
+#include "broadcast-scheduler.h"
+
+namespace ns3 {
+namespace vanet {
+
+/**
+ * \brief Scheme "ma": packets are chosen and decoded by the MATLAB libraries
+ * libMA and libMADecode, which live as long as the scheduler.
+ */
+class MaScheduler : public BroadcastScheduler
+{
+public:
+  MaScheduler (VanetCsVfcExperiment *experiment);
+  virtual ~MaScheduler ();
+
+  virtual void OnTick (void);
+  virtual void OnReceive (uint32_t nodeId, Ptr<const Packet> packet, const Address & srcAddr, const Address & destAddr);
+  virtual void Save (CheckpointWriter& writer) const;
+  virtual void Load (CheckpointReader& reader);
+  virtual void RebuildFromCaches (void);
+
+private:
+  /**
+   * \brief Set the cache matrix to hold exactly the given data
+   * \param caches the data cached by every vehicle
+   * \return none
+   */
+  void FillCachesMatrix (const std::vector<std::set<uint32_t>>& caches);
+
+  std::map<uint32_t, std::vector<uint32_t>> dataToBroadcast;
+  mwArray *mwVehsCachesMatrix; ///< cache matrix of all vehicles
+};
+
+} // namespace vanet
+} // namespace ns3
+
+#endif /* SCRATCH_VANET_CS_VFC_MA_SCHEDULER_H_ */
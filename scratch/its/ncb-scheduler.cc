@@ -0,0 +1,589 @@
+#include "vanet-cs-vfc.h"
+#include "ncb-scheduler.h"
+#include "checkpoint.h"
+
+namespace ns3 {
+namespace vanet {
+
+NcbScheduler::NcbScheduler (VanetCsVfcExperiment *experiment)
+  : BroadcastScheduler (experiment)
+{
+}
+
+void
+NcbScheduler::OnSubmit (uint32_t obuIdx, uint32_t reqIdx)
+{
+  ReqQueueItem item(obuIdx, reqIdx);
+  requestQueue.push_back(item);
+}
+
+void
+NcbScheduler::FillTickRecord (TickRecord& record) const
+{
+  record.queueLength = requestQueue.size();
+}
+
+void
+NcbScheduler::Save (CheckpointWriter& writer) const
+{
+  writer.Write (requestQueue);
+  writer.Write (reqQueHead);
+  writer.Write (vehsToSatisfy);
+  writer.Write (dataToBroadcast);
+  writer.Write (requestsToMarkGloabal);
+  writer.Write (requestsToMarkWithBid);
+}
+
+void
+NcbScheduler::Load (CheckpointReader& reader)
+{
+  reader.Read (requestQueue);
+  reader.Read (reqQueHead);
+  reader.Read (vehsToSatisfy);
+  reader.Read (dataToBroadcast);
+  reader.Read (requestsToMarkGloabal);
+  reader.Read (requestsToMarkWithBid);
+}
+
+void
+NcbScheduler::OnTick ()
+{
+  if (requestQueue.empty()) return;
+
+//  for (std::string req : requestsToMarkWithBid[currentBroadcastId])
+//    {
+//      requestsToMarkGloabal[req] = false;
+//    }
+//  requestsToMarkWithBid[currentBroadcastId].clear();
+
+  std::list<ReqQueueItem>::iterator iter_list = requestQueue.begin();
+  while (iter_list != requestQueue.end() && requestsToMarkGloabal[iter_list->name])
+    {
+      iter_list++;
+    }
+  if (iter_list == requestQueue.end()) return;
+
+  m_experiment->currentBroadcastId++;
+  reqQueHead[m_experiment->currentBroadcastId] = *iter_list;
+
+  uint32_t maxNum = 0;
+  std::vector<uint32_t> dataSet;
+  dataSet.push_back(reqQueHead[m_experiment->currentBroadcastId].reqDataIndex);
+  dataToBroadcast[m_experiment->currentBroadcastId] = dataSet;
+
+  std::set<uint32_t> vehIdxTraversed;
+
+  std::list<ReqQueueItem>::iterator iter = requestQueue.begin();
+  for (; iter != requestQueue.end(); iter++)
+    {
+      if (vehIdxTraversed.count(iter->vehIndex)) continue;
+      if (requestsToMarkGloabal[iter->name]) continue;
+
+      if (reqQueHead[m_experiment->currentBroadcastId].reqDataIndex == iter->reqDataIndex)
+	{
+	  maxNum += 1;
+	  vehsToSatisfy[m_experiment->currentBroadcastId].insert(iter->vehIndex);
+	  requestsToMarkWithBid[m_experiment->currentBroadcastId].insert(iter->name);
+
+	  vehIdxTraversed.insert(iter->vehIndex);
+	}
+    }
+
+  std::set<uint32_t> caches;
+  if (!m_experiment->vehIdx2FogIdxMap.count(reqQueHead[m_experiment->currentBroadcastId].vehIndex))
+    {
+      caches = m_experiment->vehsCaches[reqQueHead[m_experiment->currentBroadcastId].vehIndex];
+    }
+  else
+    {
+      caches = m_experiment->fogsCaches[m_experiment->vehIdx2FogIdxMap.at(reqQueHead[m_experiment->currentBroadcastId].vehIndex)];
+    }
+
+  uint32_t data2ToBroadcast;
+  bool flag = false;
+  for (uint32_t cache : caches)
+    {
+      uint32_t maxNumEncode = 0;
+      std::set<uint32_t> vehsToSatisfyEncode;
+      std::set<std::string> requestsToMarkTmpEncode;
+      std::set<uint32_t> vehIdxTraversedEncode;
+
+      iter = requestQueue.begin();
+      for (; iter != requestQueue.end(); iter++)
+	{
+	  if (vehIdxTraversedEncode.count(iter->vehIndex)) continue;
+	  if (requestsToMarkGloabal[iter->name]) continue;
+
+	  std::set<uint32_t> caches2;
+	  if (!m_experiment->vehIdx2FogIdxMap.count(iter->vehIndex))
+	    {
+	      caches2 = m_experiment->vehsCaches[iter->vehIndex];
+	    }
+	  else
+	    {
+	      caches2 = m_experiment->fogsCaches[m_experiment->vehIdx2FogIdxMap.at(iter->vehIndex)];
+	    }
+	  if (reqQueHead[m_experiment->currentBroadcastId].reqDataIndex == iter->reqDataIndex && caches2.count(cache))
+	    {
+	      maxNumEncode += 1;
+	      vehsToSatisfyEncode.insert(iter->vehIndex);
+	      requestsToMarkTmpEncode.insert(iter->name);
+
+	      vehIdxTraversedEncode.insert(iter->vehIndex);
+	    }
+	  else if (cache == iter->reqDataIndex && caches2.count(reqQueHead[m_experiment->currentBroadcastId].reqDataIndex))
+	    {
+	      maxNumEncode += 1;
+	      vehsToSatisfyEncode.insert(iter->vehIndex);
+	      requestsToMarkTmpEncode.insert(iter->name);
+
+	      vehIdxTraversedEncode.insert(iter->vehIndex);
+	    }
+	}
+      if (maxNumEncode > maxNum)
+	{
+	  flag = true;
+//	  cout << Now().GetSeconds() << ", maxNumEncode:" << maxNumEncode << ", maxNum:" << maxNum << endl;
+	  maxNum = maxNumEncode;
+	  vehsToSatisfy[m_experiment->currentBroadcastId] = vehsToSatisfyEncode;
+	  requestsToMarkWithBid[m_experiment->currentBroadcastId] = requestsToMarkTmpEncode;
+	  data2ToBroadcast = cache;
+	}
+    }
+
+  for (std::string name : requestsToMarkWithBid[m_experiment->currentBroadcastId])
+    {
+      requestsToMarkGloabal[name] = true;
+    }
+  if (flag)
+    {
+      dataToBroadcast[m_experiment->currentBroadcastId].push_back(data2ToBroadcast);
+    }
+
+  if (LogIsEnabled (LOG_BROADCAST))
+    {
+      cout << Now().GetSeconds() << ", maxNum:" << maxNum;
+      cout << ", dataToBroadcast" << "[" << m_experiment->currentBroadcastId << "]" << ":";
+      for (uint32_t data : dataToBroadcast[m_experiment->currentBroadcastId])
+	{
+	  cout << " " << data;
+	}
+//      cout << ", vehsToSatisfy";
+//      for (uint32_t veh : vehsToSatisfy)
+//	{
+//	  cout << " " << veh;
+//	}
+      cout << endl;
+      std::cout << "DbSize:" << m_experiment->globalDbSize << std::endl;
+    }
+
+  m_experiment->m_requestStats.IncBroadcastPkts();
+
+  Ptr<UdpSender> sender = CreateObject<UdpSender>();
+  sender->SetNode(m_experiment->m_remoteHost);
+  sender->SetRemote(Ipv4Address ("10.2.255.255"), m_experiment->m_dlPort);
+  sender->SetDataSize(Packet_Size);
+  sender->Start();
+  using vanet::PacketHeader;
+  PacketHeader header;
+  header.SetType(PacketHeader::MessageType::DATA_C2V);
+  header.SetBroadcastId(m_experiment->currentBroadcastId);
+  sender->SetHeader(header);
+
+  using vanet::PacketTagData;
+  PacketTagData *pktTag = new PacketTagData();
+  for (uint32_t data : dataToBroadcast[m_experiment->currentBroadcastId])
+    {
+      pktTag->AddDataIdx(data);
+    }
+  sender->SetPacketTag(pktTag);
+
+  Simulator::ScheduleNow (&UdpSender::Send, sender);
+
+//  requestQueue.pop_front();
+}
+
+void
+NcbScheduler::OnReceive (uint32_t nodeId, Ptr<const Packet> packet, const Address & srcAddr, const Address & destAddr)
+{
+  LogLine oss (LOG_RECEIVE);
+  if (oss.IsEnabled ())
+    {
+      oss << "sim time:" << Simulator::Now ().GetSeconds () << ", clock: " << (double)(clock()) / CLOCKS_PER_SEC;
+    }
+  if (oss.IsEnabled () && LogIsEnabled (LOG_RECEIVE_ADDRESS))
+    {
+      if (InetSocketAddress::IsMatchingType (srcAddr))
+	{
+	  InetSocketAddress inetSrcAddr = InetSocketAddress::ConvertFrom (srcAddr);
+	  oss << " src: " << inetSrcAddr.GetIpv4 ();
+	}
+      if (InetSocketAddress::IsMatchingType (destAddr))
+	{
+	  InetSocketAddress inetDestAddr = InetSocketAddress::ConvertFrom (destAddr);
+	  oss << " dest: " << inetDestAddr.GetIpv4 ();
+	}
+    }
+
+  using vanet::PacketHeader;
+  PacketHeader recvHeader;
+  Ptr<Packet> pktCopy = packet->Copy();
+  pktCopy->RemoveHeader(recvHeader);
+
+  uint32_t broadcastId = recvHeader.GetBroadcastId();
+
+  oss << " bId: " << broadcastId;
+
+  if (oss.IsEnabled () && LogIsEnabled (LOG_MSG_TYPE))
+    {
+      switch (recvHeader.GetType())
+      {
+	case PacketHeader::MessageType::DATA_C2V:
+	  oss << " MessageType::DATA_C2V ";
+	  break;
+	case PacketHeader::MessageType::DATA_V2F:
+	  oss << " MessageType::DATA_V2F ";
+	  break;
+	case PacketHeader::MessageType::DATA_F2V:
+	  oss << " MessageType::DATA_F2V ";
+	  break;
+	default:
+	  NS_ASSERT_MSG(false, "MessageType must be DATA_C2V, DATA_V2F or DATA_F2V");
+      }
+    }
+
+  if (recvHeader.GetType() == PacketHeader::MessageType::DATA_C2V)
+    {
+      uint32_t obuIdx = m_experiment->GetObuIndex(nodeId);
+
+      using vanet::PacketTagData;
+      PacketTagData pktTagC2v;
+      pktCopy->RemovePacketTag(pktTagC2v);
+      PacketTagData::IndexSpan datasIdxBroadcast = pktTagC2v.GetDataIdxs();
+      uint32_t broadcastDataNum = datasIdxBroadcast.size();
+
+      if (broadcastDataNum == 0) return;
+
+      // Judging whether the broadcasted data is encoded or not
+      bool isEncoded = broadcastDataNum == 1 ? false : true;
+      oss << " Encoded: " << isEncoded;
+      if (!isEncoded)
+	{
+	  uint32_t dataIdx = datasIdxBroadcast[0];
+	  if (vehsToSatisfy[broadcastId].count(obuIdx))
+	    {
+	      if (m_experiment->vehsReqs[obuIdx].count(dataIdx))
+		{
+		  m_experiment->vehsCaches[obuIdx].insert(dataIdx);
+		  m_experiment->vehsReqs[obuIdx].erase(dataIdx);
+		  m_experiment->RecordStats(obuIdx, dataIdx);
+
+		  ReqQueueItem item(obuIdx, dataIdx);
+		  requestQueue.erase(std::find(requestQueue.begin(), requestQueue.end(), item));
+
+		  requestsToMarkWithBid[broadcastId].erase(item.name);
+		}
+	    }
+	}
+      else
+	{
+	  if (vehsToSatisfy[broadcastId].count(obuIdx))
+	    {
+	      uint32_t dataIdx1 = datasIdxBroadcast[0];
+	      uint32_t dataIdx2 = datasIdxBroadcast[1];
+	      if (broadcastId == Test_Bid)
+		{
+		  cout << "bid:" << broadcastId << ", obuid:" << obuIdx << ", data1:" << dataIdx1 << ", data2:" << dataIdx2 << endl;
+		}
+
+	      std::ostringstream oss1;
+	      oss1 << obuIdx << "-" << dataIdx1;
+
+	      std::ostringstream oss2;
+	      oss2 << obuIdx << "-" << dataIdx2;
+
+	      if (requestsToMarkWithBid[broadcastId].count(oss1.str()))
+		{
+		  if (m_experiment->vehsReqs[obuIdx].count(dataIdx1) && m_experiment->vehsCaches[obuIdx].count(dataIdx2))
+		    {
+		      m_experiment->vehsCaches[obuIdx].insert(dataIdx1);
+		      m_experiment->vehsReqs[obuIdx].erase(dataIdx1);
+		      m_experiment->RecordStats(obuIdx, dataIdx1);
+
+		      ReqQueueItem item(obuIdx, dataIdx1);
+		      requestQueue.erase(std::find(requestQueue.begin(), requestQueue.end(), item));
+
+		      requestsToMarkWithBid[broadcastId].erase(item.name);
+
+//		      if (broadcastId == Test_Bid)
+//			{
+//			  cout << 1 << endl;
+//			}
+		    }
+		  else if (m_experiment->vehsReqs[obuIdx].count(dataIdx1) && m_experiment->vehsCaches[obuIdx].count(dataIdx2) == 0)
+		    {
+//		      if (broadcastId == Test_Bid)
+//			{
+//			  cout << 3;
+//			}
+		      bool flag = true;
+		      if (m_experiment->vehIdx2FogIdxMap.count(obuIdx))
+			{
+			  uint32_t fogIdx = m_experiment->vehIdx2FogIdxMap.at(obuIdx);
+			  if (m_experiment->fogsCaches[fogIdx].count(dataIdx2))
+			    {
+			      for (uint32_t fogVehIdx : m_experiment->fogCluster[fogIdx])
+				{
+				  if (m_experiment->vehsCaches[fogVehIdx].count(dataIdx2))
+				    {
+//				      if (broadcastId == Test_Bid)
+//					{
+//					  cout << " true" << endl;
+//					}
+				      Ptr<UdpSender> sender = CreateObject<UdpSender>();
+				      sender->SetNode(m_experiment->m_obuNodes.Get(fogVehIdx));
+				      sender->SetRemote(m_experiment->m_rsu80211pInterfaces.GetAddress(fogIdx), m_experiment->m_v2IPort);
+				      sender->SetDataSize(Packet_Size);
+				      sender->Start();
+				      using vanet::PacketHeader;
+				      PacketHeader header;
+				      header.SetType(PacketHeader::MessageType::DATA_V2F);
+				      header.SetBroadcastId(broadcastId);
+				      sender->SetHeader(header);
+
+				      using vanet::PacketTagData;
+				      PacketTagData *pktTagV2f = new PacketTagData();
+				      pktTagV2f->SetNextActionType(PacketTagData::NextActionType::F2V);
+				      pktTagV2f->AddDataIdx(dataIdx2);
+				      sender->SetPacketTag(pktTagV2f);
+
+				      Simulator::ScheduleNow (&UdpSender::Send, sender);
+				      break;
+				    }
+				}
+			    }
+			  else
+			    {
+			      flag = false;
+			    }
+			}
+		      else
+			{
+			  flag = false;
+			}
+		      if (!flag)
+			{
+			  std::ostringstream oss;
+			  oss << obuIdx << "-" << dataIdx1;
+			  requestsToMarkGloabal[oss.str()] = false;
+			}
+		    }
+//		  else
+//		    {
+//		      if (broadcastId == Test_Bid)
+//			{
+//			  cout << 6 << endl;
+//			}
+//		    }
+		}
+	      else if (requestsToMarkWithBid[broadcastId].count(oss2.str()))
+		{
+		  if (m_experiment->vehsReqs[obuIdx].count(dataIdx2) && m_experiment->vehsCaches[obuIdx].count(dataIdx1))
+		    {
+		      m_experiment->vehsCaches[obuIdx].insert(dataIdx2);
+		      m_experiment->vehsReqs[obuIdx].erase(dataIdx2);
+		      m_experiment->RecordStats(obuIdx, dataIdx2);
+
+		      ReqQueueItem item(obuIdx, dataIdx2);
+		      requestQueue.erase(std::find(requestQueue.begin(), requestQueue.end(), item));
+
+		      requestsToMarkWithBid[broadcastId].erase(item.name);
+
+//		      if (broadcastId == Test_Bid)
+//			{
+//			  cout << 2 << endl;
+//			}
+		    }
+		  else if (m_experiment->vehsReqs[obuIdx].count(dataIdx2) && m_experiment->vehsCaches[obuIdx].count(dataIdx1) == 0)
+		    {
+//		      if (broadcastId == Test_Bid)
+//			{
+//			  cout << 4;
+//			}
+		      bool flag = true;
+		      if (m_experiment->vehIdx2FogIdxMap.count(obuIdx))
+			{
+			  uint32_t fogIdx = m_experiment->vehIdx2FogIdxMap.at(obuIdx);
+			  if (m_experiment->fogsCaches[fogIdx].count(dataIdx1))
+			    {
+			      for (uint32_t fogVehIdx : m_experiment->fogCluster[fogIdx])
+				{
+				  if (m_experiment->vehsCaches[fogVehIdx].count(dataIdx1))
+				    {
+//				      if (broadcastId == Test_Bid)
+//					{
+//					  cout << " true" << endl;
+//					}
+				      Ptr<UdpSender> sender = CreateObject<UdpSender>();
+				      sender->SetNode(m_experiment->m_obuNodes.Get(fogVehIdx));
+				      sender->SetRemote(m_experiment->m_rsu80211pInterfaces.GetAddress(fogIdx), m_experiment->m_v2IPort);
+				      sender->SetDataSize(Packet_Size);
+				      sender->Start();
+				      using vanet::PacketHeader;
+				      PacketHeader header;
+				      header.SetType(PacketHeader::MessageType::DATA_V2F);
+				      header.SetBroadcastId(broadcastId);
+				      sender->SetHeader(header);
+
+				      using vanet::PacketTagData;
+				      PacketTagData *pktTagV2f = new PacketTagData();
+				      pktTagV2f->SetNextActionType(PacketTagData::NextActionType::F2V);
+				      pktTagV2f->AddDataIdx(dataIdx1);
+				      sender->SetPacketTag(pktTagV2f);
+
+				      Simulator::ScheduleNow (&UdpSender::Send, sender);
+				      break;
+				    }
+				}
+			    }
+			  else
+			    {
+			      flag = false;
+			    }
+			}
+		      else
+			{
+			  flag = false;
+			}
+		      if (!flag)
+			{
+			  std::ostringstream oss;
+			  oss << obuIdx << "-" << dataIdx2;
+			  requestsToMarkGloabal[oss.str()] = false;
+			}
+		    }
+//		  else
+//		    {
+//		      if (broadcastId == Test_Bid)
+//			{
+//			  cout << 7 << endl;
+//			}
+//		    }
+		}
+//	      else
+//		{
+//		  if (broadcastId == Test_Bid)
+//		    {
+//		      cout << 5 << endl;
+//		    }
+//		}
+	    }
+	}
+
+//      dataToBroadcast.erase(broadcastId);
+    }
+  else if (recvHeader.GetType() == PacketHeader::MessageType::DATA_V2F)
+    {
+      using vanet::PacketTagData;
+      PacketTagData pktTagV2f;
+      pktCopy->RemovePacketTag(pktTagV2f);
+
+      Ptr<UdpSender> sender = CreateObject<UdpSender>();
+      sender->SetNode(NodeList::GetNode(nodeId));
+      sender->SetRemote(Ipv4Address ("10.3.255.255"), m_experiment->m_i2VPort);
+      sender->SetDataSize(Packet_Size);
+      sender->Start();
+      using vanet::PacketHeader;
+      PacketHeader header;
+      header.SetType(PacketHeader::MessageType::DATA_F2V);
+      header.SetBroadcastId(broadcastId);
+      sender->SetHeader(header);
+
+      using vanet::PacketTagData;
+      PacketTagData *pktTagF2v = new PacketTagData();
+      pktTagF2v->SetNextActionType(PacketTagData::NextActionType::NOT_SET);
+      pktTagF2v->SetFogId(nodeId);
+      pktTagF2v->SetDataIdxs(pktTagV2f.GetDataIdxs());
+      sender->SetPacketTag(pktTagF2v);
+
+      Simulator::ScheduleNow (&UdpSender::Send, sender);
+    }
+  else if (recvHeader.GetType() == PacketHeader::MessageType::DATA_F2V)
+    {
+      using vanet::PacketTagData;
+      PacketTagData pktTagF2v;
+      pktCopy->RemovePacketTag(pktTagF2v);
+
+      uint32_t fogId = pktTagF2v.GetFogId();
+      Ptr<Node> rsu = NodeList::GetNode(fogId);
+      Ptr<MobilityModel> rsuMobility = rsu->GetObject<MobilityModel> ();
+      Vector pos_rsu = rsuMobility->GetPosition ();
+
+      Ptr<Node> obu = NodeList::GetNode(nodeId);
+      Ptr<MobilityModel> obuMobility = obu->GetObject<MobilityModel> ();
+      Vector pos_obu = obuMobility->GetPosition ();
+
+      if (CalculateDistance (pos_obu, pos_rsu) > Device_Transmission_Range )
+	{
+	  return;
+	}
+
+      PacketTagData::IndexSpan datasIdx = pktTagF2v.GetDataIdxs();
+      uint32_t obuIdx = m_experiment->GetObuIndex(nodeId);
+      std::vector<uint32_t> dataBroadcast =  dataToBroadcast[broadcastId];
+
+      if (vehsToSatisfy[broadcastId].count(obuIdx))
+	{
+	  uint32_t dataIdx = datasIdx[0];
+
+
+	  if (dataBroadcast[1] == dataIdx)
+	    {
+	      std::ostringstream oss;
+	      oss << obuIdx << "-" << dataBroadcast[0];
+	      if (requestsToMarkWithBid[broadcastId].count(oss.str()))
+		{
+		  if (m_experiment->vehsReqs[obuIdx].count(dataBroadcast[0]))
+		    {
+		      m_experiment->vehsCaches[obuIdx].insert(dataBroadcast[0]);
+		      m_experiment->vehsReqs[obuIdx].erase(dataBroadcast[0]);
+		      m_experiment->RecordStats(obuIdx, dataBroadcast[0]);
+
+		      ReqQueueItem item(obuIdx, dataBroadcast[0]);
+		      requestQueue.erase(std::find(requestQueue.begin(), requestQueue.end(), item));
+
+		      requestsToMarkWithBid[broadcastId].erase(item.name);
+		    }
+		}
+	    }
+	  else if (dataBroadcast[0] == dataIdx)
+	    {
+	      std::ostringstream oss;
+	      oss << obuIdx << "-" << dataBroadcast[1];
+	      if (requestsToMarkWithBid[broadcastId].count(oss.str()))
+		{
+		  if (m_experiment->vehsReqs[obuIdx].count(dataBroadcast[1]))
+		    {
+		      m_experiment->vehsCaches[obuIdx].insert(dataBroadcast[1]);
+		      m_experiment->vehsReqs[obuIdx].erase(dataBroadcast[1]);
+		      m_experiment->RecordStats(obuIdx, dataBroadcast[1]);
+
+		      ReqQueueItem item(obuIdx, dataBroadcast[1]);
+		      requestQueue.erase(std::find(requestQueue.begin(), requestQueue.end(), item));
+
+		      requestsToMarkWithBid[broadcastId].erase(item.name);
+		    }
+		}
+	    }
+	}
+    }
+
+  oss << " DbSize:" << m_experiment->globalDbSize;
+  if (oss.IsEnabled ())
+    {
+      NS_LOG_UNCOND(oss.str());
+    }
+}
+
+} // namespace vanet
+} // namespace ns3
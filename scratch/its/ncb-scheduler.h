@@ -0,0 +1,45 @@
+#ifndef SCRATCH_VANET_CS_VFC_NCB_SCHEDULER_H_
+#define SCRATCH_VANET_CS_VFC_NCB_SCHEDULER_H_
+
+#include <cstdint>
+#include <list>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "custom-type.h"
+#include "broadcast-scheduler.h"
+
+namespace ns3 {
+namespace vanet {
+
+/**
+ * \brief Scheme "ncb": broadcast the most rewarding (possibly coded) packet
+ * for the head of the request queue.
+ */
+class NcbScheduler : public BroadcastScheduler
+{
+public:
+  NcbScheduler (VanetCsVfcExperiment *experiment);
+
+  virtual void OnTick (void);
+  virtual void OnReceive (uint32_t nodeId, Ptr<const Packet> packet, const Address & srcAddr, const Address & destAddr);
+  virtual void OnSubmit (uint32_t obuIdx, uint32_t reqIdx);
+  virtual void FillTickRecord (TickRecord& record) const;
+  virtual void Save (CheckpointWriter& writer) const;
+  virtual void Load (CheckpointReader& reader);
+
+private:
+  std::list<ReqQueueItem> requestQueue;
+  std::map<uint32_t, ReqQueueItem> reqQueHead;
+  std::map<uint32_t, std::set<uint32_t>> vehsToSatisfy;
+  std::map<uint32_t, std::vector<uint32_t>> dataToBroadcast;
+  std::map<std::string, bool> requestsToMarkGloabal;
+  std::map<uint32_t, std::set<std::string>> requestsToMarkWithBid;
+};
+
+} // namespace vanet
+} // namespace ns3
+
+#endif /* SCRATCH_VANET_CS_VFC_NCB_SCHEDULER_H_ */
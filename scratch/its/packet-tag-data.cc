@@ -0,0 +1,284 @@
+#include "ns3/abort.h"
+#include "packet-tag-data.h"
+
+namespace ns3 {
+namespace vanet {
+
+void
+PacketTagData::IndexArray::Clear (void)
+{
+  m_n = 0;
+  m_heap.clear ();
+}
+
+void
+PacketTagData::IndexArray::Add (uint16_t idx)
+{
+  if (m_n < INLINE_IDXS)
+    {
+      m_inline[m_n++] = idx;
+      return;
+    }
+  if (m_n == INLINE_IDXS)
+    {
+      m_heap.assign (m_inline, m_inline + INLINE_IDXS);
+    }
+  m_heap.push_back (idx);
+  m_n++;
+}
+
+PacketTagData::IndexSpan
+PacketTagData::IndexArray::GetSpan (void) const
+{
+  const uint16_t *begin = m_n <= INLINE_IDXS ? m_inline : m_heap.data ();
+  return IndexSpan (begin, begin + m_n);
+}
+
+PacketTagData::PacketTagData (void)
+  : m_currentEdgeType (0),
+    m_nextActionType (0),
+    m_fogId (0)
+{
+}
+
+void
+PacketTagData::SetCurrentEdgeType (EdgeType type)
+{
+  switch (type)
+    {
+    case EdgeType::NOT_SET:
+    m_currentEdgeType = 0;
+      break;
+    case EdgeType::CONDITION_1:
+    m_currentEdgeType = 1;
+      break;
+    case EdgeType::CONDITION_2:
+    m_currentEdgeType = 2;
+      break;
+    case EdgeType::CONDITION_3:
+    m_currentEdgeType = 3;
+      break;
+    default:
+      NS_FATAL_ERROR ("Unknown CurrentEdge-Type: " << static_cast<uint16_t> (type));
+      break;
+    }
+}
+EdgeType
+PacketTagData::GetCurrentEdgeType (void) const
+{
+  EdgeType ret;
+  switch (m_currentEdgeType)
+    {
+    case 0:
+      ret = EdgeType::NOT_SET;
+      break;
+    case 1:
+      ret = EdgeType::CONDITION_1;
+      break;
+    case 2:
+      ret = EdgeType::CONDITION_2;
+      break;
+    case 3:
+      ret = EdgeType::CONDITION_3;
+      break;
+    default:
+      NS_FATAL_ERROR ("Unknown CurrentEdge-Type: " << m_currentEdgeType);
+      break;
+    }
+  return ret;
+}
+
+void
+PacketTagData::SetNextActionType (PacketTagData::NextActionType type)
+{
+  switch (type)
+    {
+    case NextActionType::NOT_SET:
+      m_nextActionType = 0;
+      break;
+    case NextActionType::F2F:
+      m_nextActionType = 1;
+      break;
+    case NextActionType::F2V:
+      m_nextActionType = 2;
+      break;
+    case NextActionType::V2F:
+      m_nextActionType = 3;
+      break;
+    default:
+      NS_FATAL_ERROR ("Unknown NextAction-Type: " << static_cast<uint16_t> (type));
+      break;
+    }
+}
+PacketTagData::NextActionType
+PacketTagData::GetNextActionType (void) const
+{
+  NextActionType ret;
+  switch (m_nextActionType)
+    {
+    case 0:
+      ret = NextActionType::NOT_SET;
+      break;
+    case 1:
+      ret = NextActionType::F2F;
+      break;
+    case 2:
+      ret = NextActionType::F2V;
+      break;
+    case 3:
+      ret = NextActionType::V2F;
+      break;
+    default:
+      NS_FATAL_ERROR ("Unknown NextAction-Type: " << m_nextActionType);
+      break;
+    }
+  return ret;
+}
+
+void
+PacketTagData::SetFogId (uint32_t fogId)
+{
+  m_fogId = fogId;
+}
+
+uint32_t
+PacketTagData::GetFogId (void) const
+{
+  return m_fogId;
+}
+
+void
+PacketTagData::AddRsuWaitingServedIdx (uint32_t rsuIdx)
+{
+  NS_ABORT_MSG_IF (m_rsuWaitingServedIdxs.GetN () >= MAX_IDXS, "too many rsu indices in tag");
+  NS_ABORT_MSG_IF (rsuIdx > UINT16_MAX, "rsu index " << rsuIdx << " does not fit in tag");
+  m_rsuWaitingServedIdxs.Add (rsuIdx);
+}
+
+void
+PacketTagData::SetRsuWaitingServedIdxs (IndexSpan rsuWaitingServedIdxs)
+{
+  m_rsuWaitingServedIdxs.Clear ();
+  for (uint32_t rsuIdx : rsuWaitingServedIdxs)
+    {
+      AddRsuWaitingServedIdx (rsuIdx);
+    }
+}
+
+PacketTagData::IndexSpan
+PacketTagData::GetRsuWaitingServedIdxs (void) const
+{
+  return m_rsuWaitingServedIdxs.GetSpan ();
+}
+
+void
+PacketTagData::AddDataIdx (uint32_t dataIdx)
+{
+  NS_ABORT_MSG_IF (m_dataIdxs.GetN () >= MAX_IDXS, "too many data indices in tag");
+  NS_ABORT_MSG_IF (dataIdx > UINT16_MAX, "data index " << dataIdx << " does not fit in tag");
+  m_dataIdxs.Add (dataIdx);
+}
+
+void
+PacketTagData::SetDataIdxs (IndexSpan dataIdxs)
+{
+  m_dataIdxs.Clear ();
+  for (uint32_t dataIdx : dataIdxs)
+    {
+      AddDataIdx (dataIdx);
+    }
+}
+
+PacketTagData::IndexSpan
+PacketTagData::GetDataIdxs (void) const
+{
+  return m_dataIdxs.GetSpan ();
+}
+
+NS_OBJECT_ENSURE_REGISTERED (PacketTagData);
+
+TypeId
+PacketTagData::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::PacketTagData")
+    .SetParent<Tag> ()
+    .AddConstructor<PacketTagData> ()
+  ;
+  return tid;
+}
+TypeId
+PacketTagData::GetInstanceTypeId (void) const
+{
+  return GetTypeId ();
+}
+uint32_t
+PacketTagData::GetSerializedSize (void) const
+{
+  return sizeof (uint8_t)
+      + sizeof (uint8_t)
+      + sizeof (uint32_t)
+      + sizeof (uint16_t) + sizeof (uint16_t) * m_rsuWaitingServedIdxs.GetN ()
+      + sizeof (uint16_t) + sizeof (uint16_t) * m_dataIdxs.GetN ();
+}
+void
+PacketTagData::Serialize (TagBuffer i) const
+{
+  i.WriteU8(m_currentEdgeType);
+  i.WriteU8(m_nextActionType);
+  i.WriteU32(m_fogId);
+
+  i.WriteU16(m_rsuWaitingServedIdxs.GetN ());
+  for (uint32_t rsuIdx : GetRsuWaitingServedIdxs ())
+    {
+      i.WriteU16 (rsuIdx);
+    }
+
+  i.WriteU16(m_dataIdxs.GetN ());
+  for (uint32_t dataIdx : GetDataIdxs ())
+    {
+      i.WriteU16 (dataIdx);
+    }
+}
+void
+PacketTagData::Deserialize (TagBuffer i)
+{
+  m_currentEdgeType = i.ReadU8();
+  m_nextActionType = i.ReadU8();
+  m_fogId = i.ReadU32();
+
+  uint32_t nRsuWaitingServedIdxs = i.ReadU16();
+  NS_ABORT_MSG_IF (nRsuWaitingServedIdxs > MAX_IDXS, "corrupt tag: " << nRsuWaitingServedIdxs << " rsu indices");
+  m_rsuWaitingServedIdxs.Clear ();
+  for (uint32_t j = 0; j < nRsuWaitingServedIdxs; j++)
+    {
+      m_rsuWaitingServedIdxs.Add (i.ReadU16 ());
+    }
+
+  uint32_t nDataIdxs = i.ReadU16();
+  NS_ABORT_MSG_IF (nDataIdxs > MAX_IDXS, "corrupt tag: " << nDataIdxs << " data indices");
+  m_dataIdxs.Clear ();
+  for (uint32_t j = 0; j < nDataIdxs; j++)
+    {
+      m_dataIdxs.Add (i.ReadU16 ());
+    }
+}
+void
+PacketTagData::Print (std::ostream &os) const
+{
+  os << "currentEdgeType=" << static_cast<uint16_t> (m_currentEdgeType);
+  os << ", nextActionType=" << static_cast<uint16_t> (m_nextActionType);
+  os << ", fogId=" << m_fogId;
+  os << ", rsuWaitingServedIdxs=";
+  for (uint32_t rsuIdx : GetRsuWaitingServedIdxs ())
+    {
+      os << " " << rsuIdx;
+    }
+  os << ", dataIdxs=";
+  for (uint32_t dataIdx : GetDataIdxs ())
+    {
+      os << " " << dataIdx;
+    }
+}
+
+} // namespace vanet
+} // namespace ns3
@@ -0,0 +1,109 @@
+#ifndef SCRATCH_VANET_CS_VFC_PACKET_TAG_DATA_H_
+#define SCRATCH_VANET_CS_VFC_PACKET_TAG_DATA_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "custom-type.h"
+#include "ns3/tag.h"
+
+namespace ns3 {
+namespace vanet {
+
+/**
+ * \brief Tag carried by every data packet of a broadcast (C2V, V2F, F2F and F2V hops).
+ *
+ * Indices are kept in small inline arrays, so adding, copying and removing
+ * the tag of a usual hop never allocates. Larger broadcasts (MA result rows,
+ * whole cliques) spill to the heap. Unused fields of a hop are simply left
+ * empty.
+ */
+class PacketTagData : public Tag
+{
+public:
+
+  static const uint32_t INLINE_IDXS = 16;	///< indices of an array kept in the tag itself
+  static const uint32_t MAX_IDXS = UINT16_MAX;	///< upper bound of the indices of an array
+
+  enum class NextActionType:uint8_t
+  {
+    NOT_SET	= 0,
+    F2F		= 1,
+    F2V		= 2,
+    V2F		= 3
+  };
+
+  /**
+   * \brief read-only view of an index array of the tag
+   */
+  class IndexSpan
+  {
+  public:
+    IndexSpan (const uint16_t *begin, const uint16_t *end) : m_begin (begin), m_end (end) {}
+    const uint16_t * begin (void) const { return m_begin; }
+    const uint16_t * end (void) const { return m_end; }
+    uint32_t size (void) const { return m_end - m_begin; }
+    bool empty (void) const { return m_begin == m_end; }
+    uint32_t operator[] (uint32_t i) const { return m_begin[i]; }
+
+  private:
+    const uint16_t *m_begin;
+    const uint16_t *m_end;
+  };
+
+  PacketTagData (void);
+
+  void SetCurrentEdgeType (EdgeType type);
+  EdgeType GetCurrentEdgeType (void) const;
+
+  void SetNextActionType (PacketTagData::NextActionType type);
+  PacketTagData::NextActionType GetNextActionType (void) const;
+
+  void SetFogId (uint32_t fogId);
+  uint32_t GetFogId (void) const;
+
+  void AddRsuWaitingServedIdx (uint32_t rsuIdx);
+  void SetRsuWaitingServedIdxs (IndexSpan rsuWaitingServedIdxs);
+  IndexSpan GetRsuWaitingServedIdxs (void) const;
+
+  void AddDataIdx (uint32_t dataIdx);
+  void SetDataIdxs (IndexSpan dataIdxs);
+  IndexSpan GetDataIdxs (void) const;
+
+  static TypeId GetTypeId (void);
+  virtual TypeId GetInstanceTypeId (void) const;
+  virtual uint32_t GetSerializedSize (void) const;
+  virtual void Serialize (TagBuffer i) const;
+  virtual void Deserialize (TagBuffer i);
+  virtual void Print (std::ostream &os) const;
+
+private:
+  /**
+   * \brief index array, inline up to INLINE_IDXS and on the heap past it
+   */
+  class IndexArray
+  {
+  public:
+    IndexArray (void) : m_n (0) {}
+    void Clear (void);
+    void Add (uint16_t idx);
+    uint32_t GetN (void) const { return m_n; }
+    IndexSpan GetSpan (void) const;
+
+  private:
+    uint32_t m_n;
+    uint16_t m_inline[INLINE_IDXS];
+    std::vector<uint16_t> m_heap; // all the indices, once there are more than INLINE_IDXS
+  };
+
+  uint8_t m_currentEdgeType;
+  uint8_t m_nextActionType; // next action type
+  uint32_t m_fogId;
+  IndexArray m_rsuWaitingServedIdxs; // index of rsu waiting to be served
+  IndexArray m_dataIdxs; // data index to be send
+};
+
+} // namespace vanet
+} // namespace ns3
+
+#endif /* SCRATCH_VANET_CS_VFC_PACKET_TAG_DATA_H_ */
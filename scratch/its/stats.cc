@@ -0,0 +1,517 @@
+/*
+ * stats.cc
+ *
+ *  Created on: Aug 17, 2018
+ *      Author: haha
+ */
+
+#include "stats.h"
+#include "checkpoint.h"
+
+// DelayHistogram
+DelayHistogram::DelayHistogram ()
+  : m_count (0),
+    m_max (0),
+    m_buckets ()
+{
+}
+
+uint32_t
+DelayHistogram::GetBucketIndex (uint64_t value)
+{
+  if (value < SUB_BUCKETS)
+    {
+      return value;
+    }
+  uint32_t shift = (63 - __builtin_clzll (value)) - SUB_BUCKET_BITS;
+  return (shift + 1) * SUB_BUCKETS + ((value >> shift) - SUB_BUCKETS);
+}
+
+uint64_t
+DelayHistogram::GetBucketUpperBound (uint32_t index)
+{
+  if (index < SUB_BUCKETS)
+    {
+      return index;
+    }
+  uint32_t shift = index / SUB_BUCKETS - 1;
+  uint64_t sub = index % SUB_BUCKETS + SUB_BUCKETS;
+  return ((sub + 1) << shift) - 1;
+}
+
+void
+DelayHistogram::Record (uint64_t value)
+{
+  m_buckets[GetBucketIndex (value)]++;
+  m_count++;
+  if (value > m_max)
+    {
+      m_max = value;
+    }
+}
+
+void
+DelayHistogram::Merge (const DelayHistogram& other)
+{
+  for (uint32_t i = 0; i < N_BUCKETS; i++)
+    {
+      m_buckets[i] += other.m_buckets[i];
+    }
+  m_count += other.m_count;
+  if (other.m_max > m_max)
+    {
+      m_max = other.m_max;
+    }
+}
+
+uint64_t
+DelayHistogram::GetCount () const
+{
+  return m_count;
+}
+
+uint64_t
+DelayHistogram::GetMax () const
+{
+  return m_max;
+}
+
+uint64_t
+DelayHistogram::GetPercentile (double percentile) const
+{
+  if (m_count == 0)
+    {
+      return 0;
+    }
+  uint64_t rank = std::ceil (percentile / 100.0 * m_count);
+  if (rank < 1)
+    {
+      rank = 1;
+    }
+  uint64_t seen = 0;
+  for (uint32_t i = 0; i < N_BUCKETS; i++)
+    {
+      seen += m_buckets[i];
+      if (seen >= rank)
+	{
+	  return std::min (GetBucketUpperBound (i), m_max);
+	}
+    }
+  return m_max;
+}
+
+void
+DelayHistogram::Save (vanet::CheckpointWriter& writer) const
+{
+  writer.Write (m_count);
+  writer.Write (m_max);
+  writer.WriteBytes (m_buckets, sizeof (m_buckets));
+}
+
+void
+DelayHistogram::Load (vanet::CheckpointReader& reader)
+{
+  reader.Read (m_count);
+  reader.Read (m_max);
+  reader.ReadBytes (m_buckets, sizeof (m_buckets));
+}
+
+// RequestStats
+RequestStats::RequestStats ()
+  : m_SubmittedReqs(0),
+    m_SatisfiedReqs(0),
+    m_BroadcastPkts(0),
+    m_CumulativeDelay(0)
+{
+}
+
+uint32_t
+RequestStats::GetSubmittedReqs ()
+{
+  return m_SubmittedReqs;
+}
+
+void
+RequestStats::IncSubmittedReqs (uint32_t reqs)
+{
+  m_SubmittedReqs += reqs;
+}
+
+void
+RequestStats::SetSubmittedReqs (uint32_t submittedReqs)
+{
+  m_SubmittedReqs = submittedReqs;
+}
+
+uint32_t
+RequestStats::GetSatisfiedReqs ()
+{
+  return m_SatisfiedReqs;
+}
+
+void
+RequestStats::IncSatisfiedReqs ()
+{
+  m_SatisfiedReqs++;
+}
+
+void
+RequestStats::SetSatisfiedReqs (uint32_t satisfiedReqs)
+{
+  m_SatisfiedReqs = satisfiedReqs;
+}
+
+uint32_t
+RequestStats::GetBroadcastPkts ()
+{
+  return m_BroadcastPkts;
+}
+
+void
+RequestStats::IncBroadcastPkts ()
+{
+  m_BroadcastPkts++;
+}
+
+void
+RequestStats::SetBroadcastPkts (uint32_t broadcastPkts)
+{
+  m_BroadcastPkts = broadcastPkts;
+}
+
+double
+RequestStats::GetCumulativeDelay ()
+{
+  return m_CumulativeDelay;
+}
+
+void
+RequestStats::IncCumulativeDelay (double delay)
+{
+  m_CumulativeDelay += delay;
+  m_delayHistogram.Record (delay > 0 ? (uint64_t) delay : 0);
+}
+
+void
+RequestStats::SetCumulativeDelay (double cumulativeDelay)
+{
+  m_CumulativeDelay = cumulativeDelay;
+}
+
+const DelayHistogram&
+RequestStats::GetDelayHistogram () const
+{
+  return m_delayHistogram;
+}
+
+void
+RequestStats::Save (vanet::CheckpointWriter& writer) const
+{
+  writer.Write (m_SubmittedReqs);
+  writer.Write (m_SatisfiedReqs);
+  writer.Write (m_BroadcastPkts);
+  writer.Write (m_CumulativeDelay);
+  m_delayHistogram.Save (writer);
+}
+
+void
+RequestStats::Load (vanet::CheckpointReader& reader)
+{
+  reader.Read (m_SubmittedReqs);
+  reader.Read (m_SatisfiedReqs);
+  reader.Read (m_BroadcastPkts);
+  reader.Read (m_CumulativeDelay);
+  m_delayHistogram.Load (reader);
+}
+
+// TickRecorder
+TickRecorder::TickRecorder ()
+  : m_hasPending (false),
+    m_stop (false),
+    m_binary (false),
+    m_file (0)
+{
+}
+
+TickRecorder::~TickRecorder ()
+{
+  Close ();
+}
+
+void
+TickRecorder::Open (const std::string& fileName, bool binary, uint32_t capacity)
+{
+  NS_ASSERT_MSG (m_file == 0, "tick recorder is already open");
+  NS_ASSERT_MSG (capacity > 0, "tick recorder needs a non-empty buffer");
+
+  m_file = std::fopen (fileName.c_str (), binary ? "wb" : "w");
+  if (m_file == 0)
+    {
+      NS_FATAL_ERROR ("Could not open tick record file " << fileName);
+    }
+  m_binary = binary;
+  m_active.reserve (capacity);
+  m_pending.reserve (capacity);
+  m_hasPending = false;
+  m_stop = false;
+
+  if (!m_binary)
+    {
+      std::fprintf (m_file, "time,satisfiedReqs,broadcastPkts,graphSize,cliqueSize,queueLength,schedulerTime\n");
+    }
+
+  m_writer = std::thread (&TickRecorder::WriterLoop, this);
+}
+
+bool
+TickRecorder::IsOpen () const
+{
+  return m_file != 0;
+}
+
+void
+TickRecorder::Record (const TickRecord& record)
+{
+  m_active.push_back (record);
+  if (m_active.size () < m_active.capacity ())
+    {
+      return;
+    }
+
+  // hand the full buffer over, waiting only if the writer is still busy with the last one
+  std::unique_lock<std::mutex> lock (m_mutex);
+  m_cv.wait (lock, [this] { return !m_hasPending; });
+  m_active.swap (m_pending);
+  m_active.clear ();
+  m_hasPending = true;
+  lock.unlock ();
+  m_cv.notify_all ();
+}
+
+void
+TickRecorder::Close ()
+{
+  if (m_file == 0)
+    {
+      return;
+    }
+
+  {
+    std::unique_lock<std::mutex> lock (m_mutex);
+    m_cv.wait (lock, [this] { return !m_hasPending; });
+    m_active.swap (m_pending);
+    m_active.clear ();
+    m_hasPending = !m_pending.empty ();
+    m_stop = true;
+  }
+  m_cv.notify_all ();
+  m_writer.join ();
+
+  std::fclose (m_file);
+  m_file = 0;
+}
+
+void
+TickRecorder::WriterLoop ()
+{
+  std::unique_lock<std::mutex> lock (m_mutex);
+  while (true)
+    {
+      m_cv.wait (lock, [this] { return m_hasPending || m_stop; });
+      if (m_hasPending)
+	{
+	  // m_pending is not touched by the simulation while m_hasPending is set
+	  lock.unlock ();
+	  Write (m_pending);
+	  lock.lock ();
+	  m_pending.clear ();
+	  m_hasPending = false;
+	  m_cv.notify_all ();
+	}
+      else if (m_stop)
+	{
+	  break;
+	}
+    }
+  std::fflush (m_file);
+}
+
+void
+TickRecorder::Write (const std::vector<TickRecord>& records)
+{
+  if (m_binary)
+    {
+      std::fwrite (records.data (), sizeof (TickRecord), records.size (), m_file);
+      return;
+    }
+  for (const TickRecord& r : records)
+    {
+      std::fprintf (m_file, "%.6f,%u,%u,%u,%u,%u,%.9f\n", r.time, r.satisfiedReqs, r.broadcastPkts,
+		    r.graphSize, r.cliqueSize, r.queueLength, r.schedulerTime);
+    }
+}
+
+// RoutingStats
+RoutingStats::RoutingStats ()
+  : m_RxBytes (0),
+    m_cumulativeRxBytes (0),
+    m_RxPkts (0),
+    m_cumulativeRxPkts (0),
+    m_TxBytes (0),
+    m_cumulativeTxBytes (0),
+    m_TxPkts (0),
+    m_cumulativeTxPkts (0)
+{
+}
+
+uint32_t
+RoutingStats::GetRxBytes ()
+{
+  return m_RxBytes;
+}
+
+uint32_t
+RoutingStats::GetCumulativeRxBytes ()
+{
+  return m_cumulativeRxBytes;
+}
+
+uint32_t
+RoutingStats::GetRxPkts ()
+{
+  return m_RxPkts;
+}
+
+uint32_t
+RoutingStats::GetCumulativeRxPkts ()
+{
+  return m_cumulativeRxPkts;
+}
+
+void
+RoutingStats::IncRxBytes (uint32_t rxBytes)
+{
+  m_RxBytes += rxBytes;
+  m_cumulativeRxBytes += rxBytes;
+}
+
+void
+RoutingStats::IncRxPkts ()
+{
+  m_RxPkts++;
+  m_cumulativeRxPkts++;
+}
+
+void
+RoutingStats::SetRxBytes (uint32_t rxBytes)
+{
+  m_RxBytes = rxBytes;
+}
+
+void
+RoutingStats::SetRxPkts (uint32_t rxPkts)
+{
+  m_RxPkts = rxPkts;
+}
+
+uint32_t
+RoutingStats::GetTxBytes ()
+{
+  return m_TxBytes;
+}
+
+uint32_t
+RoutingStats::GetCumulativeTxBytes ()
+{
+  return m_cumulativeTxBytes;
+}
+
+uint32_t
+RoutingStats::GetTxPkts ()
+{
+  return m_TxPkts;
+}
+
+uint32_t
+RoutingStats::GetCumulativeTxPkts ()
+{
+  return m_cumulativeTxPkts;
+}
+
+void
+RoutingStats::IncTxBytes (uint32_t txBytes)
+{
+  m_TxBytes += txBytes;
+  m_cumulativeTxBytes += txBytes;
+}
+
+void
+RoutingStats::IncTxPkts ()
+{
+  m_TxPkts++;
+  m_cumulativeTxPkts++;
+}
+
+void
+RoutingStats::SetTxBytes (uint32_t txBytes)
+{
+  m_TxBytes = txBytes;
+}
+
+void
+RoutingStats::SetTxPkts (uint32_t txPkts)
+{
+  m_TxPkts = txPkts;
+}
+
+// WifiPhyStats
+NS_LOG_COMPONENT_DEFINE ("WifiPhyStats");
+NS_OBJECT_ENSURE_REGISTERED (WifiPhyStats);
+
+TypeId
+WifiPhyStats::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::WifiPhyStats")
+    .SetParent<Object> ()
+    .AddConstructor<WifiPhyStats> ();
+  return tid;
+}
+
+WifiPhyStats::WifiPhyStats ()
+  : m_phyTxPkts (0),
+    m_phyTxBytes (0)
+{
+}
+
+WifiPhyStats::~WifiPhyStats ()
+{
+}
+
+void
+WifiPhyStats::PhyTxTrace (std::string context, Ptr<const Packet> packet, WifiMode mode, WifiPreamble preamble, uint8_t txPower)
+{
+  NS_LOG_FUNCTION (this << context << packet << "PHYTX mode=" << mode );
+  ++m_phyTxPkts;
+  uint32_t pktSize = packet->GetSize ();
+  m_phyTxBytes += pktSize;
+
+  //NS_LOG_UNCOND ("Received PHY size=" << pktSize);
+}
+
+void
+WifiPhyStats::PhyTxDrop (std::string context, Ptr<const Packet> packet)
+{
+  NS_LOG_UNCOND ("PHY Tx Drop");
+}
+
+void
+WifiPhyStats::PhyRxDrop (std::string context, Ptr<const Packet> packet)
+{
+  NS_LOG_UNCOND ("PHY Rx Drop");
+}
+
+uint32_t
+WifiPhyStats::GetTxBytes ()
+{
+  return m_phyTxBytes;
+}
@@ -0,0 +1,410 @@
+/*
+ * stats.h
+ *
+ *  Created on: Jul 26, 2018
+ *      Author: Yang yanning <yang.ksn@gmail.com>
+ */
+
+#ifndef SCRATCH_VANET_CS_VFC_STATS_H_
+#define SCRATCH_VANET_CS_VFC_STATS_H_
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/wifi-module.h"
+
+#include <algorithm>
+#include <cmath>
+#include <condition_variable>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace ns3;
+
+namespace ns3 {
+namespace vanet {
+class CheckpointWriter;
+class CheckpointReader;
+} // namespace vanet
+} // namespace ns3
+
+struct RequestStatus
+{
+  bool		completed	= false;
+  double 	submitTime	= -1.0;
+  double	satisfiedTime	= -1.0;
+};
+
+/**
+ * \brief Log-bucketed histogram of delays, in the spirit of HdrHistogram.
+ *
+ * Values below 2^SUB_BUCKET_BITS are counted exactly; above that every
+ * power of two is split into 2^SUB_BUCKET_BITS equal buckets, so a value is
+ * known within 1/64 of itself. Memory is fixed, recording is O(1), and two
+ * histograms of the same layout merge by adding their buckets.
+ */
+class DelayHistogram
+{
+public:
+  static const uint32_t SUB_BUCKET_BITS = 6;
+  static const uint32_t SUB_BUCKETS = 1u << SUB_BUCKET_BITS;
+  static const uint32_t N_BUCKETS = (64 - SUB_BUCKET_BITS + 1) * SUB_BUCKETS;
+
+  DelayHistogram ();
+
+  /**
+   * \brief Count one value
+   * \param value the value, e.g. a delay in ns
+   * \return none
+   */
+  void Record (uint64_t value);
+
+  /**
+   * \brief Add all values counted by another histogram
+   * \param other the other histogram
+   * \return none
+   */
+  void Merge (const DelayHistogram& other);
+
+  uint64_t GetCount () const;
+
+  uint64_t GetMax () const;
+
+  /**
+   * \param percentile a percentile in [0, 100]
+   * \return the smallest value such that percentile percent of the values
+   * are not larger, within the bucket precision; 0 if empty
+   */
+  uint64_t GetPercentile (double percentile) const;
+
+  void Save (vanet::CheckpointWriter& writer) const;
+
+  void Load (vanet::CheckpointReader& reader);
+
+private:
+  static uint32_t GetBucketIndex (uint64_t value);
+
+  static uint64_t GetBucketUpperBound (uint32_t index);
+
+  uint64_t m_count; ///< values counted
+  uint64_t m_max; ///< largest value counted
+  uint64_t m_buckets[N_BUCKETS]; ///< counts per bucket
+};
+
+class RequestStats
+{
+public:
+
+  RequestStats ();
+
+  uint32_t GetSubmittedReqs ();
+
+  void IncSubmittedReqs (uint32_t reqs);
+
+  void SetSubmittedReqs (uint32_t submittedReqs);
+
+  uint32_t GetSatisfiedReqs ();
+
+  void IncSatisfiedReqs ();
+
+  void SetSatisfiedReqs (uint32_t satisfiedReqs);
+
+  uint32_t GetBroadcastPkts ();
+
+  void IncBroadcastPkts ();
+
+  void SetBroadcastPkts (uint32_t broadcastPkts);
+
+  double GetCumulativeDelay ();
+
+  void IncCumulativeDelay (double delay);
+
+  void SetCumulativeDelay (double cumulativeDelay);
+
+  /**
+   * \return histogram of the delays passed to IncCumulativeDelay, in ns
+   */
+  const DelayHistogram& GetDelayHistogram () const;
+
+  void Save (vanet::CheckpointWriter& writer) const;
+
+  void Load (vanet::CheckpointReader& reader);
+
+private:
+  uint32_t m_SubmittedReqs; ///< packets submitted
+  uint32_t m_SatisfiedReqs; ///< packets satisfied
+  uint32_t m_BroadcastPkts; ///< packets broadcast by BS
+  double m_CumulativeDelay; ///< cumulative delay
+  DelayHistogram m_delayHistogram; ///< distribution of the delays
+};
+
+/**
+ * \brief Snapshot of one scheduling tick, written by TickRecorder.
+ *
+ * Fields are ordered so the struct has no padding; the binary output is a
+ * plain sequence of these records in host byte order.
+ */
+struct TickRecord
+{
+  double	time		= 0.0;	///< simulation time (s)
+  double	schedulerTime	= 0.0;	///< wall time spent in the scheduler (s)
+  uint32_t	satisfiedReqs	= 0;	///< requests satisfied so far
+  uint32_t	broadcastPkts	= 0;	///< packets broadcast so far
+  uint32_t	graphSize	= 0;	///< vertices of the cs-vfc graph
+  uint32_t	cliqueSize	= 0;	///< vertices of the largest clique
+  uint32_t	queueLength	= 0;	///< requests still waiting to be satisfied
+  uint32_t	reserved	= 0;
+};
+
+/**
+ * \brief Records one TickRecord per scheduling tick.
+ *
+ * Records are appended to a preallocated buffer. A full buffer is swapped
+ * with a spare one and written to the file by a writer thread, so the
+ * simulation never formats or writes the records itself.
+ */
+class TickRecorder
+{
+public:
+  TickRecorder ();
+
+  ~TickRecorder ();
+
+  /**
+   * \brief Start recording
+   * \param fileName output file
+   * \param binary write raw records instead of CSV
+   * \param capacity number of records buffered before a flush
+   * \return none
+   */
+  void Open (const std::string& fileName, bool binary, uint32_t capacity = 4096);
+
+  bool IsOpen () const;
+
+  /**
+   * \brief Append a record, the buffer is handed to the writer when full
+   * \param record the record of the current tick
+   * \return none
+   */
+  void Record (const TickRecord& record);
+
+  /**
+   * \brief Write the remaining records and stop the writer
+   * \return none
+   */
+  void Close ();
+
+private:
+  void WriterLoop ();
+
+  void Write (const std::vector<TickRecord>& records);
+
+  std::vector<TickRecord> m_active; ///< buffer filled by the simulation
+  std::vector<TickRecord> m_pending; ///< buffer owned by the writer
+  bool m_hasPending; ///< m_pending waits to be written
+  bool m_stop; ///< writer stops once m_pending is written
+  bool m_binary; ///< raw records instead of CSV
+  std::FILE *m_file; ///< output file, 0 when closed
+  std::thread m_writer; ///< writer thread
+  std::mutex m_mutex; ///< guards m_pending, m_hasPending and m_stop
+  std::condition_variable m_cv; ///< signals m_hasPending and m_stop changes
+};
+
+/**
+ * \ingroup wave
+ * \brief The RoutingStats class manages collects statistics
+ * on routing data (application-data packet and byte counts)
+ * for the vehicular network
+ */
+class RoutingStats
+{
+public:
+  /**
+   * \brief Constructor
+   * \return none
+   */
+  RoutingStats ();
+
+  /**
+   * \brief Returns the number of bytes received
+   * \return the number of bytes received
+   */
+  uint32_t GetRxBytes ();
+
+  /**
+   * \brief Returns the cumulative number of bytes received
+   * \return the cumulative number of bytes received
+   */
+  uint32_t GetCumulativeRxBytes ();
+
+  /**
+   * \brief Returns the count of packets received
+   * \return the count of packets received
+   */
+  uint32_t GetRxPkts ();
+
+  /**
+   * \brief Returns the cumulative count of packets received
+   * \return the cumulative count of packets received
+   */
+  uint32_t GetCumulativeRxPkts ();
+
+  /**
+   * \brief Increments the number of (application-data)
+   * bytes received, not including MAC/PHY overhead
+   * \param rxBytes the number of bytes received
+   * \return none
+   */
+  void IncRxBytes (uint32_t rxBytes);
+
+  /**
+   * \brief Increments the count of packets received
+   * \return none
+   */
+  void IncRxPkts ();
+
+  /**
+   * \brief Sets the number of bytes received.
+   * \param rxBytes the number of bytes received
+   * \return none
+   */
+  void SetRxBytes (uint32_t rxBytes);
+
+  /**
+   * \brief Sets the number of packets received
+   * \param rxPkts the number of packets received
+   * \return none
+   */
+  void SetRxPkts (uint32_t rxPkts);
+
+  /**
+   * \brief Returns the number of bytes transmitted
+   * \return the number of bytes transmitted
+   */
+  uint32_t GetTxBytes ();
+
+  /**
+   * \brief Returns the cumulative number of bytes transmitted
+   * \return none
+   */
+  uint32_t GetCumulativeTxBytes ();
+
+  /**
+   * \brief Returns the number of packets transmitted
+   * \return the number of packets transmitted
+   */
+  uint32_t GetTxPkts ();
+
+  /**
+   * \brief Returns the cumulative number of packets transmitted
+   * \return the cumulative number of packets transmitted
+   */
+  uint32_t GetCumulativeTxPkts ();
+
+  /**
+   * \brief Increment the number of bytes transmitted
+   * \param txBytes the number of addtional bytes transmitted
+   * \return none
+   */
+  void IncTxBytes (uint32_t txBytes);
+
+  /**
+   * \brief Increment the count of packets transmitted
+   * \return none
+   */
+  void IncTxPkts ();
+
+  /**
+   * \brief Sets the number of bytes transmitted
+   * \param txBytes the number of bytes transmitted
+   * \return none
+   */
+  void SetTxBytes (uint32_t txBytes);
+
+  /**
+   * \brief Sets the number of packets transmitted
+   * \param txPkts the number of packets transmitted
+   * \return none
+   */
+  void SetTxPkts (uint32_t txPkts);
+
+private:
+  uint32_t m_RxBytes; ///< reeive bytes
+  uint32_t m_cumulativeRxBytes; ///< cumulative receive bytes
+  uint32_t m_RxPkts; ///< receive packets
+  uint32_t m_cumulativeRxPkts; ///< cumulative receive packets
+  uint32_t m_TxBytes; ///< transmit bytes
+  uint32_t m_cumulativeTxBytes; ///< cumulative transmit bytes
+  uint32_t m_TxPkts; ///< transmit packets
+  uint32_t m_cumulativeTxPkts; ///< cumulative transmit packets
+};
+
+
+/**
+ * \ingroup wave
+ * \brief The WifiPhyStats class collects Wifi MAC/PHY statistics
+ */
+class WifiPhyStats : public Object
+{
+public:
+  /**
+   * \brief Gets the class TypeId
+   * \return the class TypeId
+   */
+  static TypeId GetTypeId (void);
+
+  /**
+   * \brief Constructor
+   * \return none
+   */
+  WifiPhyStats ();
+
+  /**
+   * \brief Destructor
+   * \return none
+   */
+  virtual ~WifiPhyStats ();
+
+  /**
+   * \brief Returns the number of bytes that have been transmitted
+   * (this includes MAC/PHY overhead)
+   * \return the number of bytes transmitted
+   */
+  uint32_t GetTxBytes ();
+
+  /**
+   * \brief Callback signiture for Phy/Tx trace
+   * \param context this object
+   * \param packet packet transmitted
+   * \param mode wifi mode
+   * \param preamble wifi preamble
+   * \param txPower transmission power
+   * \return none
+   */
+  void PhyTxTrace (std::string context, Ptr<const Packet> packet, WifiMode mode, WifiPreamble preamble, uint8_t txPower);
+
+  /**
+   * \brief Callback signiture for Phy/TxDrop
+   * \param context this object
+   * \param packet the tx packet being dropped
+   * \return none
+   */
+  void PhyTxDrop (std::string context, Ptr<const Packet> packet);
+
+  /**
+   * \brief Callback signiture for Phy/RxDrop
+   * \param context this object
+   * \param packet the rx packet being dropped
+   * \return none
+   */
+  void PhyRxDrop (std::string context, Ptr<const Packet> packet);
+
+private:
+  uint32_t m_phyTxPkts; ///< phy transmit packets
+  uint32_t m_phyTxBytes; ///< phy transmit bytes
+};
+
+
+#endif /* SCRATCH_VANET_CS_VFC_STATS_H_ */
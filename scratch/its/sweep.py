@@ -0,0 +1,152 @@
+#!/usr/bin/env python3
+#
+# Run vanet-cs-vfc over a parameter grid, one simulation process per run.
+#
+# Every run writes its result line to <out>/runs/<run>.dat through
+# --resultFile; the simulation writes it aside and renames it, so a result
+# file exists only for a completed run. Runs whose result file exists are
+# skipped, which makes an interrupted or partly failed sweep resumable by
+# simply starting it again. After every completed run the per-run files of a
+# scheme are merged into <out>/<scheme>.dat, again through a rename.
+#
+# Example, run from the ns-3 top level directory:
+#
+#   ./waf build
+#   python3 scratch/its/sweep.py --schemes cs-vfc ncb --db-sizes 20 40 60 80 100 \
+#       --nodes 288 --seeds 1 2 3 --jobs 64
+#
+# With many jobs, run the built program directly from within "./waf shell"
+# (--binary build/scratch/its/its) so the runs do not all go through waf.
+#
+
+import argparse
+import itertools
+import os
+import shlex
+import subprocess
+import sys
+from concurrent.futures import ThreadPoolExecutor, as_completed
+
+RESULT_HEADER = "# scheme nNodes run dbSize ASD SR BE P50 P95 P99 Max\n"
+
+
+def parse_args():
+    parser = argparse.ArgumentParser(description="parallel parameter sweep of vanet-cs-vfc")
+    parser.add_argument("--schemes", nargs="+", default=["cs-vfc", "ncb", "ma"],
+                        help="values of --schemeName")
+    parser.add_argument("--db-sizes", nargs="+", type=int, default=[100],
+                        help="values of --globalDbSize")
+    parser.add_argument("--nodes", nargs="+", type=int, default=[288],
+                        help="values of --nNodes")
+    parser.add_argument("--seeds", nargs="+", type=int, default=[1],
+                        help="values of --RngRun")
+    parser.add_argument("--jobs", type=int, default=os.cpu_count() or 1,
+                        help="simulations running at the same time")
+    parser.add_argument("--retries", type=int, default=1,
+                        help="extra attempts for a failed run")
+    parser.add_argument("--out", default="result/sweep",
+                        help="directory of the per-run and merged results")
+    parser.add_argument("--binary", default=None,
+                        help="built simulation program, run directly instead of through waf")
+    parser.add_argument("--waf", default="./waf",
+                        help="waf script used when --binary is not given")
+    parser.add_argument("--program", default="its",
+                        help="waf program name of the simulation")
+    parser.add_argument("--extra", default="",
+                        help="arguments passed to every run, e.g. --extra=\"--totaltime=300\"")
+    parser.add_argument("--dry-run", action="store_true",
+                        help="print the runs still to do and exit")
+    return parser.parse_args()
+
+
+def run_name(scheme, db_size, nodes, seed):
+    return "%s-db%d-n%d-s%d" % (scheme, db_size, nodes, seed)
+
+
+def run_command(args, scheme, db_size, nodes, seed, result_file):
+    run_args = ["--schemeName=%s" % scheme,
+                "--globalDbSize=%d" % db_size,
+                "--nNodes=%d" % nodes,
+                "--RngRun=%d" % seed,
+                "--resultFile=%s" % os.path.abspath(result_file),
+                "--log=none"] + shlex.split(args.extra)
+    if args.binary:
+        return [args.binary] + run_args
+    return [args.waf, "--run", " ".join([args.program] + [shlex.quote(a) for a in run_args])]
+
+
+def atomic_write(path, text):
+    tmp = "%s.tmp.%d" % (path, os.getpid())
+    with open(tmp, "w") as f:
+        f.write(text)
+        f.flush()
+        os.fsync(f.fileno())
+    os.replace(tmp, path)
+
+
+def merge_results(args, runs_dir, scheme):
+    lines = []
+    for db_size, nodes, seed in itertools.product(args.db_sizes, args.nodes, args.seeds):
+        path = os.path.join(runs_dir, run_name(scheme, db_size, nodes, seed) + ".dat")
+        if os.path.exists(path):
+            with open(path) as f:
+                lines.extend(l for l in f if l.strip())
+    atomic_write(os.path.join(args.out, scheme + ".dat"), RESULT_HEADER + "".join(lines))
+
+
+def execute(args, runs_dir, job):
+    scheme, db_size, nodes, seed = job
+    name = run_name(scheme, db_size, nodes, seed)
+    result_file = os.path.join(runs_dir, name + ".dat")
+    command = run_command(args, scheme, db_size, nodes, seed, result_file)
+    for attempt in range(args.retries + 1):
+        with open(os.path.join(runs_dir, name + ".log"), "w") as log:
+            log.write(" ".join(shlex.quote(c) for c in command) + "\n")
+            log.flush()
+            status = subprocess.call(command, stdout=log, stderr=subprocess.STDOUT)
+        if status == 0 and os.path.exists(result_file):
+            return name, True, attempt + 1
+    return name, False, args.retries + 1
+
+
+def main():
+    args = parse_args()
+    runs_dir = os.path.join(args.out, "runs")
+    os.makedirs(runs_dir, exist_ok=True)
+
+    jobs = []
+    for job in itertools.product(args.schemes, args.db_sizes, args.nodes, args.seeds):
+        if not os.path.exists(os.path.join(runs_dir, run_name(*job) + ".dat")):
+            jobs.append(job)
+    total = len(args.schemes) * len(args.db_sizes) * len(args.nodes) * len(args.seeds)
+    print("%d runs, %d already done, %d to do with %d jobs"
+          % (total, total - len(jobs), len(jobs), args.jobs))
+    if args.dry_run:
+        for job in jobs:
+            print(run_name(*job))
+        return 0
+
+    failed = []
+    # the simulations are separate processes, threads only wait for them
+    with ThreadPoolExecutor(max_workers=args.jobs) as pool:
+        futures = {pool.submit(execute, args, runs_dir, job): job for job in jobs}
+        for done, future in enumerate(as_completed(futures), 1):
+            name, ok, attempts = future.result()
+            if not ok:
+                failed.append(name)
+            print("[%d/%d] %s %s after %d attempt(s)"
+                  % (done, len(jobs), name, "done" if ok else "FAILED", attempts))
+            sys.stdout.flush()
+            merge_results(args, runs_dir, futures[future][0])
+
+    for scheme in args.schemes:
+        merge_results(args, runs_dir, scheme)
+    if failed:
+        print("%d run(s) failed, see the .log files in %s; run again to retry them"
+              % (len(failed), runs_dir))
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,1793 @@
+/*
+ * vanet-cs-vfc.cc
+ *
+ *  Created on: Aug 14, 2018
+ *      Author: Yang yanning <yang.ksn@gmail.com>
+ */
+
+#include "vanet-cs-vfc.h"
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("vanet-cs-vfc");
+
+const uint32_t VanetCsVfcExperiment::Not_An_Obu;
+
+VanetCsVfcExperiment::VanetCsVfcExperiment ():
+    m_protocol (0),
+    m_dlPort (1000),
+    m_ulPort (2000),
+    m_v2IPort (3000),
+    m_i2IPort (4000),
+    m_i2VPort (5000),
+    m_protocolName ("NONE"),
+    m_schemeName (Scheme_1),  // cs-vfc, ncb, genetic
+    m_logCategories ("final-request"),
+    m_nObuNodes (288),
+    m_obuNodes (),
+    m_obuTxp (137), // 450m
+    m_nRsuNodes (16),
+    m_rsuNodes (),
+    m_rsuTxp (137), // 450m
+    m_ueNodes (),
+    m_enbNodes (),
+    m_remoteHostNodes (),
+    m_bsTxp (166.1), // 2122m
+    m_phyMode ("OfdmRate6MbpsBW10MHz"),
+    m_traceMobility (false),
+    m_workspacePath (/*"../workspace/vanet-cs-vfc"*/ "."),
+    m_mobilityFile (m_workspacePath + "/mobility" + "/mobility.tcl"),
+    m_mobLogFile (m_workspacePath + "/mobility.log"),
+    m_trName (m_workspacePath + "/vanet-cs-vfc.mob"),
+    m_animFile (m_workspacePath + "/vanet-cs-vfc-animation.xml"),
+    m_plotFileName (m_workspacePath + "/result/vanet-cs-vfc-plot"),
+    m_log (1),
+    m_TotalSimTime (Total_Sim_Time),
+    m_rate ("2048bps"),
+    m_wavePacketSize (200),
+    m_nonSafetySize (1500),
+    m_waveInterval (0.1),
+    m_verbose (0),
+    m_routingTables (0),
+    m_asciiTrace (0),
+    m_pcap (0),
+    m_timeSpent (0.0),
+    m_tickStatsFile (""),
+    m_tickStatsBinary (false),
+    m_resultFile (""),
+    m_checkpointFile (""),
+    m_checkpointPeriod (60),
+    m_restoreFile (""),
+    m_tick (0),
+    m_firstTickTime (Seconds (0.01)),
+    globalDbSize (100),
+    currentBroadcastId (0),
+    receive_count (0),
+    m_scheduler (0)
+{
+}
+
+VanetCsVfcExperiment::~VanetCsVfcExperiment ()
+{
+  delete m_scheduler;
+}
+
+void
+VanetCsVfcExperiment::Simulate (int argc, char **argv)
+{
+  NS_LOG_UNCOND ("Start Simulate...");
+
+  SetDefaultAttributeValues ();
+  ParseCommandLineArguments (argc, argv);
+  ConfigureNodes ();
+//  ConfigureChannels ();
+  ConfigureDevices ();
+//  ConfigureInternet ();
+//  ConfigureMobility ();
+  ConfigureApplications ();
+  ConfigureTracing ();
+  RunSimulation ();
+  ProcessOutputs ();
+}
+
+int
+VanetCsVfcExperiment::MkPath(std::string s,mode_t mode=0755)
+{
+  size_t pre=0,pos;
+  std::string dir;
+  int mdret = 0;
+
+  if(s[s.size()-1]!='/'){
+      // force trailing / so we can handle everything in loop
+      s+='/';
+  }
+
+  while((pos=s.find_first_of('/',pre))!=std::string::npos){
+      dir=s.substr(0,pos++);
+      pre=pos;
+      if(dir.size()==0) continue; // if leading / first time is 0 length
+      if((mdret=::mkdir(dir.c_str(),mode)) && errno!=EEXIST){
+          return mdret;
+      }
+  }
+  return mdret;
+}
+
+void
+VanetCsVfcExperiment::SetDefaultAttributeValues ()
+{
+  // handled in constructor
+}
+
+void
+VanetCsVfcExperiment::ParseCommandLineArguments (int argc, char **argv)
+{
+  CommandSetup (argc, argv);
+  Initialization ();
+
+  ConfigureDefaults ();
+}
+
+void
+VanetCsVfcExperiment::ConfigureNodes ()
+{
+  m_obuNodes.Create (m_nObuNodes);
+  m_rsuNodes.Create (m_nRsuNodes);
+
+  // node ids are dense, a vector indexed by id replaces the map
+  vehId2IndexMap.assign(NodeList::GetNNodes(), Not_An_Obu);
+  for (uint32_t i = 0; i < m_nObuNodes; i++)
+    {
+      vehId2IndexMap[m_obuNodes.Get(i)->GetId()] = i;
+    }
+  for (uint32_t i = 0; i < m_nRsuNodes; i++)
+    {
+      fogId2FogIdxMap.insert(make_pair(m_rsuNodes.Get(i)->GetId(), i));
+    }
+}
+
+void
+VanetCsVfcExperiment::ConfigureChannels ()
+{
+  // todo
+}
+
+void
+VanetCsVfcExperiment::ConfigureDevices ()
+{
+  SetupDevices ();
+  // devices are set up in SetupAdhocDevices(),
+  // called by ConfigureChannels()
+
+  // every device will have PHY callback for tracing
+  // which is used to determine the total amount of
+  // data transmitted, and then used to calculate
+  // the MAC/PHY overhead beyond the app-data								// get the raw pointer
+  Config::Connect ("/NodeList/*/DeviceList/*/Phy/State/Tx", MakeCallback (&WifiPhyStats::PhyTxTrace, m_wifiPhyStats)); // @suppress("Invalid arguments")
+  // TxDrop, RxDrop not working yet.  Not sure what I'm doing wrong.
+//  Config::Connect ("/NodeList/*/DeviceList/*/$ns3::WifiNetDevice/Phy/PhyTxDrop", MakeCallback (&WifiPhyStats::PhyTxDrop, m_wifiPhyStats));
+//  Config::Connect ("/NodeList/*/DeviceList/*/$ns3::WifiNetDevice/Phy/PhyRxDrop", MakeCallback (&WifiPhyStats::PhyRxDrop, m_wifiPhyStats));
+}
+
+void
+VanetCsVfcExperiment::ConfigureInternet ()
+{
+  // todo
+}
+
+void
+VanetCsVfcExperiment::ConfigureMobility ()
+{
+  SetupObuMobilityNodes ();
+  SetupRsuMobilityNodes ();
+}
+void
+VanetCsVfcExperiment::ConfigureApplications ()
+{
+  // config trace to capture app-data (bytes) for
+  // routing data, subtracted and used for
+  // routing overhead
+  std::ostringstream oss;
+  oss.str ("");
+  oss << "/NodeList/*/ApplicationList/*/$ns3::OnOffApplication/Tx";
+  Config::Connect (oss.str (), MakeCallback (&VanetCsVfcExperiment::OnOffTrace, this));
+
+  ApplicationContainer serverApps;
+  for (uint32_t i = 0; i < m_nObuNodes; ++i)
+    {
+#if Lte_Enable
+      PacketSinkHelper obuLteDlPacketSinkHelper ("ns3::UdpSocketFactory", InetSocketAddress (m_ueInterface.GetAddress(i), m_dlPort));
+      serverApps.Add (obuLteDlPacketSinkHelper.Install (m_ueNodes.Get(i)));
+#else
+//      PacketSinkHelper obuDsrcDlPacketSinkHelper ("ns3::UdpSocketFactory", InetSocketAddress (m_ueInterface.GetAddress(i), m_dlPort));
+      PacketSinkHelper obuDsrcDlPacketSinkHelper ("ns3::UdpSocketFactory", InetSocketAddress ("10.2.0.0", m_dlPort));
+      serverApps.Add (obuDsrcDlPacketSinkHelper.Install (m_ueNodes.Get(i)));
+#endif
+//      PacketSinkHelper obuDsrcPacketSinkHelper ("ns3::UdpSocketFactory", InetSocketAddress (m_obuInterfaces.GetAddress(i), m_i2VPort));
+      PacketSinkHelper obuDsrcPacketSinkHelper ("ns3::UdpSocketFactory", InetSocketAddress ("10.3.0.0", m_i2VPort));
+      serverApps.Add (obuDsrcPacketSinkHelper.Install (m_obuNodes.Get(i)));
+    }
+  for (uint32_t i = 0; i < m_nRsuNodes; ++i)
+    {
+      PacketSinkHelper rsuDsrcPacketSinkHelper ("ns3::UdpSocketFactory", InetSocketAddress (m_rsu80211pInterfaces.GetAddress(i), m_v2IPort));
+      serverApps.Add (rsuDsrcPacketSinkHelper.Install (m_rsuNodes.Get(i)));
+      PacketSinkHelper rsuCsmaPacketSinkHelper ("ns3::UdpSocketFactory", InetSocketAddress (m_rsuCsmaInterfaces.GetAddress(i), m_i2IPort));
+      serverApps.Add (rsuCsmaPacketSinkHelper.Install (m_rsuNodes.Get(i)));
+    }
+#if Cloud_Enable
+  PacketSinkHelper remoteHostPacketSinkHelper ("ns3::UdpSocketFactory", InetSocketAddress (m_remoteHostAddr, m_ulPort));
+  serverApps.Add (remoteHostPacketSinkHelper.Install (m_remoteHost));
+#endif
+  // bind the receiving node to every sink, so the receive path does not have
+  // to recover it from a config path
+  for (ApplicationContainer::Iterator i = serverApps.Begin (); i != serverApps.End (); ++i)
+    {
+      Ptr<Application> app = (*i);
+      app->TraceConnectWithoutContext ("RxWithAddresses", MakeBoundCallback (&VanetCsVfcExperiment::ReceivePacketOnNode, this, app->GetNode ()->GetId ()));
+    }
+  serverApps.Start (Seconds (0.01));
+}
+
+void
+VanetCsVfcExperiment::ConfigureTracing ()
+{
+//  WriteCsvHeader ();//todo
+  SetupTraceFile ();
+  SetupLogging ();
+}
+
+void
+VanetCsVfcExperiment::ConfigureAnim ()
+{
+  AnimationInterface anim (m_animFile);
+  uint32_t resId1 = anim.AddResource("/home/haha/Pictures/icon/car-003.png");
+  uint32_t resId3 = anim.AddResource("/home/haha/Pictures/icon/rsu-001.png");
+  uint32_t resId5 = anim.AddResource("/home/haha/Pictures/icon/cloud.png");
+
+  for (uint32_t i = 0; i < m_nObuNodes; ++i)
+    {
+      Ptr<Node> obu = m_obuNodes.Get(i);
+//      anim.UpdateNodeDescription (obu, "OBU");
+      anim.UpdateNodeSize(obu->GetId(), 50, 50);
+      anim.UpdateNodeImage(obu->GetId(), resId1);
+    }
+  for (uint32_t i = 0; i < m_nRsuNodes; ++i)
+    {
+      Ptr<Node> rsu = m_rsuNodes.Get(i);
+//      anim.UpdateNodeDescription (rsu, "RSU");
+      anim.UpdateNodeSize(rsu->GetId(), 50, 50);
+      anim.UpdateNodeImage(rsu->GetId(), resId3);
+    }
+#if Lte_Enable
+  uint32_t resId2 = anim.AddResource("/home/haha/Pictures/icon/cellular-001.png");
+  uint32_t resId4 = anim.AddResource("/home/haha/Pictures/icon/pgw.png");
+  for (uint32_t i = 0; i < m_enbNodes.GetN(); ++i)
+    {
+      Ptr<Node> enb = m_enbNodes.Get(i);
+//      anim.UpdateNodeDescription (enb, "eNB");
+      anim.UpdateNodeSize(enb->GetId(), 50, 50);
+      anim.UpdateNodeImage(enb->GetId(), resId2);
+    }
+
+//  anim.UpdateNodeDescription (m_pgw, "MME/PGW");
+  anim.UpdateNodeSize(m_pgw->GetId(), 50, 50);
+  anim.UpdateNodeImage(m_pgw->GetId(), resId4);
+#endif
+
+//  anim.UpdateNodeDescription (m_remoteHost, "Remote Host");
+  anim.UpdateNodeSize(m_remoteHost->GetId(), 50, 50);
+  anim.UpdateNodeImage(m_remoteHost->GetId(), resId5);
+
+  anim.SetStartTime (Seconds(1));
+  anim.SetStopTime (Seconds(10));
+  anim.EnablePacketMetadata ();
+//  anim.EnableIpv4RouteTracking ("routingtable-wireless.xml", Seconds (0), Seconds (5), Seconds (0.25));
+//  anim.EnableWifiMacCounters (Seconds (0), Seconds (10));
+//  anim.EnableWifiPhyCounters (Seconds (0), Seconds (10));
+}
+
+void
+VanetCsVfcExperiment::RunSimulation ()
+{
+#if Total_Time_Spent_stas
+  clock_t startTime, endTime;
+  startTime = clock();
+  std::cout << "simulation start time " << Now() << " -- " << (double)(startTime) / CLOCKS_PER_SEC << std::endl;
+#endif
+
+  Run ();
+
+#if Total_Time_Spent_stas
+  endTime = clock();
+  m_timeSpent = (double)(endTime - startTime) / CLOCKS_PER_SEC;
+  std::cout << "simulation end time " << Now() << " -- " << m_timeSpent << std::endl;
+#endif
+}
+
+void
+VanetCsVfcExperiment::CheckSimulationStatus ()
+{
+//  if (m_schemeName.compare(Scheme_1) == 0)
+//    {
+//      bool flag = true;
+//      for (std::set<uint32_t> reqs : vehsReqs)
+//	{
+//	  if (!reqs.empty())
+//	    {
+//	      flag = false;
+//	      break;
+//	    }
+//	}
+//      if (flag)
+//	{
+//	  Simulator::Stop();
+//	}
+//    }
+//  else if (m_schemeName.compare(Scheme_2) == 0)
+//    {
+//      std::list<ReqQueueItem>::iterator iter = requestQueue.begin();
+//      for (; iter != requestQueue.end(); iter++)
+//        {
+//	  if (!requestsToMarkGloabal[iter->name]) break;
+//        }
+//      if (iter == requestQueue.end())
+//	{
+//	  Simulator::Stop();
+//	}
+//    }
+//  else if (m_schemeName.compare(Scheme_2) == 0)
+//    {
+//
+//    }
+}
+
+void
+VanetCsVfcExperiment::Run ()
+{
+
+  Simulator::Stop (Seconds (m_TotalSimTime));
+
+#if Output_Animation
+  ConfigureAnim ();
+#endif
+
+  // until the first tick of a restored run only the mobility model runs
+  Simulator::Schedule(m_firstTickTime, &VanetCsVfcExperiment::LoopPerSecond, this);
+
+  Simulator::Run ();
+  Simulator::Destroy ();
+}
+
+void
+VanetCsVfcExperiment::ProcessOutputs ()
+{
+  m_tickRecorder.Close ();
+
+  if (vanet::LogIsEnabled (vanet::LOG_FINAL_REQUEST))
+    {
+      for (uint32_t i = 0; i < m_nObuNodes; i++)
+	{
+	  if (vehsReqs[i].size() == 0) continue;
+	  cout << "veh:" << i << ", final reqs:";
+	  for(uint32_t req : vehsReqs[i])
+	    {
+	      cout << " " << req;
+	    }
+	  cout << endl;
+	}
+    }
+
+  if (vanet::LogIsEnabled (vanet::LOG_FINAL_CACHE))
+    {
+      for (uint32_t i = 0; i < m_nObuNodes; i++)
+	{
+	  if (vehsCaches[i].size() == globalDbSize) continue;
+	  cout << "veh:" << i << ", final caches:";
+	  for(uint32_t cache : vehsCaches[i])
+	    {
+	      cout << " " << cache;
+	    }
+	  cout << endl;
+	}
+    }
+
+//  std::list<ReqQueueItem>::iterator iter = requestQueue.begin();
+//  cout << "----------------------------------------------------------------------------------------" << endl;
+//  cout << "requestQueue:";
+//  for (; iter != requestQueue.end(); iter++)
+//    {
+//      cout << " " << iter->name << "=" << requestsToMarkGloabal[iter->name];
+//    }
+//  cout << endl;
+//  cout << "----------------------------------------------------------------------------------------" << endl;
+//
+//  uint32_t count = 0;
+//  std::map<std::string, bool>::iterator iter1 = requestsToMarkGloabal.begin();
+//  cout << "requestsToMarkGloabal:";
+//  for (; iter1 != requestsToMarkGloabal.end(); iter1++)
+//    {
+//      if (!iter1->second)
+//	{
+//	  count++;
+//	}
+//    }
+//  cout << endl;
+//  cout << "----------------------------------------------------------------------------------------" << endl;
+
+//    cout << "----------------------------------------------------------------------------------------" << endl;
+//    std::map<uint32_t, std::set<std::string>>::iterator iter2 = requestsToMarkWithBid.begin();
+//    for (; iter2 != requestsToMarkWithBid.end(); iter2++)
+//      {
+//	cout << "requestsToMarkWithBid" << "[" << iter2->first << "]:";
+//	for (std::string req : iter2->second)
+//	  {
+//	    cout << " " << req;
+//	  }
+//	cout << endl;
+//      }
+//
+//    cout << "----------------------------------------------------------------------------------------" << endl;
+//    std::map<uint32_t, std::set<uint32_t>>::iterator iter3 = vehsToSatisfy.begin();
+//    for (; iter3 != vehsToSatisfy.end(); iter3++)
+//      {
+//	cout << "vehsToSatisfy" << "[" << iter3->first << "]:";
+//	for (uint32_t veh : iter3->second)
+//	  {
+//	    cout << " " << veh;
+//	  }
+//	cout << endl;
+//      }
+//    cout << "----------------------------------------------------------------------------------------" << endl;
+//
+//  cout << "requestQueue Size:" << requestQueue.size() << endl;
+
+#if Output_Result
+#if !Console_Output_Result
+  std::string outputDir = m_workspacePath + "/result";
+  if (access(outputDir.c_str(), 0) == -1)
+    {
+      MkPath(outputDir);
+    }
+  std::ostringstream oss;
+  oss << outputDir << "/" << m_schemeName << ".txt";
+  std::ofstream ofs; ///< output stream
+  ofs.open (oss.str(), ios::app);
+  streambuf* coutbackup;
+  coutbackup = std::cout.rdbuf(ofs.rdbuf());
+#endif
+
+  std::cout << "globalDbSize: \t " << globalDbSize << std::endl;
+  std::cout << "TimeSpent: \t\t " << m_timeSpent << std::endl;
+  std::cout << "receive_count: \t " << receive_count << std::endl;
+  std::cout << "SubmittedReqs: \t " << m_requestStats.GetSubmittedReqs() << std::endl;
+  std::cout << "SatisfiedReqs: \t " << m_requestStats.GetSatisfiedReqs() << std::endl;
+  std::cout << "BroadcastPkts: \t " << m_requestStats.GetBroadcastPkts() << std::endl;
+  std::cout << "CumulativeDelay: " << m_requestStats.GetCumulativeDelay() << std::endl;
+
+  NS_ASSERT_MSG(m_requestStats.GetSatisfiedReqs() != 0, "number of satisfied request is 0");
+  double ASD = (m_requestStats.GetCumulativeDelay() / 1e+9) / m_requestStats.GetSatisfiedReqs();
+  std::cout << "ASD: \t" << ASD << "s" << std::endl;
+
+  NS_ASSERT_MSG(m_requestStats.GetSubmittedReqs() != 0, "number of submitted request is 0");
+  double SR = (double)m_requestStats.GetSatisfiedReqs() / m_requestStats.GetSubmittedReqs();
+  std::cout << "SR: \t" << SR << std::endl;
+
+  NS_ASSERT_MSG(m_requestStats.GetBroadcastPkts() != 0, "number of broadcast packets is 0");
+  double BE = (double)m_requestStats.GetSatisfiedReqs() / m_requestStats.GetBroadcastPkts();
+  std::cout << "BE: \t" << BE << std::endl;
+
+  const DelayHistogram& delays = m_requestStats.GetDelayHistogram();
+  double P50 = delays.GetPercentile(50) / 1e+9;
+  double P95 = delays.GetPercentile(95) / 1e+9;
+  double P99 = delays.GetPercentile(99) / 1e+9;
+  double PMax = delays.GetMax() / 1e+9;
+  std::cout << "P50: \t" << P50 << "s" << std::endl;
+  std::cout << "P95: \t" << P95 << "s" << std::endl;
+  std::cout << "P99: \t" << P99 << "s" << std::endl;
+  std::cout << "Max: \t" << PMax << "s" << std::endl;
+  for (uint32_t i = 0; i < fogsDelayHistogram.size(); i++)
+    {
+      const DelayHistogram& fogDelays = fogsDelayHistogram[i];
+      if (fogDelays.GetCount() == 0) continue;
+      if (i < m_nRsuNodes)
+	{
+	  std::cout << "fog[" << i << "]";
+	}
+      else
+	{
+	  std::cout << "no fog";
+	}
+      std::cout << " n=" << fogDelays.GetCount()
+		<< " P50=" << fogDelays.GetPercentile(50) / 1e+9 << "s"
+		<< " P95=" << fogDelays.GetPercentile(95) / 1e+9 << "s"
+		<< " P99=" << fogDelays.GetPercentile(99) / 1e+9 << "s"
+		<< " Max=" << fogDelays.GetMax() / 1e+9 << "s" << std::endl;
+    }
+  std::cout << std::endl;
+
+  if (!m_resultFile.empty())
+    {
+      // written aside and renamed, so a sweep never reads a partial result
+      std::string tmpFile = m_resultFile + ".tmp";
+      std::ofstream rfs (tmpFile.c_str());
+      rfs << m_schemeName << " " << m_nObuNodes << " " << RngSeedManager::GetRun() << " " << globalDbSize
+	  << " " << ASD << " " << SR << " " << BE << " " << P50 << " " << P95 << " " << P99 << " " << PMax << std::endl;
+      rfs.close();
+      if (!rfs || std::rename(tmpFile.c_str(), m_resultFile.c_str()) != 0)
+	{
+	  NS_FATAL_ERROR ("Could not write result file " << m_resultFile);
+	}
+    }
+
+#if !Console_Output_Result
+  ofs.close ();
+
+  std::ostringstream oss1;
+  oss1 << outputDir << "/" << m_schemeName << ".dat";
+  ofs.open (oss1.str(), ios::app);
+//  m_ofs << "DbSize " << "ASD " << "SR " << "BE " << "P50 " << "P95 " << "P99 " << "Max " << std::endl;
+  std::cout << globalDbSize << " " << ASD << " " << SR << " " << BE << " " << P50 << " " << P95 << " " << P99 << " " << PMax << std::endl;
+  ofs.close ();
+
+  std::cout.rdbuf(coutbackup);
+#endif
+#endif //Output_Result
+
+#if Gen_Gnuplot_File
+  Gnuplot plot = Gnuplot (m_plotFileName + ".png");
+  plot.SetTerminal ("png");
+  plot.SetLegend ("X Values", "Y Values");
+  plot.AppendExtra("plot \"result1.dat\" using 1:2 w lp pt 5 title \"111\", \"result2.dat\" using 1:3 w lp pt 7 title \"222\"");
+
+  // Open the plot file.
+  std::ostringstream ossPltFile;
+  ossPltFile << m_plotFileName << ".plt";
+  std::ofstream plotFile (ossPltFile.str().c_str());
+  plot.GenerateOutput (plotFile);
+  // Close the plot file.
+  plotFile.close ();
+#endif
+}
+
+void
+VanetCsVfcExperiment::CourseChangeOnObu (VanetCsVfcExperiment *experiment, uint32_t obuIdx, Ptr<const MobilityModel> mobility)
+{
+  experiment->CourseChange (obuIdx, mobility);
+}
+
+// Prints actual position and velocity when a course change event occurs
+void
+VanetCsVfcExperiment::CourseChange (uint32_t obuIdx, Ptr<const MobilityModel> mobility)
+{
+  // if the vehicle enters the observed area for the first time, it will initiate a request to the BS
+  if (vehsEnterFlag[obuIdx] == false)
+    {
+//      UploadVehicleInfo(obu);
+      vehsEnterFlag[obuIdx] = true;
+
+//      Vector pos_obu = mobility->GetPosition (); // Get position
+//      Vector vel_obu = mobility->GetVelocity (); // Get velocity
+//
+//      std::ostringstream oss;
+//      oss << Simulator::Now () << "obuIdx=" << obuIdx << " POS: x=" << pos_obu.x << ", y=" << pos_obu.y
+//          << "; VEL:" << vel_obu.x << ", y=" << vel_obu.y
+//          << std::endl;
+//      cout << oss.str();
+    }
+}
+
+void
+VanetCsVfcExperiment::CourseChange (std::ostream *os, std::string context, Ptr<const MobilityModel> mobility)
+{
+  Vector pos_obu = mobility->GetPosition (); // Get position
+  Vector vel_obu = mobility->GetVelocity (); // Get velocity
+
+  pos_obu.z = 1.5;
+
+  // Prints position and velocities
+  *os << Simulator::Now () << " POS: x=" << pos_obu.x << ", y=" << pos_obu.y
+      << ", z=" << pos_obu.z << "; VEL:" << vel_obu.x << ", y=" << vel_obu.y
+      << ", z=" << vel_obu.z << std::endl;
+}
+
+void
+VanetCsVfcExperiment::LoopPerSecond()
+{
+  // not on the first tick, that state is the one the run started from
+  if (!m_checkpointFile.empty() && Now() != m_firstTickTime && m_tick % m_checkpointPeriod == 0)
+    {
+      SaveCheckpoint ();
+    }
+  m_tick++;
+
+#if Upload_Enable
+  UploadAllVehiclesInfo ();
+#endif
+
+  SubmitAllVehsRequests ();
+  UpdateAllFogCluster ();
+
+#if Lte_Enable
+  CheckSimulationStatus ();
+#endif
+
+#if Loop_Scheduling
+  Simulator::Schedule(Seconds(1.0), &VanetCsVfcExperiment::LoopPerSecond, this);
+#endif
+}
+
+void
+VanetCsVfcExperiment::SubmitVehRequests(Ptr<Node> obu)
+{
+  uint32_t obuId = obu->GetId();
+  uint32_t obuIdx = GetObuIndex(obuId);
+  if (isFirstSubmit[obuIdx])
+    {
+      vehsReqs[obuIdx].insert(vehsInitialReqs[obuIdx].begin(), vehsInitialReqs[obuIdx].end());
+      vehsCaches[obuIdx].insert(vehsInitialCaches[obuIdx].begin(), vehsInitialCaches[obuIdx].end());
+
+      RequestStatus reqStatus;
+      for (uint32_t reqIdx : vehsReqs[obuIdx])
+	{
+	  reqStatus.completed = false;
+	  reqStatus.submitTime = Now().GetDouble();
+	  vehsReqsStatus[obuIdx].insert(make_pair(reqIdx, reqStatus));
+
+	  m_scheduler->OnSubmit(obuIdx, reqIdx);
+	}
+
+      m_requestStats.IncSubmittedReqs(vehsReqs[obuIdx].size());
+
+      isFirstSubmit[obuIdx] = false;
+    }
+}
+
+void
+VanetCsVfcExperiment::SubmitAllVehsRequests()
+{
+  for (NodeContainer::Iterator i = m_obuNodes.Begin (); i != m_obuNodes.End (); ++i)
+    {
+      Ptr<Node> obu = (*i);
+      uint32_t obuId = obu->GetId();
+      uint32_t obuIdx = GetObuIndex(obuId);
+
+      if (vehsEnterFlag[obuIdx] == true)
+        {
+	  SubmitVehRequests(obu);
+        }
+    }
+}
+
+void
+VanetCsVfcExperiment::UploadVehicleInfo(Ptr<Node> obu)
+{
+  Ptr<MobilityModel> model = obu->GetObject<MobilityModel> ();
+  Vector pos_obu = model->GetPosition ();
+
+  uint32_t obuId = obu->GetId();
+  uint32_t obuIdx = GetObuIndex(obuId);
+
+  uint32_t seq = vehsUploadSeq[obuIdx]++;
+  bool isFull = (seq % Upload_Resync_Period) == 0;
+
+  for (uint32_t reqData : vehsReqs[obuIdx])
+    {
+      RequestStatus reqStats;
+      reqStats.submitTime = Now().GetSeconds();
+      vehsReqsStatus[obuIdx].insert(make_pair(reqData, reqStats));
+    }
+
+  /**
+   * vehicle id (uint32_t):		4 * byte
+   * vehicle pos x (double):		8 * byte
+   * vehicle pos y (double):		8 * byte
+   * sequence number (uint32_t):	4 * byte
+   * full upload flag (uint8_t):	1 * byte
+   *
+   * full upload:
+   * num of requsets (uint32_t):	4 * byte
+   * vehicle request (uint32_t):	4 * byte * vehsReqs[obuIdx].size()
+   * num of chaches (uint32_t):		4 * byte
+   * vehicle cache (uint32_t):		4 * byte * vehsCaches[obuIdx].size()
+   *
+   * delta upload, against the previous upload:
+   * num of added/removed requests (uint32_t):	4 * byte * 2
+   * added/removed requests (uint32_t):		4 * byte * (reqsAdded.size() + reqsRemoved.size())
+   * num of added/removed caches (uint32_t):	4 * byte * 2
+   * added/removed caches (uint32_t):		4 * byte * (cachesAdded.size() + cachesRemoved.size())
+   */
+  std::vector<uint32_t> reqsAdded, reqsRemoved, cachesAdded, cachesRemoved;
+  uint32_t dataSize = 4 + 8 * 2 + 4 + 1;
+  if (isFull)
+    {
+      dataSize += 4 + 4 * vehsReqs[obuIdx].size() + 4 + 4 * vehsCaches[obuIdx].size();
+    }
+  else
+    {
+      std::set_difference(vehsReqs[obuIdx].begin(), vehsReqs[obuIdx].end(),
+			  vehsReqsUploaded[obuIdx].begin(), vehsReqsUploaded[obuIdx].end(),
+			  std::back_inserter(reqsAdded));
+      std::set_difference(vehsReqsUploaded[obuIdx].begin(), vehsReqsUploaded[obuIdx].end(),
+			  vehsReqs[obuIdx].begin(), vehsReqs[obuIdx].end(),
+			  std::back_inserter(reqsRemoved));
+      std::set_difference(vehsCaches[obuIdx].begin(), vehsCaches[obuIdx].end(),
+			  vehsCachesUploaded[obuIdx].begin(), vehsCachesUploaded[obuIdx].end(),
+			  std::back_inserter(cachesAdded));
+      std::set_difference(vehsCachesUploaded[obuIdx].begin(), vehsCachesUploaded[obuIdx].end(),
+			  vehsCaches[obuIdx].begin(), vehsCaches[obuIdx].end(),
+			  std::back_inserter(cachesRemoved));
+      dataSize += 4 * 4 + 4 * (reqsAdded.size() + reqsRemoved.size() + cachesAdded.size() + cachesRemoved.size());
+    }
+
+  vanet::ByteBuffer bytes(dataSize);
+  bytes.WriteU32(obuId);
+  bytes.WriteDouble(pos_obu.x);
+  bytes.WriteDouble(pos_obu.y);
+  bytes.WriteU32(seq);
+  bytes.WriteU8(isFull ? 1 : 0);
+
+  if (isFull)
+    {
+      // the number of requests
+      bytes.WriteU32(vehsReqs[obuIdx].size());
+      for (uint32_t reqData : vehsReqs[obuIdx])
+	{
+	  bytes.WriteU32(reqData);
+	}
+
+      // the number of cache
+      bytes.WriteU32(vehsCaches[obuIdx].size());
+      for (uint32_t cacheData : vehsCaches[obuIdx])
+	{
+	  bytes.WriteU32(cacheData);
+	}
+    }
+  else
+    {
+      for (const std::vector<uint32_t>* diff : {&reqsAdded, &reqsRemoved, &cachesAdded, &cachesRemoved})
+	{
+	  bytes.WriteU32(diff->size());
+	  for (uint32_t data : *diff)
+	    {
+	      bytes.WriteU32(data);
+	    }
+	}
+    }
+
+  vehsReqsUploaded[obuIdx] = vehsReqs[obuIdx];
+  vehsCachesUploaded[obuIdx] = vehsCaches[obuIdx];
+
+  Ptr<UdpSender> sender = CreateObject<UdpSender>();
+  sender->SetNode(obu);
+  sender->SetRemote(m_remoteHostAddr, m_ulPort);
+  sender->Start();
+  using vanet::PacketHeader;
+  PacketHeader header;
+  header.SetType(PacketHeader::MessageType::REQUEST);
+  sender->SetHeader(header);
+  sender->SetFill(bytes.GetBufferData(), dataSize);
+
+//  Simulator::ScheduleNow(&UdpSender::Send, sender);
+  Simulator::Schedule(Seconds(0.02 + obuIdx*0.01), &UdpSender::Send, sender);
+}
+
+void
+VanetCsVfcExperiment::ApplyVehicleUpload (vanet::ByteBuffer& bytes)
+{
+  uint32_t obuId = bytes.ReadU32();
+  uint32_t obuIdx = GetObuIndex(obuId);
+  double posX = bytes.ReadDouble();
+  double posY = bytes.ReadDouble();
+  vehsMobInfoInCloud[obuIdx] = Vector3D (posX, posY, 0);
+
+  uint32_t seq = bytes.ReadU32();
+  bool isFull = bytes.ReadU8() != 0;
+
+  if (isFull)
+    {
+      vehsReqsInCloud[obuIdx].clear();
+      uint32_t reqsSize = bytes.ReadU32();
+      for (uint32_t i = 0; i < reqsSize; i++)
+	{
+	  vehsReqsInCloud[obuIdx].insert(bytes.ReadU32());
+	}
+      vehsCachesInCloud[obuIdx].clear();
+      uint32_t cachesSize = bytes.ReadU32();
+      for (uint32_t i = 0; i < cachesSize; i++)
+	{
+	  vehsCachesInCloud[obuIdx].insert(bytes.ReadU32());
+	}
+      vehsSyncedInCloud[obuIdx] = true;
+    }
+  else
+    {
+      // a delta only applies on top of the upload right before it, otherwise
+      // wait for the next full upload of this vehicle
+      if (!vehsSyncedInCloud[obuIdx] || seq != vehsUploadSeqInCloud[obuIdx] + 1)
+	{
+	  vehsSyncedInCloud[obuIdx] = false;
+	  return;
+	}
+
+      uint32_t size = bytes.ReadU32();
+      for (uint32_t i = 0; i < size; i++)
+	{
+	  vehsReqsInCloud[obuIdx].insert(bytes.ReadU32());
+	}
+      size = bytes.ReadU32();
+      for (uint32_t i = 0; i < size; i++)
+	{
+	  vehsReqsInCloud[obuIdx].erase(bytes.ReadU32());
+	}
+      size = bytes.ReadU32();
+      for (uint32_t i = 0; i < size; i++)
+	{
+	  vehsCachesInCloud[obuIdx].insert(bytes.ReadU32());
+	}
+      size = bytes.ReadU32();
+      for (uint32_t i = 0; i < size; i++)
+	{
+	  vehsCachesInCloud[obuIdx].erase(bytes.ReadU32());
+	}
+    }
+  vehsUploadSeqInCloud[obuIdx] = seq;
+}
+
+void
+VanetCsVfcExperiment::UploadAllVehiclesInfo()
+{
+  for (NodeContainer::Iterator i = m_obuNodes.Begin (); i != m_obuNodes.End (); ++i)
+    {
+      Ptr<Node> obu = (*i);
+      uint32_t obuId = obu->GetId();
+      uint32_t obuIdx = GetObuIndex(obuId);
+
+      if (vehsEnterFlag[obuIdx] == true)
+        {
+	  UploadVehicleInfo(obu);
+        }
+      // for test
+//      UploadVehicleInfo(obu);
+    }
+}
+
+void
+VanetCsVfcExperiment::UpdateAllFogCluster()
+{
+  Ptr<Node> bs = m_remoteHost;
+  Ptr<MobilityModel> bsMobility = bs->GetObject<MobilityModel> ();
+  Vector pos_bs = bsMobility->GetPosition ();
+
+  for (uint32_t i = 0; i < m_nObuNodes; i++)
+    {
+      uint32_t obuIdx = i;
+#if Upload_Enable
+      Vector pos_obu = vehsMobInfoInCloud[obuIdx];
+#else
+      Ptr<Node> obu = m_obuNodes.Get(i);
+      Ptr<MobilityModel> obuMobility = obu->GetObject<MobilityModel> ();
+      Vector pos_obu = obuMobility->GetPosition ();
+#endif
+
+      // update the status of every vehicle
+      if (CalculateDistance (pos_obu, pos_bs) <= BS_Transmission_Range && vehsEnterFlag[obuIdx] )
+	{
+	  vehsStatus[obuIdx] = true;
+	}
+      else
+	{
+	  vehsStatus[obuIdx] = false;
+	}
+
+      // update vehicle set for every fog
+      for (uint32_t j = 0; j < m_nRsuNodes; j++)
+	{
+	  Ptr<Node> rsu = m_rsuNodes.Get(j);
+	  Ptr<MobilityModel> rsuMobility = rsu->GetObject<MobilityModel> ();
+	  Vector pos_rsu = rsuMobility->GetPosition ();
+	  if (CalculateDistance (pos_obu, pos_rsu) > Device_Transmission_Range )
+	    {
+	      fogCluster[j].erase(obuIdx);
+
+	      std::map<uint32_t, uint32_t>::iterator iter = vehIdx2FogIdxMap.find(obuIdx);
+	      if (iter != vehIdx2FogIdxMap.end() && iter->second == j)
+		{
+		  vehIdx2FogIdxMap.erase(obuIdx);
+		}
+	    }
+	  else
+	    {
+	      fogCluster[j].insert(obuIdx);
+	      vehIdx2FogIdxMap[obuIdx] = j;
+	    }
+	}
+    }
+
+  UpdateAllFogData();
+
+  if (vanet::LogIsEnabled (vanet::LOG_FOG_CLUSTER))
+    {
+      PrintFogCluster();
+    }
+
+#if Scheduling
+  if (m_tickRecorder.IsOpen ())
+    {
+      std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now ();
+      m_scheduler->OnTick();
+      RecordTick (std::chrono::duration<double> (std::chrono::steady_clock::now () - start).count ());
+    }
+  else
+    {
+      m_scheduler->OnTick();
+    }
+#endif
+}
+
+void
+VanetCsVfcExperiment::RecordTick (double schedulerTime)
+{
+  TickRecord record;
+  record.time = Now().GetSeconds();
+  record.schedulerTime = schedulerTime;
+  record.satisfiedReqs = m_requestStats.GetSatisfiedReqs();
+  record.broadcastPkts = m_requestStats.GetBroadcastPkts();
+  record.queueLength = m_requestStats.GetSubmittedReqs() - m_requestStats.GetSatisfiedReqs();
+  m_scheduler->FillTickRecord(record);
+  m_tickRecorder.Record(record);
+}
+
+void
+VanetCsVfcExperiment::UpdateAllFogData()
+{
+  if (vanet::LogIsEnabled (vanet::LOG_REQUEST))
+    {
+      for (uint32_t i = 0; i < m_nObuNodes; i++)
+	{
+	  cout << "veh:" << i << ", reqs:";
+	  for(uint32_t req : vehsReqs[i])
+	    {
+	      cout << " " << req;
+	    }
+	  cout << endl;
+	}
+    }
+
+  // update fog request set cache set
+  for (uint32_t i = 0; i < m_nRsuNodes; i++)
+    {
+      fogsCaches[i].clear();
+      fogsReqs[i].clear();
+      std::set<uint32_t> vehSet = fogCluster[i];
+      for (uint32_t veh : vehSet)
+	{
+#if Upload_Enable
+	  fogsCaches[i].insert(vehsCachesInCloud[veh].begin(), vehsCachesInCloud[veh].end());
+	  fogsReqs[i].insert(vehsReqsInCloud[veh].begin(), vehsReqsInCloud[veh].end());
+#else
+	  fogsCaches[i].insert(vehsCaches[veh].begin(), vehsCaches[veh].end());
+	  fogsReqs[i].insert(vehsReqs[veh].begin(), vehsReqs[veh].end());
+#endif
+	}
+    }
+}
+
+void
+VanetCsVfcExperiment::PrintFogCluster()
+{
+  if (m_log != 0)
+  {
+    std::cout << Simulator::Now() << endl;
+    for (uint32_t i = 0; i < m_nRsuNodes; i++)
+      {
+	std::cout << "fogCluster[" << i << "]:";
+#if 1
+	for (uint32_t id : fogCluster[i])
+	  {
+	    std::cout << " " << id;
+	  }
+	std::cout << endl;
+#endif
+#if 0
+	std::cout << endl;
+	std::cout << "req:";
+	for (uint32_t req : fogsReqs[i])
+	  {
+	    std::cout << " " << req;
+	  }
+	std::cout << endl;
+	std::cout << "cache:";
+	for (uint32_t cache : fogsCaches[i])
+	  {
+	    std::cout << " " << cache;
+	  }
+	std::cout << endl;
+#endif
+      }
+    std::cout << endl;
+  }
+}
+
+void VanetCsVfcExperiment::RecordStats (uint32_t obuIdx, uint32_t dataIdx)
+{
+  std::map<uint32_t, RequestStatus>::iterator it = vehsReqsStatus[obuIdx].find(dataIdx);
+  NS_ASSERT_MSG(it != vehsReqsStatus[obuIdx].end(), "iter == end()");
+  if (it->second.completed) return;
+  it->second.completed = true;
+  it->second.satisfiedTime = Now().GetDouble();
+
+  double delay = it->second.satisfiedTime - it->second.submitTime;
+  m_requestStats.IncSatisfiedReqs();
+  m_requestStats.IncCumulativeDelay(delay);
+
+  // delays of vehicles outside every fog go to the last histogram
+  std::map<uint32_t, uint32_t>::const_iterator fog = vehIdx2FogIdxMap.find(obuIdx);
+  uint32_t fogIdx = fog != vehIdx2FogIdxMap.end() ? fog->second : m_nRsuNodes;
+  fogsDelayHistogram[fogIdx].Record(delay > 0 ? (uint64_t) delay : 0);
+}
+
+static const char *Checkpoint_Magic = "vanet-cs-vfc checkpoint";
+static const uint32_t Checkpoint_Version = 1;
+
+void
+VanetCsVfcExperiment::SaveCheckpoint ()
+{
+  std::ostringstream oss;
+  oss << m_checkpointFile << "-" << (uint32_t) Now().GetSeconds() << ".ckpt";
+  vanet::CheckpointWriter writer (oss.str());
+
+  writer.Write (std::string (Checkpoint_Magic));
+  writer.Write (Checkpoint_Version);
+  writer.Write (m_schemeName);
+  writer.Write (m_nObuNodes);
+  writer.Write (m_nRsuNodes);
+  writer.Write (globalDbSize);
+  writer.Write (RngSeedManager::GetSeed());
+  writer.Write (static_cast<uint64_t> (RngSeedManager::GetRun()));
+  writer.Write (static_cast<int64_t> (Now().GetTimeStep()));
+  writer.Write (m_tick);
+
+  // the initial request and cache sets are drawn again from the seed and run
+  writer.Write (vehsEnterFlag);
+  writer.Write (vehsStatus);
+  writer.Write (isFirstSubmit);
+  writer.Write (vehsReqs);
+  writer.Write (vehsCaches);
+  writer.Write (vehsReqsStatus);
+  writer.Write (vehIdx2FogIdxMap);
+
+  writer.Write (vehsReqsUploaded);
+  writer.Write (vehsCachesUploaded);
+  writer.Write (vehsUploadSeq);
+  writer.Write (vehsReqsInCloud);
+  writer.Write (vehsCachesInCloud);
+  writer.Write (vehsUploadSeqInCloud);
+  writer.Write (vehsSyncedInCloud);
+  writer.Write (vehsReqsStasInCloud);
+  writer.Write (vehsMobInfoInCloud);
+
+  writer.Write (fogCluster);
+  writer.Write (fogsReqs);
+  writer.Write (fogsCaches);
+  for (const DelayHistogram& histogram : fogsDelayHistogram)
+    {
+      histogram.Save (writer);
+    }
+  m_requestStats.Save (writer);
+  writer.Write (currentBroadcastId);
+  writer.Write (receive_count);
+
+  // scheme state last, a run of another scheme stops reading before it
+  m_scheduler->Save (writer);
+  writer.Commit ();
+
+  std::cout << "sim time:" << Now().GetSeconds() << ", event: checkpoint " << oss.str() << std::endl;
+}
+
+void
+VanetCsVfcExperiment::ReadCheckpointHeader (vanet::CheckpointReader& reader, std::string& schemeName)
+{
+  std::string magic;
+  uint32_t version;
+  reader.Read (magic);
+  reader.Read (version);
+  if (magic != Checkpoint_Magic || version != Checkpoint_Version)
+    {
+      NS_FATAL_ERROR (reader.GetFileName() << " is not a version " << Checkpoint_Version << " checkpoint");
+    }
+
+  uint32_t nObuNodes, nRsuNodes, dbSize, seed;
+  uint64_t run;
+  int64_t timeStep;
+  reader.Read (schemeName);
+  reader.Read (nObuNodes);
+  reader.Read (nRsuNodes);
+  reader.Read (dbSize);
+  reader.Read (seed);
+  reader.Read (run);
+  reader.Read (timeStep);
+  reader.Read (m_tick);
+  if (nObuNodes != m_nObuNodes || nRsuNodes != m_nRsuNodes || dbSize != globalDbSize)
+    {
+      NS_FATAL_ERROR ("checkpoint " << reader.GetFileName() << " was written with nNodes=" << nObuNodes
+		      << ", " << nRsuNodes << " fog nodes and globalDbSize=" << dbSize);
+    }
+  if (seed != RngSeedManager::GetSeed() || run != RngSeedManager::GetRun())
+    {
+      NS_LOG_UNCOND ("Restoring " << reader.GetFileName() << ": using its RngSeed=" << seed << " RngRun=" << run);
+      RngSeedManager::SetSeed (seed);
+      RngSeedManager::SetRun (run);
+    }
+  m_firstTickTime = TimeStep (timeStep);
+}
+
+void
+VanetCsVfcExperiment::RestoreCheckpoint ()
+{
+  vanet::CheckpointReader reader (m_restoreFile);
+  std::string schemeName;
+  ReadCheckpointHeader (reader, schemeName);
+
+  reader.Read (vehsEnterFlag);
+  reader.Read (vehsStatus);
+  reader.Read (isFirstSubmit);
+  reader.Read (vehsReqs);
+  reader.Read (vehsCaches);
+  reader.Read (vehsReqsStatus);
+  reader.Read (vehIdx2FogIdxMap);
+
+  reader.Read (vehsReqsUploaded);
+  reader.Read (vehsCachesUploaded);
+  reader.Read (vehsUploadSeq);
+  reader.Read (vehsReqsInCloud);
+  reader.Read (vehsCachesInCloud);
+  reader.Read (vehsUploadSeqInCloud);
+  reader.Read (vehsSyncedInCloud);
+  reader.Read (vehsReqsStasInCloud);
+  reader.Read (vehsMobInfoInCloud);
+
+  reader.Read (fogCluster);
+  reader.Read (fogsReqs);
+  reader.Read (fogsCaches);
+  for (DelayHistogram& histogram : fogsDelayHistogram)
+    {
+      histogram.Load (reader);
+    }
+  m_requestStats.Load (reader);
+  reader.Read (currentBroadcastId);
+  reader.Read (receive_count);
+
+  if (schemeName == m_schemeName)
+    {
+      m_scheduler->Load (reader);
+    }
+  else
+    {
+      // branch to another scheme: its scheduler starts fresh from the
+      // restored caches and is handed every request still open
+      m_scheduler->RebuildFromCaches();
+      for (uint32_t obuIdx = 0; obuIdx < m_nObuNodes; obuIdx++)
+	{
+	  if (isFirstSubmit[obuIdx]) continue;
+	  for (uint32_t reqIdx : vehsReqs[obuIdx])
+	    {
+	      m_scheduler->OnSubmit(obuIdx, reqIdx);
+	    }
+	}
+    }
+
+  NS_LOG_UNCOND ("Restored " << m_restoreFile << " (" << schemeName << "), first tick at " << m_firstTickTime.GetSeconds() << "s");
+}
+
+void
+VanetCsVfcExperiment::CommandSetup (int argc, char **argv)
+{
+  CommandLine cmd;
+
+  // allow command line overrides
+//  cmd.AddValue ("CSVfileName", "The name of the CSV output file name", m_CSVfileName);
+//  cmd.AddValue ("CSVfileName2", "The name of the CSV output file name2", m_CSVfileName2);
+  cmd.AddValue ("totaltime", "Simulation end time", m_TotalSimTime);
+  cmd.AddValue ("nNodes", "Number of nodes (i.e. vehicles)", m_nObuNodes);
+  cmd.AddValue ("txp", "Transmit power (dB), e.g. txp=7.5", m_obuTxp);
+//  cmd.AddValue ("traceMobility", "Enable mobility tracing", m_traceMobility);
+  cmd.AddValue ("phyMode", "Wifi Phy mode", m_phyMode);
+  cmd.AddValue ("traceFile", "Ns2 movement trace file, or waypoint trace written by convert-mobility.py", m_mobilityFile);
+  cmd.AddValue ("mobTraceFile", "Mobility Trace file", m_mobLogFile);
+  cmd.AddValue ("rate", "Rate", m_rate);
+  cmd.AddValue ("verbose", "0=quiet;1=verbose", m_verbose);
+  cmd.AddValue ("bsm", "(WAVE) BSM size (bytes)", m_wavePacketSize);
+  cmd.AddValue ("interval", "(WAVE) BSM interval (s)", m_waveInterval);
+
+  cmd.AddValue ("asciiTrace", "Dump ASCII Trace data", m_asciiTrace);
+  cmd.AddValue ("pcap", "Create PCAP files for all nodes", m_pcap);
+
+  cmd.AddValue ("nVeh", "number of vehicles", m_nObuNodes);
+  cmd.AddValue ("schemeName", "scheduling algorithm name", m_schemeName);
+  cmd.AddValue ("globalDbSize", "size of global database", globalDbSize);
+  cmd.AddValue ("tickStats", "file receiving the statistics of every scheduling tick, disabled if empty", m_tickStatsFile);
+  cmd.AddValue ("tickStatsBinary", "write the tick statistics as raw TickRecord structs instead of CSV", m_tickStatsBinary);
+  cmd.AddValue ("resultFile", "file receiving the result line of this run: scheme nNodes run dbSize ASD SR BE P50 P95 P99 Max", m_resultFile);
+  cmd.AddValue ("log", "log categories separated by '|', e.g. \"cliques|fog-cluster\", \"all\" or \"none\"", m_logCategories);
+  cmd.AddValue ("checkpoint", "prefix of the checkpoints <prefix>-<time>.ckpt, written every checkpointPeriod ticks, disabled if empty", m_checkpointFile);
+  cmd.AddValue ("checkpointPeriod", "scheduling ticks between two checkpoints", m_checkpointPeriod);
+  cmd.AddValue ("restore", "checkpoint to start from, mobility is fast-forwarded to its time", m_restoreFile);
+
+  cmd.Parse (argc, argv);
+
+  vanet::LogSetCategories (m_logCategories);
+
+  NS_ASSERT_MSG (m_checkpointPeriod > 0, "checkpointPeriod must be positive");
+  if (!m_restoreFile.empty())
+    {
+      vanet::CheckpointReader reader (m_restoreFile);
+      std::string schemeName;
+      ReadCheckpointHeader (reader, schemeName);
+    }
+
+  NS_ASSERT_MSG((m_schemeName.compare(Scheme_1) == 0 || m_schemeName.compare(Scheme_2) == 0 || m_schemeName.compare(Scheme_3) == 0), "scheme name must be \"cs-vfc\", \"ncb\" or \"genetic\"");
+}
+
+void
+VanetCsVfcExperiment::SetupTraceFile ()
+{
+  if (m_traceMobility)
+    {
+//      // open trace file for output
+//      m_os.open (m_mobLogFile.c_str ());
+//
+//      // Configure callback for logging
+//      Config::Connect ("/NodeList/*/$ns3::MobilityModel/CourseChange",
+//		       MakeBoundCallback (&VanetCsVfcExperiment::CourseChange, &m_os));
+
+      AsciiTraceHelper ascii;
+      MobilityHelper::EnableAsciiAll (ascii.CreateFileStream (m_trName));
+    }
+}
+
+void
+VanetCsVfcExperiment::SetupLogging ()
+{
+  if (m_log != 0)
+    {
+//      // open trace file for output
+//      m_os.open (m_mobLogFile.c_str ());
+
+      // Enable logging from the ns2 helper
+      LogComponentEnable ("Ns2MobilityHelper",LOG_LEVEL_DEBUG);
+
+      Packet::EnablePrinting ();
+    }
+}
+
+void
+VanetCsVfcExperiment::ConfigureDefaults ()
+{
+  Config::SetDefault ("ns3::OnOffApplication::PacketSize",StringValue ("64"));
+  Config::SetDefault ("ns3::OnOffApplication::DataRate",  StringValue (m_rate));
+
+  //Set Non-unicastMode rate to unicast mode
+//  Config::SetDefault ("ns3::WifiRemoteStationManager::NonUnicastMode",StringValue (m_phyMode));
+}
+
+void
+VanetCsVfcExperiment::SetupDevices ()
+{
+  YansWifiChannelHelper wifiChannel1 = YansWifiChannelHelper::Default ();
+  wifiChannel1.SetPropagationDelay ("ns3::ConstantSpeedPropagationDelayModel");
+  wifiChannel1.AddPropagationLoss ("ns3::FriisPropagationLossModel", "Frequency", DoubleValue (5.9e9));
+
+  YansWifiPhyHelper wifiPhy1 =  YansWifiPhyHelper::Default ();
+  Ptr<YansWifiChannel> channel1 = wifiChannel1.Create ();
+  wifiPhy1.SetChannel (channel1);
+  // ns-3 supports generate a pcap trace
+  wifiPhy1.SetPcapDataLinkType (WifiPhyHelper::DLT_IEEE802_11);
+  NqosWaveMacHelper wifi80211pMac1 = NqosWaveMacHelper::Default ();
+  Wifi80211pHelper wifi80211p1 = Wifi80211pHelper::Default ();
+  if (m_verbose)
+    {
+      wifi80211p1.EnableLogComponents ();      // Turn on all Wifi 802.11p logging
+    }
+
+  wifi80211p1.SetRemoteStationManager ("ns3::ConstantRateWifiManager",
+                                      "DataMode",StringValue (m_phyMode),
+                                      "ControlMode",StringValue (m_phyMode));
+
+  // OBU 802.11p
+  wifiPhy1.Set ("TxPowerStart",DoubleValue (m_obuTxp));
+  wifiPhy1.Set ("TxPowerEnd", DoubleValue (m_obuTxp));
+  m_obuDevices = wifi80211p1.Install (wifiPhy1, wifi80211pMac1, m_obuNodes);
+
+  // RSU 802.11p
+  wifiPhy1.Set ("TxPowerStart",DoubleValue (m_rsuTxp));
+  wifiPhy1.Set ("TxPowerEnd", DoubleValue (m_rsuTxp));
+  m_rsu80211pDevices = wifi80211p1.Install (wifiPhy1, wifi80211pMac1, m_rsuNodes);
+
+  // RSU CSMA
+  CsmaHelper csmaHelper;
+  csmaHelper.SetChannelAttribute ("DataRate", StringValue ("5Mbps"));
+  csmaHelper.SetChannelAttribute ("Delay", StringValue ("2ms"));
+  m_rsuCsmaDevices = csmaHelper.Install(m_rsuNodes);
+
+  InternetStackHelper internet;
+  internet.Install(m_obuNodes);
+  internet.Install(m_rsuNodes);
+
+  Ipv4AddressHelper addressHelper;
+//  // Assign Ip to OBUs and RSUs
+//  NS_LOG_UNCOND ("Assigning IP addresses");
+//  // we may have a lot of nodes, and want them all
+//  // in same subnet, to support broadcast
+//  addressHelper.SetBase ("10.2.0.0", "255.255.0.0");
+//  m_obuInterfaces = addressHelper.Assign (m_obuDevices);
+//  m_rsu80211pInterfaces = addressHelper.Assign (m_rsu80211pDevices);
+
+  addressHelper.SetBase ("192.168.0.0", "255.255.0.0");
+  m_rsuCsmaInterfaces = addressHelper.Assign (m_rsuCsmaDevices);
+  // Tracing
+//  wifiPhy.EnablePcap ("wave-simple-80211p", devices);
+
+  // configure mobility
+  SetupObuMobilityNodes ();
+  SetupRsuMobilityNodes ();
+
+#if Lte_Enable
+  // -------------------------------------------LTE----------------------------------------------------
+  Config::SetDefault ("ns3::LteEnbRrc::SrsPeriodicity",UintegerValue (320));
+
+  m_lteHelper = CreateObject<LteHelper> ();
+  m_epcHelper = CreateObject<PointToPointEpcHelper> ();
+  m_lteHelper->SetEpcHelper (m_epcHelper);
+
+  m_pgw = m_epcHelper->GetPgwNode ();
+
+   // Create a single RemoteHost
+  m_remoteHostNodes.Create (1);
+  m_remoteHost = m_remoteHostNodes.Get (0);
+  internet.Install (m_remoteHostNodes);
+
+  // Create the Internet
+  PointToPointHelper p2ph;
+  p2ph.SetDeviceAttribute ("DataRate", DataRateValue (DataRate ("100Gb/s")));
+  p2ph.SetDeviceAttribute ("Mtu", UintegerValue (1500));
+  p2ph.SetChannelAttribute ("Delay", TimeValue (Seconds (0.010)));
+  NetDeviceContainer internetDevices = p2ph.Install (m_pgw, m_remoteHost);
+  addressHelper.SetBase ("1.0.0.0", "255.0.0.0");
+  Ipv4InterfaceContainer internetIpIfaces = addressHelper.Assign (internetDevices);
+  // interface 0 is localhost, 1 is the p2p device
+  m_remoteHostAddr = internetIpIfaces.GetAddress (1);
+
+  Ipv4StaticRoutingHelper ipv4RoutingHelper;
+  Ptr<Ipv4StaticRouting> remoteHostStaticRouting = ipv4RoutingHelper.GetStaticRouting (m_remoteHost->GetObject<Ipv4> ());
+  remoteHostStaticRouting->AddNetworkRouteTo (Ipv4Address ("7.0.0.0"), Ipv4Mask ("255.0.0.0"), 1);
+
+  m_enbNodes.Create(1);
+  m_ueNodes.Add(m_obuNodes);
+
+  // configure mobility
+  MobilityHelper mobility;
+  Ptr<ListPositionAllocator> positionAlloc3 = CreateObject<ListPositionAllocator> ();
+  positionAlloc3->Add (Vector (1800.0, 1800.0, 0.0));
+  mobility.SetPositionAllocator (positionAlloc3);
+  mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  mobility.Install (m_remoteHost);
+
+  positionAlloc3 = CreateObject<ListPositionAllocator> ();
+  positionAlloc3->Add (Vector (1800.0, 1600.0, 0.0));
+  mobility.SetPositionAllocator (positionAlloc3);
+  mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  mobility.Install (m_pgw);
+
+  positionAlloc3 = CreateObject<ListPositionAllocator> ();
+  positionAlloc3->Add (Vector (1600, 1600, 0.0));
+  mobility.SetPositionAllocator (positionAlloc3);
+  mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  mobility.Install (m_enbNodes);
+
+  // Install LTE Devices to the nodes
+  NetDeviceContainer m_enbLteDevices = m_lteHelper->InstallEnbDevice (m_enbNodes);
+  NetDeviceContainer m_ueLteDevices = m_lteHelper->InstallUeDevice (m_ueNodes);
+
+  // Assign Ip to UE
+  m_ueInterface = m_epcHelper->AssignUeIpv4Address (m_ueLteDevices);
+
+  for (uint32_t u = 0; u < m_ueNodes.GetN (); ++u)
+    {
+      Ptr<Node> ueNode = m_ueNodes.Get (u);
+      // Set the default gateway for the UE
+      Ptr<Ipv4StaticRouting> ueStaticRouting = ipv4RoutingHelper.GetStaticRouting (ueNode->GetObject<Ipv4> ());
+      ueStaticRouting->SetDefaultRoute (m_epcHelper->GetUeDefaultGatewayAddress (), 1);
+    }
+
+  // Attach one UE to eNodeB
+  m_lteHelper->Attach (m_ueLteDevices);  // side effect: the default EPS bearer will be activated
+#else
+  // Create a single RemoteHost
+  m_remoteHostNodes.Create (1);
+  m_remoteHost = m_remoteHostNodes.Get (0);
+
+  m_ueNodes.Add(m_obuNodes);
+
+  MobilityHelper mobility;
+  Ptr<ListPositionAllocator> positionAlloc = CreateObject<ListPositionAllocator> ();
+  positionAlloc->Add (Vector (1600.0, 1600.0, 0.0));
+  mobility.SetPositionAllocator (positionAlloc);
+  mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  mobility.Install (m_remoteHost);
+
+  // BS
+  YansWifiChannelHelper wifiChannel2 = YansWifiChannelHelper::Default ();
+  wifiChannel2.SetPropagationDelay ("ns3::ConstantSpeedPropagationDelayModel");
+  wifiChannel2.AddPropagationLoss ("ns3::FriisPropagationLossModel", "Frequency", DoubleValue (5e9));
+
+  YansWifiPhyHelper wifiPhy2 =  YansWifiPhyHelper::Default ();
+  Ptr<YansWifiChannel> channel2 = wifiChannel2.Create ();
+  wifiPhy2.SetChannel (channel2);
+  // ns-3 supports generate a pcap trace
+  wifiPhy2.SetPcapDataLinkType (WifiPhyHelper::DLT_IEEE802_11);
+  NqosWaveMacHelper wifi80211pMac2 = NqosWaveMacHelper::Default ();
+  Wifi80211pHelper wifi80211p2 = Wifi80211pHelper::Default ();
+
+
+  wifi80211p2.SetRemoteStationManager ("ns3::ConstantRateWifiManager",
+                                      "DataMode",StringValue (m_phyMode),
+                                      "ControlMode",StringValue (m_phyMode));
+
+  wifiPhy2.Set ("TxPowerStart",DoubleValue (m_bsTxp));
+  wifiPhy2.Set ("TxPowerEnd", DoubleValue (m_bsTxp));
+  NetDeviceContainer remoteDev = wifi80211p1.Install (wifiPhy2, wifi80211pMac2, m_remoteHostNodes);
+
+  internet.Install (m_remoteHostNodes);
+//  addressHelper.SetBase ("1.0.0.0", "255.0.0.0");
+  addressHelper.SetBase ("10.2.0.0", "255.255.0.0");
+  Ipv4InterfaceContainer internetIpIfaces = addressHelper.Assign (remoteDev);
+  m_remoteHostAddr = internetIpIfaces.GetAddress (0);
+
+//  Ipv4StaticRoutingHelper ipv4RoutingHelper;
+//  Ptr<Ipv4StaticRouting> remoteHostStaticRouting = ipv4RoutingHelper.GetStaticRouting (m_remoteHost->GetObject<Ipv4> ());
+//  remoteHostStaticRouting->AddNetworkRouteTo (Ipv4Address ("10.2.0.0"), Ipv4Mask ("255.255.0.0"), 1);
+
+  // OBU 802.11p NetDevice communicating with BS
+  wifiPhy2.Set ("TxPowerStart",DoubleValue (m_bsTxp));
+  wifiPhy2.Set ("TxPowerEnd", DoubleValue (m_bsTxp));
+  NetDeviceContainer m_ueLteDevices = wifi80211p2.Install (wifiPhy2, wifi80211pMac2, m_ueNodes);
+  m_ueInterface = addressHelper.Assign (m_ueLteDevices);
+#endif
+
+  // DSRC's ip address assignment must be placed after "epcHelper->AssignUeIpv4Address", otherwise UE's upload line will be invalid, why??????
+  // Assign Ip to OBUs and RSUs
+  // we may have a lot of nodes, and want them all
+  // in same subnet, to support broadcast
+  addressHelper.SetBase ("10.3.0.0", "255.255.0.0");
+  m_rsu80211pInterfaces = addressHelper.Assign (m_rsu80211pDevices);
+  m_obuInterfaces = addressHelper.Assign (m_obuDevices);
+}
+
+void
+VanetCsVfcExperiment::AssignIpAddresses ()
+{
+  // todo
+}
+void
+VanetCsVfcExperiment::SetupObuMobilityNodes ()
+{
+  if (vanet::WaypointTrace::IsWaypointTrace (m_mobilityFile))
+    {
+      // preprocessed by convert-mobility.py, mapped instead of parsed
+      vanet::BinaryMobilityHelper binary (m_mobilityFile);
+      binary.Install (m_obuNodes.Begin(), m_obuNodes.End());
+    }
+  else
+    {
+      // Create Ns2MobilityHelper with the specified trace log file as parameter
+      Ns2MobilityHelper ns2 = Ns2MobilityHelper (m_mobilityFile);
+      ns2.Install (m_obuNodes.Begin(), m_obuNodes.End()); // configure movements for each OBU node, while reading trace file
+    }
+
+//  nodesMoving.resize (m_nObuNodes, 0);
+
+  // connect every model directly, with the OBU index bound, instead of
+  // resolving a config path per node
+  for (uint32_t i = 0; i < m_nObuNodes; i++)
+    {
+      Ptr<MobilityModel> model = m_obuNodes.Get(i)->GetObject<MobilityModel> ();
+      model->TraceConnectWithoutContext ("CourseChange", MakeBoundCallback (&VanetCsVfcExperiment::CourseChangeOnObu, this, i));
+    }
+}
+
+void
+VanetCsVfcExperiment::SetupRsuMobilityNodes ()
+{
+  MobilityHelper mobility;
+  Ptr<ListPositionAllocator> positionAlloc = CreateObject<ListPositionAllocator> ();
+  int size = 4;
+  double base = -300.0;
+  double x = base, y = base, delta = 1000.0;
+  for (int i = 0; i < size; i++)
+    {
+      x = x + delta;
+      y = base;
+      for (int j = 0; j < size; j++)
+	{
+	  y = y + delta;
+	  positionAlloc->Add (Vector (x, y, 0.0));
+	}
+    }
+  mobility.SetPositionAllocator (positionAlloc);
+  mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  mobility.Install (m_rsuNodes);
+}
+
+Ptr<Socket>
+VanetCsVfcExperiment::SetupPacketSink (Ipv4Address addr, uint16_t port, Ptr<Node> node)
+{
+  TypeId tid = TypeId::LookupByName ("ns3::UdpSocketFactory");
+  Ptr<Socket> sink = Socket::CreateSocket (node, tid);
+  InetSocketAddress local = InetSocketAddress (addr, port);
+  sink->Bind (local);
+  sink->SetRecvCallback (MakeCallback (&VanetCsVfcExperiment::ReceivePacket, this));
+
+  return sink;
+}
+
+void
+VanetCsVfcExperiment::SetupMessages ()
+{
+//  // Setup routing transmissions
+//  OnOffHelper onoff ("ns3::UdpSocketFactory",Address ());
+//  onoff.SetAttribute ("OnTime", StringValue ("ns3::ConstantRandomVariable[Constant=1.0]"));
+//  onoff.SetAttribute ("OffTime", StringValue ("ns3::ConstantRandomVariable[Constant=1.0]"));
+//
+//  // Setup OBU sink on 80211p devices
+//  for (uint32_t i = 0; i < m_nObuNodes; i++)
+//    {
+//      Ptr<Socket> sink = SetupPacketSink (Ipv4Address::GetAny (), m_port, m_obuNodes.Get (i));
+//    }
+//
+//  // Setup RSU sink on CSMA devices
+//  for (uint32_t i = 0; i < m_nRsuNodes; i++)
+//    {
+//      Ptr<Socket> sink = SetupPacketSink (m_rsuCsmaInterfaces.GetAddress(i), m_port, m_rsuNodes.Get (i));
+//    }
+//
+//  // test RSU broadcast
+//  Ptr<UniformRandomVariable> var = CreateObject<UniformRandomVariable> ();
+//  for (uint32_t i = 0; i < m_nRsuNodes; i++)
+//    {
+//      var->SetStream (i);
+//      AddressValue remoteAddress (InetSocketAddress ("10.2.255.255", m_port));
+//      onoff.SetAttribute ("Remote", remoteAddress);
+//
+//      ApplicationContainer temp = onoff.Install (m_rsuNodes.Get (i));
+//      temp.Start (Seconds (var->GetValue (1.0,2.0)));
+//      temp.Stop (Seconds (m_TotalSimTime));
+//    }
+//
+//  // test LTE message
+//  uint16_t dlPort = 1234;
+//  for (uint32_t i =0; i < m_nRsuNodes; i++)
+//    {
+//      Ptr<Socket> sink = SetupPacketSink (Ipv4Address::GetAny(), dlPort, m_ueNodes.Get (i));
+//    }
+//  Ptr<UniformRandomVariable> var1 = CreateObject<UniformRandomVariable> ();
+//  for (uint32_t i = 0; i < m_ueInterface.GetN(); i++)
+//    {
+//      var1->SetStream (i);
+//      InetSocketAddress dest = InetSocketAddress (m_ueInterface.GetAddress(i), dlPort);
+//      onoff.SetAttribute ("Remote", AddressValue(dest));
+//      ApplicationContainer temp = onoff.Install (m_remoteHostNodes.Get(0));
+//      temp.Start (Seconds (var1->GetValue (1.0,2.0)));
+//      temp.Stop (Seconds (10));
+//    }
+
+  std::cout << "sim time:" << Simulator::Now().GetSeconds() << ", event: send data." << std::endl;
+
+  Ptr<UdpSender> sender = CreateObject<UdpSender>();
+  sender->SetNode(m_remoteHost);
+  sender->SetRemote(Ipv4Address ("10.2.255.255"), m_dlPort);
+  sender->SetDataSize(Packet_Size);
+  sender->Start();
+  using vanet::PacketHeader;
+  PacketHeader header;
+  header.SetType(PacketHeader::MessageType::DATA_C2V);
+  sender->SetHeader(header);
+
+  /**
+   * broadcast data size (uint32_t):	4 * byte
+   * broadcast data (uint32_t):		4 * byte * broadcastData.size()
+   */
+  uint32_t dataSize = 4 + 4;
+  vanet::ByteBuffer bytes(dataSize);
+  bytes.WriteU32(1);
+  bytes.WriteU32(static_cast<uint32_t>(Simulator::Now().GetSeconds()));
+  sender->SetFill(bytes.GetBufferData(), dataSize);
+  Simulator::ScheduleNow (&UdpSender::Send, sender);
+}
+
+static inline std::string
+PrintReceivedPacket (Ptr<Socket> socket, Ptr<Packet> packet, Address srcAddress)
+{
+  std::ostringstream oss;
+
+  oss << "time=" << Simulator::Now ().GetSeconds () << "s " << "node " << socket->GetNode ()->GetId ();
+
+  if (InetSocketAddress::IsMatchingType (srcAddress))
+    {
+      InetSocketAddress addr = InetSocketAddress::ConvertFrom (srcAddress);
+      oss << " received one packet from " << addr.GetIpv4 ();
+    }
+  else
+    {
+      oss << " received one packet!";
+    }
+  return oss.str ();
+}
+
+void
+VanetCsVfcExperiment::ReceivePacket (Ptr<Socket> socket)
+{
+  Ptr<Packet> packet;
+  Address srcAddress;
+  while ((packet = socket->RecvFrom (srcAddress)))
+    {
+      uint32_t RxRoutingBytes = packet->GetSize ();
+      m_routingStats.IncRxBytes (RxRoutingBytes);
+      m_routingStats.IncRxPkts ();
+      if (m_log != 0)
+        {
+          NS_LOG_UNCOND ("protocol=" << m_protocolName + " " + PrintReceivedPacket (socket, packet, srcAddress));
+        }
+    }
+}
+
+void
+VanetCsVfcExperiment::ReceivePacketOnNode (VanetCsVfcExperiment *experiment, uint32_t nodeId, Ptr<const Packet> packet, const Address & srcAddr, const Address & destAddr)
+{
+  experiment->ReceivePacketWithAddr (nodeId, packet, srcAddr, destAddr);
+}
+
+void
+VanetCsVfcExperiment::ReceivePacketWithAddr (uint32_t nodeId, Ptr<const Packet> packet, const Address & srcAddr, const Address & destAddr)
+{
+  receive_count++;
+
+  m_scheduler->OnReceive (nodeId, packet, srcAddr, destAddr);
+}
+
+void
+VanetCsVfcExperiment::OnOffTrace (std::string context, Ptr<const Packet> packet)
+{
+  uint32_t pktBytes = packet->GetSize ();
+  m_routingStats.IncTxBytes (pktBytes);
+}
+
+void
+VanetCsVfcExperiment::Initialization ()
+{
+  m_wifiPhyStats = CreateObject<WifiPhyStats> ();
+
+  globalDB.resize(globalDbSize);
+  vehsEnterFlag.resize(m_nObuNodes, false);
+  vehsStatus.resize(m_nObuNodes, false);
+
+  vehsInitialReqs.resize(m_nObuNodes);
+  vehsInitialCaches.resize(m_nObuNodes);
+  vehsReqs.resize(m_nObuNodes);
+  vehsReqsStatus.resize(m_nObuNodes);
+  vehsCaches.resize(m_nObuNodes);
+
+  vehsReqsUploaded.resize(m_nObuNodes);
+  vehsCachesUploaded.resize(m_nObuNodes);
+  vehsUploadSeq.resize(m_nObuNodes, 0);
+
+  vehsReqsInCloud.resize(m_nObuNodes);
+  vehsReqsStasInCloud.resize(m_nObuNodes);
+  vehsCachesInCloud.resize(m_nObuNodes);
+  vehsMobInfoInCloud.resize(m_nObuNodes);
+  vehsUploadSeqInCloud.resize(m_nObuNodes, 0);
+  vehsSyncedInCloud.resize(m_nObuNodes, false);
+
+  fogCluster.resize(m_nRsuNodes);
+  fogsCaches.resize(m_nRsuNodes);
+  fogsReqs.resize(m_nRsuNodes);
+  fogsDelayHistogram.resize(m_nRsuNodes + 1);
+
+  isFirstSubmit.resize(m_nObuNodes, true);
+
+  // Initializing global data base
+  for (uint32_t i = 0; i < globalDbSize; i++)
+    {
+      globalDB[i] = i;
+    }
+
+  // Initializing vehicle cache and request set
+#if 1
+  Ptr<UniformRandomVariable> urv = CreateObject<UniformRandomVariable>();
+  for (uint32_t i = 0; i < m_nObuNodes; i++)
+    {
+      urv->SetStream(i);
+      uint32_t minLocalSize = globalDbSize / 5;
+      uint32_t maxLocalSize = minLocalSize * 1.5;
+      uint32_t localSize = (uint32_t)(urv->GetValue(minLocalSize, maxLocalSize));
+      std::set<uint32_t> vehReq(globalDB.begin(), globalDB.end());
+      std::set<uint32_t> vehCache;
+      for (uint32_t j = 1; j <= localSize; j++)
+	{
+	  uint32_t cacheIdx = (uint32_t)(urv->GetValue(0, globalDbSize));
+	  uint32_t data = globalDB[cacheIdx];
+	  vehCache.insert(data);
+	  vehReq.erase(data);
+	}
+      vehsInitialCaches[i] = vehCache;
+      vehsInitialReqs[i] = vehReq;
+    }
+#endif
+
+#if 0
+  // for testing
+  for (uint32_t i = 0; i < m_nObuNodes; i++)
+    {
+//      uint32_t localSize = (uint32_t)(globalDbSize / 5);
+      uint32_t localSize = (uint32_t)(globalDbSize - 2);
+      std::set<uint32_t> vehReq(globalDB.begin(), globalDB.end());
+      std::set<uint32_t> vehCache;
+      for (uint32_t j = 1; j <= localSize; j++)
+	{
+	  uint32_t cacheIdx = j - 1;
+	  uint32_t data = globalDB[cacheIdx];
+	  vehCache.insert(data);
+	  vehReq.erase(data);
+	}
+      vehsCaches[i] = vehCache;
+      vehsReqs[i] = vehReq;
+    }
+#endif
+
+  if (vanet::LogIsEnabled (vanet::LOG_INITIAL_REQUEST))
+    {
+      for (uint32_t i = 0; i < m_nObuNodes; i++)
+	{
+	  cout << "veh:" << i << ", init reqs:";
+	  for(uint32_t req : vehsInitialReqs[i])
+	    {
+	      cout << " " << req;
+	    }
+	  cout << endl;
+	}
+    }
+
+  if (vanet::LogIsEnabled (vanet::LOG_INITIAL_CACHE))
+    {
+      for (uint32_t i = 0; i < m_nObuNodes; i++)
+	{
+	  cout << "veh:" << i << ", init caches:";
+	  for(uint32_t cache : vehsInitialCaches[i])
+	    {
+	      cout << " " << cache;
+	    }
+	  cout << endl;
+	}
+    }
+
+  // created last, scheme "ma" builds its cache matrix from the initial caches
+  m_scheduler = vanet::BroadcastScheduler::Create(m_schemeName, this);
+
+  if (!m_restoreFile.empty())
+    {
+      RestoreCheckpoint ();
+    }
+
+  if (!m_tickStatsFile.empty())
+    {
+      m_tickRecorder.Open(m_tickStatsFile, m_tickStatsBinary);
+    }
+}
+
+int
+main (int argc, char *argv[])
+{
+  VanetCsVfcExperiment experiment;
+
+  experiment.Simulate (argc, argv);
+  return 0;
+}
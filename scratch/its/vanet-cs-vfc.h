@@ -0,0 +1,505 @@
+/*
+ * vanet-cs-vfc.h
+ *
+ *  Created on: Jul 26, 2018
+ *      Author: Yang yanning <yang.ksn@gmail.com>
+ */
+
+#ifndef SCRATCH_VANET_CS_VFC_VANET_CS_VFC_H_
+#define SCRATCH_VANET_CS_VFC_VANET_CS_VFC_H_
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iterator>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <time.h>
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/wifi-module.h"
+#include "ns3/applications-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/wave-module.h"
+#include "ns3/csma-module.h"
+#include "ns3/netanim-module.h"
+#include "ns3/lte-module.h"
+#include "ns3/point-to-point-helper.h"
+#include "ns3/gnuplot.h"
+#include "graph.hpp"
+#include "udp-sender.h"
+#include "byte-buffer.h"
+#include "packet-header.h"
+#include "packet-tag-data.h"
+#include "stats.h"
+#include "log-category.h"
+#include "broadcast-scheduler.h"
+#include "checkpoint.h"
+#include "binary-mobility-helper.h"
+#include <errno.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#define Output_Animation 					false
+#define Gen_Gnuplot_File					false
+
+#define Lte_Enable 						false	// turn on/off LTE
+#define Upload_Enable 						false
+#define Upload_Resync_Period 					10	// every n-th upload carries the full request/cache sets
+#define Cloud_Enable 						true
+#define Scheduling 						true
+#define Search_Clique 						true
+#define Total_Time_Spent_stas 					true
+
+#define Device_Transmission_Range 				450
+#define BS_Transmission_Range 					2125
+#define Num_Cliques 						1
+#define Packet_Size 						1024
+#define Total_Sim_Time 						581.01
+
+#define Output_Result						true
+#define Console_Output_Result					true
+#define Loop_Scheduling						true
+
+#define Scheme_1						"cs-vfc"
+#define Scheme_2						"ncb"
+#define Scheme_3						"ma"
+
+#define Test_Bid						54
+
+/**
+ * This simulation is to show the routing service of WaveNetDevice described in IEEE 09.4.
+ *
+ * note: although txPowerLevel is supported now, the "TxPowerLevels"
+ * attribute of YansWifiPhy is 1 which means phy devices only support 1
+ * levels. Thus, if users want to control txPowerLevel, they should set
+ * these attributes of YansWifiPhy by themselves..
+ */
+namespace ns3 {
+namespace vanet {
+class CsVfcScheduler;
+class NcbScheduler;
+class MaScheduler;
+} // namespace vanet
+} // namespace ns3
+
+class VanetCsVfcExperiment
+{
+  friend class vanet::CsVfcScheduler;
+  friend class vanet::NcbScheduler;
+  friend class vanet::MaScheduler;
+
+public:
+  /**
+   * \brief Constructor
+   * \return none
+   */
+  VanetCsVfcExperiment ();
+
+  /**
+   * \brief destructor
+   */
+  ~VanetCsVfcExperiment ();
+
+  /**
+   * \brief Trace the receipt of an on-off-application generated packet
+   * \param context this object
+   * \param packet a received packet
+   * \return none
+   */
+  void OnOffTrace (std::string context, Ptr<const Packet> packet);
+
+  /**
+   * \brief Enacts simulation of an ns-3 wifi application
+   * \param argc program arguments count
+   * \param argv program arguments
+   * \return none
+   */
+  void Simulate (int argc, char **argv);
+
+  int MkPath(std::string s,mode_t mode);
+
+protected:
+  /**
+   * \brief Sets default attribute values
+   * \return none
+   */
+  virtual void SetDefaultAttributeValues ();
+
+  /**
+   * \brief Process command line arguments
+   * \param argc program arguments count
+   * \param argv program arguments
+   * \return none
+   */
+  virtual void ParseCommandLineArguments (int argc, char **argv);
+
+  /**
+   * \brief Configure nodes
+   * \return none
+   */
+  virtual void ConfigureNodes ();
+
+  /**
+   * \brief Configure channels
+   * \return none
+   */
+  virtual void ConfigureChannels ();
+
+  /**
+   * \brief Configure devices
+   * \return none
+   */
+  virtual void ConfigureDevices ();
+
+  /**
+   * \brief Configure Internet stack
+   * \return none
+   */
+  virtual void ConfigureInternet ();
+
+  /**
+   * \brief Configure mobility
+   * \return none
+   */
+  virtual void ConfigureMobility ();
+
+  /**
+   * \brief Configure applications
+   * \return none
+   */
+  virtual void ConfigureApplications ();
+
+  /**
+   * \brief Configure tracing
+   * \return none
+   */
+  virtual void ConfigureTracing ();
+
+  /**
+   * \brief Configure Animation
+   * \return none
+   */
+  virtual void ConfigureAnim ();
+
+  /**
+   * \brief Run the simulation
+   * \return none
+   */
+  virtual void RunSimulation ();
+
+  /**
+   * \brief Check the simulation stauts
+   * \return none
+   */
+  virtual void CheckSimulationStatus ();
+
+  /**
+   * \brief Process outputs
+   * \return none
+   */
+  virtual void ProcessOutputs ();
+
+private:
+  /**
+   * \brief Run the simulation
+   * \return none
+   */
+  void Run ();
+
+  /**
+   * \brief Run the simulation
+   * \param argc command line argument count
+   * \param argv command line parameters
+   * \return none
+   */
+  void CommandSetup (int argc, char **argv);
+
+  /**
+   * \brief Set up log file
+   * \return none
+   */
+  void SetupTraceFile ();
+
+  /**
+   * \brief Set up logging
+   * \return none
+   */
+  void SetupLogging ();
+
+  /**
+   * \brief Configure default attributes
+   * \return none
+   */
+  void ConfigureDefaults ();
+
+  /**
+   * \brief Set up the devices
+   * \return none
+   */
+  void SetupDevices ();
+
+  /**
+   * \brief Assign Ip Addresses for all devices
+   * \return none
+   */
+  void AssignIpAddresses ();
+
+  /**
+   * \brief Set up the OBU mobility nodes
+   * \return none
+   */
+  void SetupObuMobilityNodes ();
+
+  /**
+   * \brief Set up the RSU mobility nodes
+   * \return none
+   */
+  void SetupRsuMobilityNodes ();
+
+  /**
+   * \brief Set up the packet sink
+   * \param addr local address
+   * \param port port number
+   * \param node the node to receive the packet
+   * \return none
+   */
+  Ptr<Socket> SetupPacketSink (Ipv4Address addr, uint16_t port, Ptr<Node> node);
+
+  /**
+   * \brief Set up generation of packets
+   * through the vehicular network
+   * \return none
+   */
+  void SetupMessages ();
+
+  /**
+   * \brief Set up generation of packets
+   * through the vehicular network
+   * \param socket receive data
+   * \return none
+   */
+  void ReceivePacket (Ptr<Socket> socket);
+
+  /**
+   * \brief Receive a packet from the packet sink of a node
+   * \param experiment the experiment the sink is bound to
+   * \param nodeId id of the receiving node, bound when the sink is connected
+   * \param packet the received packet
+   * \param srcAddr source address
+   * \param destAddr destination address
+   * \return none
+   */
+  static void ReceivePacketOnNode (VanetCsVfcExperiment *experiment, uint32_t nodeId, Ptr<const Packet> packet, const Address & srcAddr, const Address & destAddr);
+
+  void ReceivePacketWithAddr (uint32_t nodeId, Ptr<const Packet> packet, const Address & srcAddr, const Address & destAddr);
+
+  /**
+   * \brief Set up a prescribed scenario
+   * \return none
+   */
+  void Initialization ();
+
+  /**
+   * \brief Course change of an OBU, connected to its mobility model
+   * \param experiment the experiment the model is bound to
+   * \param obuIdx index of the OBU, bound when the model is connected
+   * \param mobility the mobility model
+   * \return none
+   */
+  static void CourseChangeOnObu (VanetCsVfcExperiment *experiment, uint32_t obuIdx, Ptr<const MobilityModel> mobility);
+
+  /**
+   * Course change function
+   * \param obuIdx index of the OBU
+   * \param mobility the mobility model
+   */
+  void CourseChange (uint32_t obuIdx, Ptr<const MobilityModel> mobility);
+
+  /**
+   * Course change function
+   * \param os the output stream
+   * \param context trace source context (unused)
+   * \param mobility the mobility model
+   */
+  static void CourseChange (std::ostream *os, std::string context, Ptr<const MobilityModel> mobility);
+
+  void LoopPerSecond ();
+
+  void SubmitVehRequests(Ptr<Node> obu);
+
+  void SubmitAllVehsRequests();
+
+  void UploadVehicleInfo (Ptr<Node> obu);
+
+  void UploadAllVehiclesInfo ();
+
+  void ApplyVehicleUpload (vanet::ByteBuffer& bytes);
+
+  void UpdateAllFogCluster ();
+
+  void RecordTick (double schedulerTime);
+
+  void UpdateAllFogData ();
+
+  void PrintFogCluster ();
+
+  void ResetStatusAndSend (Ptr<UdpSender> sender);
+
+  void RecordStats (uint32_t obuIdx, uint32_t dataIdx);
+
+  /**
+   * \param nodeId id of an OBU node, aborts on any other node
+   * \return index of the OBU
+   */
+  uint32_t GetObuIndex (uint32_t nodeId) const
+  {
+    NS_ABORT_MSG_IF (nodeId >= vehId2IndexMap.size () || vehId2IndexMap[nodeId] == Not_An_Obu, "node " << nodeId << " is not an OBU");
+    return vehId2IndexMap[nodeId];
+  }
+
+  /**
+   * \brief Write the application state to <m_checkpointFile>-<time>.ckpt
+   *
+   * Called at the start of a tick, before any work of the tick. Packets in
+   * flight and the state of the wifi and LTE models are not part of it.
+   * \return none
+   */
+  void SaveCheckpoint ();
+
+  /**
+   * \brief Read and check the header of a checkpoint; on the first read the
+   * random seed and run are taken over, so the initial request and cache
+   * sets are drawn as in the run that wrote it
+   * \param reader the checkpoint, positioned at its start
+   * \param schemeName receives the scheme of the checkpoint
+   * \return none
+   */
+  void ReadCheckpointHeader (vanet::CheckpointReader& reader, std::string& schemeName);
+
+  /**
+   * \brief Restore the application state from m_restoreFile, once the
+   * scheduler exists; the first tick then runs at the time of the checkpoint
+   * \return none
+   */
+  void RestoreCheckpoint ();
+
+  uint32_t m_protocol; ///< protocol
+  uint16_t m_dlPort;  ///< LTE down link port
+  uint16_t m_ulPort;  ///< LTE up link port
+  uint16_t m_v2IPort;  ///< V2I port
+  uint16_t m_i2IPort;  ///< I2I port
+  uint16_t m_i2VPort;  ///< I2V port
+  std::string m_protocolName; ///< protocol name
+
+  std::string m_schemeName; ///< scheme name
+  std::string m_logCategories; ///< enabled log categories, see LogCategory
+
+  uint32_t m_nObuNodes; ///< number of vehicle
+  NodeContainer m_obuNodes; ///< the nodes
+  NetDeviceContainer m_obuDevices; ///< the devices
+  Ipv4InterfaceContainer m_obuInterfaces; ///< OBU transmit interfaces
+  double m_obuTxp; ///< distance
+
+  uint32_t m_nRsuNodes; ///< number of RSU
+  NodeContainer m_rsuNodes; ///< the RSU nodes
+  NetDeviceContainer m_rsu80211pDevices; ///< the RSU 80211p devices
+  NetDeviceContainer m_rsuCsmaDevices; ///< the RSU CSMA devices
+  Ipv4InterfaceContainer m_rsu80211pInterfaces; ///< RSU 80211p transmit interfaces
+  Ipv4InterfaceContainer m_rsuCsmaInterfaces; ///< RSU CSMA transmit interfaces
+  double m_rsuTxp; ///< distance
+
+  Ptr<LteHelper> m_lteHelper;
+  Ptr<PointToPointEpcHelper>  m_epcHelper;
+  Ptr<Node> m_pgw;
+  Ptr<Node> m_remoteHost;
+  Ipv4Address m_remoteHostAddr;
+  NodeContainer m_ueNodes;  ///< UE nodes
+  NodeContainer m_enbNodes;  ///< eNode
+  Ipv4InterfaceContainer m_ueInterface;  ///< UE ip interface
+
+  NodeContainer m_remoteHostNodes;  ///< remote Host nodes
+  double m_bsTxp; ///< distance
+
+  std::string m_phyMode; ///< phy mode
+  bool m_traceMobility; ///< trace mobility
+  std::string m_workspacePath; ///< workspace path
+  std::string m_mobilityFile; ///< mobility file
+  std::string m_mobLogFile; ///< mobility log file
+  std::string m_trName; ///< trace file name
+  std::string m_animFile; ///< animation file name
+  std::string m_plotFileName; ///< plot file
+  int m_log; ///< log
+  double m_TotalSimTime; ///< total sim time
+  std::string m_rate; ///< rate
+  uint32_t m_wavePacketSize; ///< bytes
+  uint32_t m_nonSafetySize; ///< bytes
+  double m_waveInterval; ///< seconds
+  int m_verbose = false;
+  int m_routingTables; ///< dump routing table (at t=5 sec).  0=No, 1=Yes
+  int m_asciiTrace; ///< ascii trace
+  int m_pcap; ///< PCAP
+  double m_timeSpent;
+
+  RequestStats m_requestStats; ///< request statistics
+  TickRecorder m_tickRecorder; ///< per-tick request statistics
+  std::string m_tickStatsFile; ///< file of the per-tick statistics, none if empty
+  bool m_tickStatsBinary; ///< write the per-tick statistics as raw records instead of CSV
+  std::string m_resultFile; ///< file of the result line of this run, none if empty
+  std::string m_checkpointFile; ///< prefix of the checkpoint files, none if empty
+  uint32_t m_checkpointPeriod; ///< ticks between two checkpoints
+  std::string m_restoreFile; ///< checkpoint to start from, none if empty
+  uint32_t m_tick; ///< ticks run so far
+  Time m_firstTickTime; ///< time of the first tick, later than 0.01s when restored
+  Ptr<WifiPhyStats> m_wifiPhyStats; ///< wifi phy statistics
+  RoutingStats m_routingStats; ///< routing statistics
+
+  std::uint32_t globalDbSize;
+  std::vector<uint32_t> globalDB;
+  static const uint32_t Not_An_Obu = UINT32_MAX; ///< vehId2IndexMap entry of the other nodes
+  std::vector<uint32_t> vehId2IndexMap; ///< OBU index by node id
+  std::vector<bool> vehsEnterFlag;
+  std::vector<std::set<uint32_t>> vehsReqs;
+  std::vector<std::set<uint32_t>> vehsCaches;
+  std::vector<std::set<uint32_t>> vehsInitialReqs;
+  std::vector<std::set<uint32_t>> vehsInitialCaches;
+  std::vector<std::map<uint32_t, RequestStatus>> vehsReqsStatus;
+  std::map<uint32_t, uint32_t> vehIdx2FogIdxMap;
+
+  std::map<uint32_t, uint32_t> fogId2FogIdxMap;
+  std::vector<std::set<uint32_t>> fogCluster; /// vehicles set for every fog node in the cloud, Updated when receive a packet from vehicle
+  std::vector<std::set<uint32_t>> fogsReqs; /// fogs node request set in the cloud, Updated when receive a packet from vehicle
+  std::vector<std::set<uint32_t>> fogsCaches; /// fogs node cache set in the cloud, Updated when receive a packet from vehicle
+  std::vector<DelayHistogram> fogsDelayHistogram; /// satisfaction delays per fog node (ns), the last one for vehicles outside every fog
+
+//  std::vector<std::set<uint32_t>> fogCluster; /// vehicles set for every fog node, Updated within fixed period
+//  std::vector<std::set<uint32_t>> fogsReqs; /// fogs node request set, Updated within fixed period
+//  std::vector<std::set<uint32_t>> fogsCaches; /// fogs node cache set, Updated within fixed period
+
+  std::vector<std::set<uint32_t>> vehsReqsUploaded; /// request set carried by the last upload of every vehicle
+  std::vector<std::set<uint32_t>> vehsCachesUploaded; /// cache set carried by the last upload of every vehicle
+  std::vector<uint32_t> vehsUploadSeq; /// sequence number of the next upload of every vehicle
+
+  std::vector<std::set<uint32_t>> vehsReqsInCloud;
+  std::vector<std::set<uint32_t>> vehsCachesInCloud;
+  std::vector<uint32_t> vehsUploadSeqInCloud; /// sequence number of the last upload applied in the cloud
+  std::vector<bool> vehsSyncedInCloud; /// false until a full upload arrives, and again after a lost delta
+  std::vector<std::map<uint32_t, RequestStatus>> vehsReqsStasInCloud;
+  std::vector<ns3::Vector3D> vehsMobInfoInCloud;
+
+  std::vector<bool> isFirstSubmit;
+  uint32_t currentBroadcastId;
+
+  uint32_t receive_count;
+
+  std::vector<bool> vehsStatus; ///< vehicle is in the service area or not
+
+  vanet::BroadcastScheduler *m_scheduler; ///< scheduler of the scheme in use, created in Initialization
+};
+
+
+#endif /* SCRATCH_VANET_CS_VFC_VANET_CS_VFC_H_ */
@@ -1284,6 +1284,7 @@ private:
   uint32_t m_scenario; ///< scenario
   double m_gpsAccuracyNs; ///< GPS accuracy
   double m_txMaxDelayMs; ///< transmit maximum delay
+  bool m_bsmHighScale; ///< install the BSMs in high-scale mode
   int m_routingTables; ///< routing tables
   int m_asciiTrace; ///< ascii trace
   int m_pcap; ///< PCAP
@@ -1345,6 +1346,7 @@ VanetRoutingExperiment::VanetRoutingExperiment ()
     m_scenario (1),
     m_gpsAccuracyNs (40),
     m_txMaxDelayMs (10),
+    m_bsmHighScale (false),
     m_routingTables (0),
     m_asciiTrace (0),
     m_pcap (0),
@@ -1660,16 +1662,18 @@ void
 VanetRoutingExperiment::ProcessOutputs ()
 {
   // calculate and output final results
-  double bsm_pdr1 = m_waveBsmHelper.GetWaveBsmStats ()->GetCumulativeBsmPdr (1);
-  double bsm_pdr2 = m_waveBsmHelper.GetWaveBsmStats ()->GetCumulativeBsmPdr (2);
-  double bsm_pdr3 = m_waveBsmHelper.GetWaveBsmStats ()->GetCumulativeBsmPdr (3);
-  double bsm_pdr4 = m_waveBsmHelper.GetWaveBsmStats ()->GetCumulativeBsmPdr (4);
-  double bsm_pdr5 = m_waveBsmHelper.GetWaveBsmStats ()->GetCumulativeBsmPdr (5);
-  double bsm_pdr6 = m_waveBsmHelper.GetWaveBsmStats ()->GetCumulativeBsmPdr (6);
-  double bsm_pdr7 = m_waveBsmHelper.GetWaveBsmStats ()->GetCumulativeBsmPdr (7);
-  double bsm_pdr8 = m_waveBsmHelper.GetWaveBsmStats ()->GetCumulativeBsmPdr (8);
-  double bsm_pdr9 = m_waveBsmHelper.GetWaveBsmStats ()->GetCumulativeBsmPdr (9);
-  double bsm_pdr10 = m_waveBsmHelper.GetWaveBsmStats ()->GetCumulativeBsmPdr (10);
+  // merge the BSM counts once for all the ratios below
+  WaveBsmStats::Snapshot waveBsmSnapshot = m_waveBsmHelper.GetWaveBsmStats ()->GetSnapshot ();
+  double bsm_pdr1 = waveBsmSnapshot.GetCumulativeBsmPdr (1);
+  double bsm_pdr2 = waveBsmSnapshot.GetCumulativeBsmPdr (2);
+  double bsm_pdr3 = waveBsmSnapshot.GetCumulativeBsmPdr (3);
+  double bsm_pdr4 = waveBsmSnapshot.GetCumulativeBsmPdr (4);
+  double bsm_pdr5 = waveBsmSnapshot.GetCumulativeBsmPdr (5);
+  double bsm_pdr6 = waveBsmSnapshot.GetCumulativeBsmPdr (6);
+  double bsm_pdr7 = waveBsmSnapshot.GetCumulativeBsmPdr (7);
+  double bsm_pdr8 = waveBsmSnapshot.GetCumulativeBsmPdr (8);
+  double bsm_pdr9 = waveBsmSnapshot.GetCumulativeBsmPdr (9);
+  double bsm_pdr10 = waveBsmSnapshot.GetCumulativeBsmPdr (10);
 
   double averageRoutingGoodputKbps = 0.0;
   uint32_t totalBytesTotal = m_routingHelper->GetRoutingStats ().GetCumulativeRxBytes ();
@@ -1677,10 +1681,10 @@ VanetRoutingExperiment::ProcessOutputs ()
 
   // calculate MAC/PHY overhead (mac-phy-oh)
   // total WAVE BSM bytes sent
-  uint32_t cumulativeWaveBsmBytes = m_waveBsmHelper.GetWaveBsmStats ()->GetTxByteCount ();
-  uint32_t cumulativeRoutingBytes = m_routingHelper->GetRoutingStats ().GetCumulativeTxBytes ();
-  uint32_t totalAppBytes = cumulativeWaveBsmBytes + cumulativeRoutingBytes;
-  uint32_t totalPhyBytes = m_wifiPhyStats->GetTxBytes ();
+  int64_t cumulativeWaveBsmBytes = waveBsmSnapshot.txByteCount;
+  int64_t cumulativeRoutingBytes = m_routingHelper->GetRoutingStats ().GetCumulativeTxBytes ();
+  int64_t totalAppBytes = cumulativeWaveBsmBytes + cumulativeRoutingBytes;
+  int64_t totalPhyBytes = m_wifiPhyStats->GetTxBytes ();
   // mac-phy-oh = (total-phy-bytes - total-app-bytes) / total-phy-bytes
   double mac_phy_oh = 0.0;
   if (totalPhyBytes > 0)
@@ -1759,33 +1763,34 @@ VanetRoutingExperiment::CheckThroughput ()
   uint32_t packetsReceived = m_routingHelper->GetRoutingStats ().GetRxPkts ();
   double kbps = (bytesTotal * 8.0) / 1000;
   double wavePDR = 0.0;
-  int wavePktsSent = m_waveBsmHelper.GetWaveBsmStats ()->GetTxPktCount ();
-  int wavePktsReceived = m_waveBsmHelper.GetWaveBsmStats ()->GetRxPktCount ();
+  // merge the BSM counts once for all the ratios below
+  WaveBsmStats::Snapshot waveBsmSnapshot = m_waveBsmHelper.GetWaveBsmStats ()->GetSnapshot ();
+  int64_t wavePktsSent = waveBsmSnapshot.txPktCount;
+  int64_t wavePktsReceived = waveBsmSnapshot.rxPktCount;
   if (wavePktsSent > 0)
     {
-      int wavePktsReceived = m_waveBsmHelper.GetWaveBsmStats ()->GetRxPktCount ();
       wavePDR = (double) wavePktsReceived / (double) wavePktsSent;
     }
 
-  int waveExpectedRxPktCount = m_waveBsmHelper.GetWaveBsmStats ()->GetExpectedRxPktCount (1);
-  int waveRxPktInRangeCount = m_waveBsmHelper.GetWaveBsmStats ()->GetRxPktInRangeCount (1);
-  double wavePDR1_2 = m_waveBsmHelper.GetWaveBsmStats ()->GetBsmPdr (1);
-  double wavePDR2_2 = m_waveBsmHelper.GetWaveBsmStats ()->GetBsmPdr (2);
-  double wavePDR3_2 = m_waveBsmHelper.GetWaveBsmStats ()->GetBsmPdr (3);
-  double wavePDR4_2 = m_waveBsmHelper.GetWaveBsmStats ()->GetBsmPdr (4);
-  double wavePDR5_2 = m_waveBsmHelper.GetWaveBsmStats ()->GetBsmPdr (5);
-  double wavePDR6_2 = m_waveBsmHelper.GetWaveBsmStats ()->GetBsmPdr (6);
-  double wavePDR7_2 = m_waveBsmHelper.GetWaveBsmStats ()->GetBsmPdr (7);
-  double wavePDR8_2 = m_waveBsmHelper.GetWaveBsmStats ()->GetBsmPdr (8);
-  double wavePDR9_2 = m_waveBsmHelper.GetWaveBsmStats ()->GetBsmPdr (9);
-  double wavePDR10_2 = m_waveBsmHelper.GetWaveBsmStats ()->GetBsmPdr (10);
+  int64_t waveExpectedRxPktCount = waveBsmSnapshot.expectedRxPktCounts[0];
+  int64_t waveRxPktInRangeCount = waveBsmSnapshot.rxPktInRangeCounts[0];
+  double wavePDR1_2 = waveBsmSnapshot.GetBsmPdr (1);
+  double wavePDR2_2 = waveBsmSnapshot.GetBsmPdr (2);
+  double wavePDR3_2 = waveBsmSnapshot.GetBsmPdr (3);
+  double wavePDR4_2 = waveBsmSnapshot.GetBsmPdr (4);
+  double wavePDR5_2 = waveBsmSnapshot.GetBsmPdr (5);
+  double wavePDR6_2 = waveBsmSnapshot.GetBsmPdr (6);
+  double wavePDR7_2 = waveBsmSnapshot.GetBsmPdr (7);
+  double wavePDR8_2 = waveBsmSnapshot.GetBsmPdr (8);
+  double wavePDR9_2 = waveBsmSnapshot.GetBsmPdr (9);
+  double wavePDR10_2 = waveBsmSnapshot.GetBsmPdr (10);
 
   // calculate MAC/PHY overhead (mac-phy-oh)
   // total WAVE BSM bytes sent
-  uint32_t cumulativeWaveBsmBytes = m_waveBsmHelper.GetWaveBsmStats ()->GetTxByteCount ();
-  uint32_t cumulativeRoutingBytes = m_routingHelper->GetRoutingStats ().GetCumulativeTxBytes ();
-  uint32_t totalAppBytes = cumulativeWaveBsmBytes + cumulativeRoutingBytes;
-  uint32_t totalPhyBytes = m_wifiPhyStats->GetTxBytes ();
+  int64_t cumulativeWaveBsmBytes = waveBsmSnapshot.txByteCount;
+  int64_t cumulativeRoutingBytes = m_routingHelper->GetRoutingStats ().GetCumulativeTxBytes ();
+  int64_t totalAppBytes = cumulativeWaveBsmBytes + cumulativeRoutingBytes;
+  int64_t totalPhyBytes = m_wifiPhyStats->GetTxBytes ();
   // mac-phy-oh = (total-phy-bytes - total-app-bytes) / total-phy-bytes
   double mac_phy_oh = 0.0;
   if (totalPhyBytes > 0)
@@ -2056,6 +2061,7 @@ VanetRoutingExperiment::CommandSetup (int argc, char **argv)
   cmd.AddValue ("txdist10", "Expected BSM tx range, m", txDist10);
   cmd.AddValue ("gpsaccuracy", "GPS time accuracy, in ns", m_gpsAccuracyNs);
   cmd.AddValue ("txmaxdelay", "Tx max delay, in ms", m_txMaxDelayMs);
+  cmd.AddValue ("bsmHighScale", "Share one BSM event list among all nodes", m_bsmHighScale);
   cmd.AddValue ("routingTables", "Dump routing tables at t=5 seconds", m_routingTables);
   cmd.AddValue ("asciiTrace", "Dump ASCII Trace data", m_asciiTrace);
   cmd.AddValue ("pcap", "Create PCAP files for all nodes", m_pcap);
@@ -2329,6 +2335,7 @@ VanetRoutingExperiment::SetupWaveMessages ()
       chAccessMode = 1;
     }
 
+  m_waveBsmHelper.SetHighScale (m_bsmHighScale);
   m_waveBsmHelper.Install (m_adhocTxInterfaces,
                            Seconds (m_TotalSimTime),
                            m_wavePacketSize,
@@ -0,0 +1,260 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <string>
+#include "ns3/command-line.h"
+#include "ns3/simulator.h"
+#include "ns3/double.h"
+#include "ns3/uinteger.h"
+#include "ns3/abort.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/mobility-model.h"
+#include "ns3/yans-wifi-helper.h"
+#include "ns3/mobility-helper.h"
+#include "ns3/wave-net-device.h"
+#include "ns3/wave-mac-helper.h"
+#include "ns3/wave-helper.h"
+
+using namespace ns3;
+
+/// heap allocations of this program, counted by the operator new below
+static std::atomic<uint64_t> g_allocations (0);
+
+/**
+ * Replaces the global operator new of this program to count allocations,
+ * the array and nothrow forms call this one.
+ * \param size the bytes to allocate
+ * \returns the allocated memory
+ */
+void *
+operator new (std::size_t size)
+{
+  g_allocations.fetch_add (1, std::memory_order_relaxed);
+  void *p = std::malloc (size == 0 ? 1 : size);
+  if (p == 0)
+    {
+      throw std::bad_alloc ();
+    }
+  return p;
+}
+
+/**
+ * Releases memory of the operator new above
+ * \param p the memory to release
+ */
+void
+operator delete (void *p) noexcept
+{
+  std::free (p);
+}
+
+/**
+ * This program measures the cost of the WAVE MAC stack.
+ *
+ * Devices in range of each other broadcast WSMPs on the CCH with SendX,
+ * or repeat WSAs on the CCH with StartVsa, either with continuous CCH
+ * access or alternating with SCH1.  The wall time per simulated second,
+ * the events executed and the heap allocations of the run are printed.
+ *
+ * The configurations compared so far are
+ *
+ *   ./waf --run "wave-benchmark --traffic=wsmp --devices=50 --rate=10"
+ *   ./waf --run "wave-benchmark --traffic=vsa --devices=50 --rate=10"
+ *   ./waf --run "wave-benchmark --traffic=wsmp --devices=300 --rate=10"
+ *   ./waf --run "wave-benchmark --traffic=vsa --devices=300 --rate=50"
+ *
+ * each with and without --alternating.
+ */
+class WaveBenchmark
+{
+public:
+  /**
+   * Constructor
+   * \param vsa whether the devices repeat WSAs instead of sending WSMPs
+   * \param devices the number of devices
+   * \param rate the messages sent by every device per second
+   * \param alternating whether the devices alternate between CCH and SCH1
+   * \param duration the simulated time of the traffic
+   */
+  WaveBenchmark (bool vsa, uint32_t devices, uint32_t rate, bool alternating, Time duration);
+
+  /// Run the benchmark and print its results
+  void Run (void);
+
+private:
+  /**
+   * Send a WSMP packet and schedule the next one
+   * \param device the sender
+   */
+  void SendWsmp (Ptr<WaveNetDevice> device);
+  /**
+   * Receive function
+   * \param dev the device
+   * \param pkt the packet
+   * \param mode the mode
+   * \param sender the sender address
+   * \returns true
+   */
+  bool Receive (Ptr<NetDevice> dev, Ptr<const Packet> pkt, uint16_t mode, const Address &sender);
+  /**
+   * Receive VSA function
+   * \param pkt the packet
+   * \param address the address
+   * \returns true
+   */
+  bool ReceiveVsa (Ptr<const Packet> pkt, const Address &address, uint32_t, uint32_t);
+
+  bool m_vsa; ///< VSA traffic?
+  uint32_t m_devices; ///< number of devices
+  uint32_t m_rate; ///< messages per device per second
+  bool m_alternating; ///< alternating access?
+  Time m_duration; ///< simulated time of the traffic
+  uint64_t m_received; ///< frames received
+};
+
+WaveBenchmark::WaveBenchmark (bool vsa, uint32_t devices, uint32_t rate, bool alternating, Time duration)
+  : m_vsa (vsa),
+    m_devices (devices),
+    m_rate (rate),
+    m_alternating (alternating),
+    m_duration (duration),
+    m_received (0)
+{
+}
+
+void
+WaveBenchmark::SendWsmp (Ptr<WaveNetDevice> device)
+{
+  Simulator::Schedule (Seconds (1.0 / m_rate), &WaveBenchmark::SendWsmp, this, device);
+  Ptr<Packet> packet = Create<Packet> (200);
+  const Address dest = Mac48Address::GetBroadcast ();
+  uint16_t protocol = 0x88dc; // WSMP
+  device->SendX (packet, dest, protocol, TxInfo (CCH));
+}
+
+bool
+WaveBenchmark::Receive (Ptr<NetDevice> dev, Ptr<const Packet> pkt, uint16_t mode, const Address &sender)
+{
+  m_received++;
+  return true;
+}
+
+bool
+WaveBenchmark::ReceiveVsa (Ptr<const Packet> pkt, const Address &address, uint32_t, uint32_t)
+{
+  m_received++;
+  return true;
+}
+
+void
+WaveBenchmark::Run (void)
+{
+  NodeContainer nodes;
+  nodes.Create (m_devices);
+
+  // a grid 10 devices wide with 10 m between neighbours, dense enough
+  // for the devices to hear most of the others
+  MobilityHelper mobility;
+  mobility.SetPositionAllocator ("ns3::GridPositionAllocator",
+                                 "DeltaX", DoubleValue (10.0),
+                                 "DeltaY", DoubleValue (10.0),
+                                 "GridWidth", UintegerValue (10));
+  mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  mobility.Install (nodes);
+
+  YansWifiChannelHelper wifiChannel = YansWifiChannelHelper::Default ();
+  YansWavePhyHelper wifiPhy =  YansWavePhyHelper::Default ();
+  wifiPhy.SetChannel (wifiChannel.Create ());
+  QosWaveMacHelper waveMac = QosWaveMacHelper::Default ();
+  WaveHelper waveHelper = WaveHelper::Default ();
+  NetDeviceContainer devices = waveHelper.Install (wifiPhy, waveMac, nodes);
+
+  const Time start = Seconds (0.1);
+  for (uint32_t i = 0; i != devices.GetN (); ++i)
+    {
+      Ptr<WaveNetDevice> device = DynamicCast<WaveNetDevice> (devices.Get (i));
+      device->SetReceiveCallback (MakeCallback (&WaveBenchmark::Receive, this));
+      device->SetWaveVsaCallback (MakeCallback (&WaveBenchmark::ReceiveVsa, this));
+      if (m_alternating)
+        {
+          const SchInfo schInfo = SchInfo (SCH1, false, EXTENDED_ALTERNATING);
+          Simulator::Schedule (Seconds (0), &WaveNetDevice::StartSch, device, schInfo);
+        }
+
+      // spread the first messages of the devices over one period
+      Time offset = start + Seconds (1.0 / m_rate * i / devices.GetN ());
+      if (!m_vsa)
+        {
+          Simulator::Schedule (offset, &WaveBenchmark::SendWsmp, this, device);
+        }
+      else
+        {
+          // the repeat rate counts the frames sent in 5 s
+          const VsaInfo vsaInfo = VsaInfo (Mac48Address::GetBroadcast (), OrganizationIdentifier (), 3,
+                                           Create<Packet> (200), CCH, 5 * m_rate,
+                                           m_alternating ? VSA_TRANSMIT_IN_CCHI : VSA_TRANSMIT_IN_BOTHI);
+          Simulator::Schedule (offset, &WaveNetDevice::StartVsa, device, vsaInfo);
+        }
+    }
+
+  Simulator::Stop (start + m_duration);
+  uint64_t allocations = g_allocations.load ();
+  SystemWallClockMs clock;
+  clock.Start ();
+  Simulator::Run ();
+  int64_t wallMs = clock.End ();
+  allocations = g_allocations.load () - allocations;
+  uint64_t events = Simulator::GetEventCount ();
+  Simulator::Destroy ();
+
+  double simulated = (start + m_duration).GetSeconds ();
+  std::cout << (m_vsa ? "vsa" : "wsmp") << ", " << m_devices << " devices, "
+            << m_rate << " per second, " << (m_alternating ? "alternating" : "continuous") << ": "
+            << wallMs / simulated << " ms wall time per simulated second, "
+            << events << " events, "
+            << allocations << " allocations, "
+            << m_received << " frames received" << std::endl;
+}
+
+int
+main (int argc, char *argv[])
+{
+  std::string traffic = "wsmp";
+  uint32_t devices = 50;
+  uint32_t rate = 10;
+  bool alternating = false;
+  double duration = 5.0;
+
+  CommandLine cmd;
+  cmd.AddValue ("traffic", "wsmp for SendX of WSMPs, vsa for StartVsa of repeated WSAs", traffic);
+  cmd.AddValue ("devices", "number of devices", devices);
+  cmd.AddValue ("rate", "messages sent by every device per second", rate);
+  cmd.AddValue ("alternating", "alternate between CCH and SCH1 instead of continuous CCH access", alternating);
+  cmd.AddValue ("duration", "simulated seconds of traffic", duration);
+  cmd.Parse (argc, argv);
+
+  NS_ABORT_MSG_IF (traffic != "wsmp" && traffic != "vsa", "unknown traffic " << traffic);
+  NS_ABORT_MSG_IF (devices == 0 || rate == 0, "devices and rate shall be positive");
+  // VsaInfo::repeatRate counts the WSAs of 5 s in a uint8_t
+  NS_ABORT_MSG_IF (traffic == "vsa" && 5 * rate > 255, "vsa rate " << rate << " exceeds 51 per second");
+
+  WaveBenchmark benchmark (traffic == "vsa", devices, rate, alternating, Seconds (duration));
+  benchmark.Run ();
+  return 0;
+}
@@ -21,6 +21,8 @@
 
 #include "ns3/wave-bsm-helper.h"
 #include "ns3/log.h"
+#include <algorithm>
+#include <cmath>
 
 NS_LOG_COMPONENT_DEFINE ("WaveBsmHelper");
 
@@ -29,7 +31,8 @@ namespace ns3 {
 std::vector<int> WaveBsmHelper::nodesMoving;
 
 WaveBsmHelper::WaveBsmHelper ()
-  : m_waveBsmStats ()
+  : m_waveBsmStats (),
+    m_highScale (false)
 {
   m_txSafetyRangesSq.resize (10, 0);
   m_txSafetyRangesSq[0] = 50.0 * 50.0;
@@ -101,6 +104,25 @@ WaveBsmHelper::Install (Ipv4InterfaceContainer & i,
       m_txSafetyRangesSq[index] = ranges[index] * ranges[index];
     }
 
+  // one spatial hash for all applications, rehashed once per BSM interval
+  double maxRange = 0.0;
+  for (int index = 0; index < size; index++)
+    {
+      maxRange = std::max (maxRange, std::fabs (ranges[index]));
+    }
+  m_nodeGrid = Create<BsmNodeGrid> (&i, waveInterval, maxRange);
+
+  Ptr<BsmScenario> scenario = 0;
+  if (m_highScale)
+    {
+      // BSMs are not transmitted for the first second, as in
+      // BsmApplication::StartApplication
+      Time totalTxTime = totalTime - Seconds (1.0);
+      uint32_t numWavePackets = (uint32_t) (totalTxTime.GetDouble () / waveInterval.GetDouble ());
+      scenario = Create<BsmScenario> (m_nodeGrid, wavePacketSize, numWavePackets);
+      GetWaveBsmStats ()->SetTxSafetyRangesSq (m_txSafetyRangesSq);
+    }
+
   // install a BsmApplication on each node
   ApplicationContainer bsmApps = Install (i);
   // start BSM app immediately (BsmApplication will
@@ -124,11 +146,19 @@ WaveBsmHelper::Install (Ipv4InterfaceContainer & i,
                      GetWaveBsmStats (),
                      &nodesMoving,
                      chAccessMode,
-                     txMaxDelay);
+                     txMaxDelay,
+                     m_nodeGrid,
+                     scenario);
       nodeId++;
     }
 }
 
+void
+WaveBsmHelper::SetHighScale (bool highScale)
+{
+  m_highScale = highScale;
+}
+
 Ptr<WaveBsmStats>
 WaveBsmHelper::GetWaveBsmStats ()
 {
@@ -103,6 +103,18 @@ public:
                 int chAccessMode,        // channel access mode (0=continuous; 1=switching)
                 Time txMaxDelay);        // max delay prior to transmit
 
+  /**
+   * \brief Enable the high-scale mode of the next Install of BSM
+   * generation, for scenarios with thousands of vehicles.  The
+   * applications then share one BsmScenario: one copy of the tables of
+   * the scenario, and one pending event for the transmissions of all
+   * nodes.  The BSMs sent, their timing and the context of their node
+   * are the same as without it.
+   * \param highScale whether to use the high-scale mode
+   * \return none
+   */
+  void SetHighScale (bool highScale);
+
   /**
    * \brief Returns the WaveBsmStats instance
    * \return the WaveBsmStats instance
@@ -141,6 +153,8 @@ private:
   WaveBsmStats m_waveBsmStats; ///< wave BSM stats
   /// tx safety range squared, for optimization
   std::vector <double> m_txSafetyRangesSq;
+  Ptr<BsmNodeGrid> m_nodeGrid; ///< positions of the nodes, shared by the applications
+  bool m_highScale; ///< whether Install shares a BsmScenario
   static std::vector<int> nodesMoving; ///< nodes moving
 };
 
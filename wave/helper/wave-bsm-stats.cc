@@ -23,21 +23,48 @@
 #include "ns3/wave-bsm-stats.h"
 #include "ns3/integer.h"
 #include "ns3/log.h"
+#include <algorithm>
+#include <atomic>
 
 namespace ns3 {
 
 NS_LOG_COMPONENT_DEFINE ("WaveBsmStats");
 
+/// serial numbers of the WaveBsmStats instances, never reused
+static std::atomic<uint64_t> g_waveBsmStatsSerial (0);
+
 WaveBsmStats::WaveBsmStats ()
-  : m_wavePktSendCount (0),
-    m_waveByteSendCount (0),
-    m_wavePktReceiveCount (0),
+  : m_serial (++g_waveBsmStatsSerial),
+    m_txPktOffset (0),
+    m_txByteOffset (0),
+    m_rxPktOffset (0),
     m_log (0)
 {
-  m_wavePktExpectedReceiveCounts.resize (10, 0);
-  m_wavePktInCoverageReceiveCounts.resize (10, 0);
-  m_waveTotalPktExpectedReceiveCounts.resize (10, 0);
-  m_waveTotalPktInCoverageReceiveCounts.resize (10, 0);
+  m_expectedOffsets.resize (10, 0);
+  m_inCoverageOffsets.resize (10, 0);
+  m_totalExpectedOffsets.resize (10, 0);
+  m_totalInCoverageOffsets.resize (10, 0);
+  m_rangeBuckets.resize (10, 0);
+}
+
+WaveBsmStats::WaveBsmStats (const WaveBsmStats &o)
+  : Object (o),
+    m_serial (++g_waveBsmStatsSerial)
+{
+  std::lock_guard<std::mutex> lock (o.m_mutex);
+  // the merged counts of o are a shard of no thread
+  m_shards.push_back (o.MergeShards ());
+  m_txPktOffset = o.m_txPktOffset;
+  m_txByteOffset = o.m_txByteOffset;
+  m_rxPktOffset = o.m_rxPktOffset;
+  m_expectedOffsets = o.m_expectedOffsets;
+  m_inCoverageOffsets = o.m_inCoverageOffsets;
+  m_totalExpectedOffsets = o.m_totalExpectedOffsets;
+  m_totalInCoverageOffsets = o.m_totalInCoverageOffsets;
+  m_txSafetyRangesSq = o.m_txSafetyRangesSq;
+  m_sortedRangesSq = o.m_sortedRangesSq;
+  m_rangeBuckets = o.m_rangeBuckets;
+  m_log = o.m_log;
 }
 
 /* static */
@@ -51,89 +78,279 @@ WaveBsmStats::GetTypeId (void)
     ;
   return tid;
 }
-  
+
+WaveBsmStats::Shard &
+WaveBsmStats::GetShard (void)
+{
+  // the last instance the thread counted for, which is the
+  // only one in most simulations
+  static thread_local uint64_t cachedSerial = 0;
+  static thread_local Shard *cachedShard = 0;
+  if (cachedSerial == m_serial)
+    {
+      return *cachedShard;
+    }
+
+  std::lock_guard<std::mutex> lock (m_mutex);
+  std::map<std::thread::id, Shard *>::iterator i = m_threadShards.find (std::this_thread::get_id ());
+  if (i == m_threadShards.end ())
+    {
+      Shard shard = Shard ();
+      ResizeShard (shard);
+      m_shards.push_back (shard);
+      i = m_threadShards.insert (std::make_pair (std::this_thread::get_id (), &m_shards.back ())).first;
+    }
+  cachedSerial = m_serial;
+  cachedShard = i->second;
+  return *cachedShard;
+}
+
+void
+WaveBsmStats::ResizeShard (Shard &shard) const
+{
+  shard.expectedCounts.resize (m_rangeBuckets.size (), 0);
+  shard.inCoverageCounts.resize (m_rangeBuckets.size (), 0);
+  shard.expectedBuckets.resize (m_sortedRangesSq.size (), 0);
+  shard.inCoverageBuckets.resize (m_sortedRangesSq.size (), 0);
+}
+
+WaveBsmStats::Shard
+WaveBsmStats::MergeShards (void) const
+{
+  Shard merged = Shard ();
+  ResizeShard (merged);
+  for (std::deque<Shard>::const_iterator i = m_shards.begin (); i != m_shards.end (); ++i)
+    {
+      merged.txPktCount += i->txPktCount;
+      merged.txByteCount += i->txByteCount;
+      merged.rxPktCount += i->rxPktCount;
+      for (size_t index = 0; index < merged.expectedCounts.size (); index++)
+        {
+          merged.expectedCounts[index] += i->expectedCounts[index];
+          merged.inCoverageCounts[index] += i->inCoverageCounts[index];
+        }
+      for (size_t bucket = 0; bucket < merged.expectedBuckets.size (); bucket++)
+        {
+          merged.expectedBuckets[bucket] += i->expectedBuckets[bucket];
+          merged.inCoverageBuckets[bucket] += i->inCoverageBuckets[bucket];
+        }
+    }
+  return merged;
+}
+
+WaveBsmStats::Snapshot
+WaveBsmStats::GetSnapshot (void) const
+{
+  std::lock_guard<std::mutex> lock (m_mutex);
+  Shard merged = MergeShards ();
+  Snapshot snapshot;
+  snapshot.txPktCount = m_txPktOffset + merged.txPktCount;
+  snapshot.txByteCount = m_txByteOffset + merged.txByteCount;
+  snapshot.rxPktCount = m_rxPktOffset + merged.rxPktCount;
+  size_t size = m_rangeBuckets.size ();
+  snapshot.expectedRxPktCounts.resize (size);
+  snapshot.rxPktInRangeCounts.resize (size);
+  snapshot.totalExpectedRxPktCounts.resize (size);
+  snapshot.totalRxPktInRangeCounts.resize (size);
+  for (size_t index = 1; index <= size; index++)
+    {
+      int64_t expected = merged.expectedCounts[index - 1] + SumBuckets (merged.expectedBuckets, index);
+      int64_t inCoverage = merged.inCoverageCounts[index - 1] + SumBuckets (merged.inCoverageBuckets, index);
+      snapshot.expectedRxPktCounts[index - 1] = m_expectedOffsets[index - 1] + expected;
+      snapshot.rxPktInRangeCounts[index - 1] = m_inCoverageOffsets[index - 1] + inCoverage;
+      snapshot.totalExpectedRxPktCounts[index - 1] = m_totalExpectedOffsets[index - 1] + expected;
+      snapshot.totalRxPktInRangeCounts[index - 1] = m_totalInCoverageOffsets[index - 1] + inCoverage;
+    }
+  return snapshot;
+}
+
 void
 WaveBsmStats::IncTxPktCount ()
 {
-  m_wavePktSendCount++;
+  GetShard ().txPktCount++;
 }
 
-int
+int64_t
 WaveBsmStats::GetTxPktCount ()
 {
-  return m_wavePktSendCount;
+  std::lock_guard<std::mutex> lock (m_mutex);
+  int64_t count = m_txPktOffset;
+  for (std::deque<Shard>::const_iterator i = m_shards.begin (); i != m_shards.end (); ++i)
+    {
+      count += i->txPktCount;
+    }
+  return count;
 }
 
 void
 WaveBsmStats::IncExpectedRxPktCount (int index)
 {
-  m_wavePktExpectedReceiveCounts[index - 1]++;
-  m_waveTotalPktExpectedReceiveCounts[index - 1]++;
+  GetShard ().expectedCounts[index - 1]++;
+}
+
+void
+WaveBsmStats::SetTxSafetyRangesSq (const std::vector <double> &rangesSq)
+{
+  std::lock_guard<std::mutex> lock (m_mutex);
+  size_t size = std::max (rangesSq.size (), m_rangeBuckets.size ());
+  m_expectedOffsets.resize (size, 0);
+  m_inCoverageOffsets.resize (size, 0);
+  m_totalExpectedOffsets.resize (size, 0);
+  m_totalInCoverageOffsets.resize (size, 0);
+  m_rangeBuckets.resize (size, 0);
+  for (std::deque<Shard>::iterator i = m_shards.begin (); i != m_shards.end (); ++i)
+    {
+      ResizeShard (*i);
+    }
+
+  // every application sets the same ranges, do not drop the counts
+  if (rangesSq == m_txSafetyRangesSq)
+    {
+      return;
+    }
+  // fold the counts so far into the counts per range
+  for (std::deque<Shard>::iterator i = m_shards.begin (); i != m_shards.end (); ++i)
+    {
+      for (size_t index = 1; index <= size; index++)
+        {
+          i->expectedCounts[index - 1] += SumBuckets (i->expectedBuckets, index);
+          i->inCoverageCounts[index - 1] += SumBuckets (i->inCoverageBuckets, index);
+        }
+    }
+
+  m_txSafetyRangesSq = rangesSq;
+  m_sortedRangesSq = rangesSq;
+  std::sort (m_sortedRangesSq.begin (), m_sortedRangesSq.end ());
+  size_t nBuckets = m_sortedRangesSq.size ();
+  for (std::deque<Shard>::iterator i = m_shards.begin (); i != m_shards.end (); ++i)
+    {
+      i->expectedBuckets.assign (nBuckets, 0);
+      i->inCoverageBuckets.assign (nBuckets, 0);
+    }
+
+  // a distance within range(index) is in one of the buckets up to it
+  m_rangeBuckets.assign (size, 0);
+  for (size_t index = 0; index < rangesSq.size (); index++)
+    {
+      m_rangeBuckets[index] = std::upper_bound (m_sortedRangesSq.begin (), m_sortedRangesSq.end (), rangesSq[index])
+        - m_sortedRangesSq.begin ();
+    }
+}
+
+size_t
+WaveBsmStats::GetRangeBucket (double distSq) const
+{
+  return std::lower_bound (m_sortedRangesSq.begin (), m_sortedRangesSq.end (), distSq) - m_sortedRangesSq.begin ();
+}
+
+uint64_t
+WaveBsmStats::SumBuckets (const std::vector <uint64_t> &buckets, int index) const
+{
+  uint64_t count = 0;
+  for (size_t bucket = 0; bucket < m_rangeBuckets[index - 1]; bucket++)
+    {
+      count += buckets[bucket];
+    }
+  return count;
+}
+
+void
+WaveBsmStats::CountExpectedRxPkt (double distSq)
+{
+  size_t bucket = GetRangeBucket (distSq);
+  if (bucket < m_sortedRangesSq.size ())
+    {
+      GetShard ().expectedBuckets[bucket]++;
+    }
+}
+
+void
+WaveBsmStats::CountRxPktInRange (double distSq)
+{
+  size_t bucket = GetRangeBucket (distSq);
+  if (bucket < m_sortedRangesSq.size ())
+    {
+      GetShard ().inCoverageBuckets[bucket]++;
+    }
 }
 
 void
 WaveBsmStats::IncRxPktCount ()
 {
-  m_wavePktReceiveCount++;
+  GetShard ().rxPktCount++;
 }
 
 void
 WaveBsmStats::IncRxPktInRangeCount (int index)
 {
-  m_wavePktInCoverageReceiveCounts[index - 1]++;
-  m_waveTotalPktInCoverageReceiveCounts[index - 1]++;
+  GetShard ().inCoverageCounts[index - 1]++;
 }
 
-int
+int64_t
 WaveBsmStats::GetRxPktCount ()
 {
-  return m_wavePktReceiveCount;
+  return GetSnapshot ().rxPktCount;
 }
 
-int
+int64_t
 WaveBsmStats::GetExpectedRxPktCount (int index)
 {
-  return m_wavePktExpectedReceiveCounts[index - 1];
+  return GetSnapshot ().expectedRxPktCounts[index - 1];
 }
 
-int
+int64_t
 WaveBsmStats::GetRxPktInRangeCount (int index)
 {
-  return m_wavePktInCoverageReceiveCounts[index - 1];
+  return GetSnapshot ().rxPktInRangeCounts[index - 1];
 }
 
 void
-WaveBsmStats::SetTxPktCount (int count)
+WaveBsmStats::SetTxPktCount (int64_t count)
 {
-  m_wavePktSendCount = count;
+  std::lock_guard<std::mutex> lock (m_mutex);
+  m_txPktOffset = count - (int64_t) MergeShards ().txPktCount;
 }
 
 void
-WaveBsmStats::SetRxPktCount (int count)
+WaveBsmStats::SetRxPktCount (int64_t count)
 {
-  m_wavePktReceiveCount = count;
+  std::lock_guard<std::mutex> lock (m_mutex);
+  m_rxPktOffset = count - (int64_t) MergeShards ().rxPktCount;
 }
 
 void
 WaveBsmStats::IncTxByteCount (int bytes)
 {
-  m_waveByteSendCount += bytes;
+  GetShard ().txByteCount += bytes;
 }
 
-int
+int64_t
 WaveBsmStats::GetTxByteCount ()
 {
-  return m_waveByteSendCount;
+  return GetSnapshot ().txByteCount;
 }
 
 double
 WaveBsmStats::GetBsmPdr (int index)
+{
+  return GetSnapshot ().GetBsmPdr (index);
+}
+
+double
+WaveBsmStats::GetCumulativeBsmPdr (int index)
+{
+  return GetSnapshot ().GetCumulativeBsmPdr (index);
+}
+
+double
+WaveBsmStats::Snapshot::GetBsmPdr (int index) const
 {
   double pdr = 0.0;
+  int64_t expected = expectedRxPktCounts[index - 1];
 
-  if (m_wavePktExpectedReceiveCounts[index - 1] > 0)
+  if (expected > 0)
     {
-      pdr = (double) m_wavePktInCoverageReceiveCounts[index - 1] / (double) m_wavePktExpectedReceiveCounts[index - 1];
+      pdr = (double) rxPktInRangeCounts[index - 1] / (double) expected;
       // due to node movement, it is
       // possible to receive a packet that is not slightly "within range" that was
       // transmitted at the time when the nodes were slightly "out of range"
@@ -148,13 +365,14 @@ WaveBsmStats::GetBsmPdr (int index)
 }
 
 double
-WaveBsmStats::GetCumulativeBsmPdr (int index)
+WaveBsmStats::Snapshot::GetCumulativeBsmPdr (int index) const
 {
   double pdr = 0.0;
+  int64_t expected = totalExpectedRxPktCounts[index - 1];
 
-  if (m_waveTotalPktExpectedReceiveCounts[index - 1] > 0)
+  if (expected > 0)
     {
-      pdr = (double) m_waveTotalPktInCoverageReceiveCounts[index - 1] / (double) m_waveTotalPktExpectedReceiveCounts[index - 1];
+      pdr = (double) totalRxPktInRangeCounts[index - 1] / (double) expected;
       // due to node movement, it is
       // possible to receive a packet that is not slightly "within range" that was
       // transmitted at the time when the nodes were slightly "out of range"
@@ -181,22 +399,28 @@ WaveBsmStats::GetLogging ()
 }
 
 void
-WaveBsmStats::SetExpectedRxPktCount (int index, int count)
+WaveBsmStats::SetExpectedRxPktCount (int index, int64_t count)
 {
-  m_wavePktExpectedReceiveCounts[index - 1] = count;
+  std::lock_guard<std::mutex> lock (m_mutex);
+  Shard merged = MergeShards ();
+  m_expectedOffsets[index - 1] = count - (int64_t) (merged.expectedCounts[index - 1] + SumBuckets (merged.expectedBuckets, index));
 }
 
 void
-WaveBsmStats::SetRxPktInRangeCount (int index, int count)
+WaveBsmStats::SetRxPktInRangeCount (int index, int64_t count)
 {
-  m_wavePktInCoverageReceiveCounts[index - 1] = count;
+  std::lock_guard<std::mutex> lock (m_mutex);
+  Shard merged = MergeShards ();
+  m_inCoverageOffsets[index - 1] = count - (int64_t) (merged.inCoverageCounts[index - 1] + SumBuckets (merged.inCoverageBuckets, index));
 }
 
 void
 WaveBsmStats::ResetTotalRxPktCounts (int index)
 {
-  m_waveTotalPktInCoverageReceiveCounts[index - 1] = 0;
-  m_waveTotalPktExpectedReceiveCounts[index - 1] = 0;
+  std::lock_guard<std::mutex> lock (m_mutex);
+  Shard merged = MergeShards ();
+  m_totalInCoverageOffsets[index - 1] = -(int64_t) (merged.inCoverageCounts[index - 1] + SumBuckets (merged.inCoverageBuckets, index));
+  m_totalExpectedOffsets[index - 1] = -(int64_t) (merged.expectedCounts[index - 1] + SumBuckets (merged.expectedBuckets, index));
 }
 
 } // namespace ns3
@@ -23,6 +23,11 @@
 #define WAVE_BSM_STATS_H
 
 #include "ns3/object.h"
+#include <stdint.h>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <thread>
 #include <vector>
 
 namespace ns3 {
@@ -49,12 +54,48 @@ namespace ns3 {
 class WaveBsmStats : public Object
 {
 public:
+  /**
+   * \brief The counts of all threads, merged when read
+   */
+  struct Snapshot
+  {
+    int64_t txPktCount; ///< packet sent count
+    int64_t txByteCount; ///< byte sent count
+    int64_t rxPktCount; ///< packet receive count
+    std::vector <int64_t> expectedRxPktCounts; ///< packet expected receive counts, by index - 1
+    std::vector <int64_t> rxPktInRangeCounts; ///< packet in coverage receive counts, by index - 1
+    std::vector <int64_t> totalExpectedRxPktCounts; ///< total packet expected receive counts, by index - 1
+    std::vector <int64_t> totalRxPktInRangeCounts; ///< total packet in coverage receive counts, by index - 1
+
+    /**
+     * \brief Returns the BSM Packet Delivery Ratio (PDR) of the snapshot
+     * \param index index for statistics
+     * \return the packet delivery ratio (PDR) of BSMs.
+     */
+    double GetBsmPdr (int index) const;
+
+    /**
+     * \brief Returns the cumulative BSM Packet Delivery Ratio (PDR)
+     * of the snapshot
+     * \param index index for statistics
+     * \return the packet delivery ratio (PDR) of BSMs.
+     */
+    double GetCumulativeBsmPdr (int index) const;
+  };
+
   /**
    * \brief Constructor
    * \return none
    */
   WaveBsmStats ();
 
+  /**
+   * \brief Copy constructor, the copy starts from the merged
+   * counts of o
+   * \param o the stats to copy
+   */
+  WaveBsmStats (const WaveBsmStats &o);
+
   /**
    * Register this type.
    * \return The TypeId.
@@ -71,7 +112,7 @@ public:
    * \brief Returns the count of transmitted packets
    * \return count of packets transmitted
    */
-  int GetTxPktCount ();
+  int64_t GetTxPktCount ();
 
   /*
    * Note:
@@ -111,6 +152,25 @@ public:
    */
   void IncExpectedRxPktCount (int index);
 
+  /**
+   * \brief Sets the coverage areas, as the squares of their ranges.
+   * Each coverage area is identified by its position (index + 1)
+   * in rangesSq, which need not be sorted.
+   * \param rangesSq the ranges, in m ^ 2
+   * \return none
+   */
+  void SetTxSafetyRangesSq (const std::vector <double> &rangesSq);
+
+  /**
+   * \brief Counts a (broadcast) packet expected to be received at a
+   * distance, within every coverage area that includes the distance.
+   * Only the innermost coverage area is recorded, the counts of the
+   * others are summed up when read.
+   * \param distSq the square of the distance to the receiver, in m ^ 2
+   * \return none
+   */
+  void CountExpectedRxPkt (double distSq);
+
   /**
    * \brief Increments the count of actual packets received
    * (regardless of coverage area).
@@ -129,25 +189,34 @@ public:
    */
   void IncRxPktInRangeCount (int index);
 
+  /**
+   * \brief Counts a packet actually received at a distance, within
+   * every coverage area that includes the distance.  See
+   * CountExpectedRxPkt.
+   * \param distSq the square of the distance to the sender, in m ^ 2
+   * \return none
+   */
+  void CountRxPktInRange (double distSq);
+
   /**
    * \brief Returns the count of packets received
    * \return the count of packets received
    */
-  int GetRxPktCount ();
+  int64_t GetRxPktCount ();
 
   /**
    * \brief Returns the count of expected packets received within range(index)
    * \param index index for statistics
    * \return the count of expected packets received within range(index)
    */
-  int GetExpectedRxPktCount (int index);
+  int64_t GetExpectedRxPktCount (int index);
 
   /**
    * \brief Increments the count of actual packets recevied within range(index)
    * \param index index for statistics
    * \return the count of actual packets received within range(index)
    */
-  int GetRxPktInRangeCount (int index);
+  int64_t GetRxPktInRangeCount (int index);
 
   /**
    * \brief Sets the count of packets expected to received
@@ -155,7 +224,7 @@ public:
    * \param count the count of packets
    * \return none
    */
-  void SetExpectedRxPktCount (int index, int count);
+  void SetExpectedRxPktCount (int index, int64_t count);
 
   /**
    * \brief Sets the count of packets within range that are received
@@ -163,7 +232,7 @@ public:
    * \param count the count of packets
    * \return none
    */
-  void SetRxPktInRangeCount (int index, int count);
+  void SetRxPktInRangeCount (int index, int64_t count);
 
   /**
    * \brief Resets the count of total packets
@@ -178,14 +247,14 @@ public:
    * \param count the count of packets transmitted
    * \return none
    */
-  void SetTxPktCount (int count);
+  void SetTxPktCount (int64_t count);
 
   /**
    * \brief Sets the count of packets received
    * \param count the count of packets received
    * \return none
    */
-  void SetRxPktCount (int count);
+  void SetRxPktCount (int64_t count);
 
   /**
    * \brief Increments the count of (application data) bytes transmitted
@@ -200,7 +269,7 @@ public:
    * not include MAC/PHY overhead
    * \return number of bytes of application-data transmitted
    */
-  int GetTxByteCount ();
+  int64_t GetTxByteCount ();
 
   /**
    * \brief Returns the BSM Packet Delivery Ratio (PDR)
@@ -220,6 +289,14 @@ public:
    */
   double GetCumulativeBsmPdr (int index);
 
+  /**
+   * \brief Merges the counts of all threads.  The threads shall
+   * not be counting meanwhile, e.g. read at the end of the run
+   * or from an event that all threads are synchronized for.
+   * \return the counts so far
+   */
+  Snapshot GetSnapshot (void) const;
+
   /**
    * \brief Enables/disables logging
    * \param log
@@ -234,13 +311,80 @@ public:
   int GetLogging ();
 
 private:
-  int m_wavePktSendCount; ///< packet sent count
-  int m_waveByteSendCount; ///< byte sent count
-  int m_wavePktReceiveCount; ///< packet receive count 
-  std::vector <int> m_wavePktInCoverageReceiveCounts; ///< packet in ceoverage receive counts
-  std::vector <int> m_wavePktExpectedReceiveCounts; ///< packet expected receive counts
-  std::vector <int> m_waveTotalPktInCoverageReceiveCounts; ///< total packet in coverage receive counts
-  std::vector <int> m_waveTotalPktExpectedReceiveCounts; ///< total packet expected receive counts
+  /**
+   * The counts of one thread, which only that thread increments.
+   * Every event is counted once; the counts are unsigned, what was
+   * set or reset lives in the offsets of WaveBsmStats.
+   */
+  struct Shard
+  {
+    uint64_t txPktCount; ///< packet sent count
+    uint64_t txByteCount; ///< byte sent count
+    uint64_t rxPktCount; ///< packet receive count
+    std::vector <uint64_t> expectedCounts; ///< packet expected receive counts, by index - 1
+    std::vector <uint64_t> inCoverageCounts; ///< packet in coverage receive counts, by index - 1
+    std::vector <uint64_t> expectedBuckets; ///< packet expected receive counts per bucket
+    std::vector <uint64_t> inCoverageBuckets; ///< packet in coverage receive counts per bucket
+  };
+
+  /**
+   * \brief Finds the shard of the calling thread, adding it
+   * on the first count of the thread
+   * \return the shard of the calling thread
+   */
+  Shard &GetShard (void);
+
+  /**
+   * \brief Sizes a shard for the ranges, m_mutex shall be held
+   * \param shard the shard
+   * \return none
+   */
+  void ResizeShard (Shard &shard) const;
+
+  /**
+   * \brief Sums up the shards, m_mutex shall be held
+   * \return the counts of all threads
+   */
+  Shard MergeShards (void) const;
+
+  /**
+   * \brief Finds the innermost coverage area that includes a distance
+   * \param distSq the square of the distance, in m ^ 2
+   * \return the index of the area in the sorted ranges, or
+   * the number of ranges if no area includes the distance
+   */
+  size_t GetRangeBucket (double distSq) const;
+
+  /**
+   * \brief Sums up the counts of the areas inside a coverage area
+   * \param buckets counts per area in the sorted ranges
+   * \param index index for statistics
+   * \return the count within range(index)
+   */
+  uint64_t SumBuckets (const std::vector <uint64_t> &buckets, int index) const;
+
+  /*
+   * Each thread counts into its own shard, so that the applications
+   * of a parallel simulation do not contend; the shards are merged
+   * when read.  The packets counted by distance are recorded once,
+   * in the bucket of their innermost coverage area.  The current and
+   * total counts are the same events: they only differ by the
+   * offsets below, which hold what was set or reset.
+   */
+  std::deque<Shard> m_shards; ///< shards, a deque keeps them in place
+  std::map<std::thread::id, Shard *> m_threadShards; ///< shard of each thread
+  mutable std::mutex m_mutex; ///< guards the shards, the map and the offsets
+  uint64_t m_serial; ///< identifies this instance in the shard cache of the threads
+  int64_t m_txPktOffset; ///< packet sent count offset
+  int64_t m_txByteOffset; ///< byte sent count offset
+  int64_t m_rxPktOffset; ///< packet receive count offset
+  std::vector <int64_t> m_expectedOffsets; ///< packet expected receive count offsets
+  std::vector <int64_t> m_inCoverageOffsets; ///< packet in coverage receive count offsets
+  std::vector <int64_t> m_totalExpectedOffsets; ///< total packet expected receive count offsets
+  std::vector <int64_t> m_totalInCoverageOffsets; ///< total packet in coverage receive count offsets
+  std::vector <double> m_txSafetyRangesSq; ///< ranges squared, by index
+  std::vector <double> m_sortedRangesSq; ///< ranges squared, ascending
+  std::vector <size_t> m_rangeBuckets; ///< buckets inside each range(index)
   int m_log; ///< log
 };
 
@@ -26,11 +26,243 @@
 #include "ns3/wave-helper.h"
 #include "ns3/mobility-model.h"
 #include "ns3/mobility-helper.h"
+#include <algorithm>
+#include <cmath>
+#include <functional>
 
 NS_LOG_COMPONENT_DEFINE ("BsmApplication");
 
 namespace ns3 {
 
+BsmNodeGrid::BsmNodeGrid (Ipv4InterfaceContainer * i, Time refresh, double maxRange)
+  : m_interfaces (i),
+    m_refresh (refresh),
+    m_lastRefresh (Seconds (0)),
+    m_valid (false),
+    m_maxRange (maxRange),
+    m_cellSize (maxRange),
+    m_maxSpeed (0.0)
+{
+  NS_ASSERT_MSG (refresh.IsStrictlyPositive (), "BSM grid refresh interval must be positive");
+}
+
+BsmNodeGrid::~BsmNodeGrid ()
+{
+  DisconnectCourseChanges ();
+}
+
+void
+BsmNodeGrid::DisconnectCourseChanges (void)
+{
+  for (uint32_t i = 0; i < m_courseChanges.size (); i++)
+    {
+      m_models[i]->TraceDisconnectWithoutContext ("CourseChange", m_courseChanges[i]);
+    }
+  m_courseChanges.clear ();
+}
+
+void
+BsmNodeGrid::CourseChanged (BsmNodeGrid *grid, uint32_t index, Ptr<const MobilityModel> model)
+{
+  if (!grid->m_valid)
+    {
+      return;
+    }
+  Vector velocity = model->GetVelocity ();
+  double speedSq = velocity.x * velocity.x + velocity.y * velocity.y + velocity.z * velocity.z;
+  double elapsed = (Simulator::Now () - grid->m_lastRefresh).GetSeconds ();
+  double moved = CalculateDistance (model->GetPosition (), grid->m_positions[index]);
+  // the tolerance only absorbs rounding of the position
+  if (speedSq > grid->m_maxSpeed * grid->m_maxSpeed
+      || moved > grid->m_maxSpeed * elapsed + 1e-6)
+    {
+      NS_LOG_LOGIC ("node " << index << " outruns the BSM grid, rehashing");
+      grid->m_valid = false;
+    }
+}
+
+uint64_t
+BsmNodeGrid::GetCellKey (int64_t x, int64_t y)
+{
+  return (static_cast<uint64_t> (static_cast<uint32_t> (x)) << 32) | static_cast<uint32_t> (y);
+}
+
+void
+BsmNodeGrid::CacheNodes (void)
+{
+  uint32_t nNodes = m_interfaces->GetN ();
+  if (m_nodes.size () == nNodes)
+    {
+      return;
+    }
+
+  NS_LOG_FUNCTION (this);
+  DisconnectCourseChanges ();
+  m_nodes.resize (nNodes);
+  m_models.resize (nNodes);
+  m_courseChanges.resize (nNodes);
+  m_addresses.clear ();
+  m_valid = false;
+  for (uint32_t i = 0; i < nNodes; i++)
+    {
+      m_nodes[i] = m_interfaces->Get (i).first->GetObject<Node> ();
+      m_models[i] = m_nodes[i]->GetObject<MobilityModel> ();
+      NS_ASSERT (m_models[i] != 0);
+      m_courseChanges[i] = MakeBoundCallback (&BsmNodeGrid::CourseChanged, this, i);
+      m_models[i]->TraceConnectWithoutContext ("CourseChange", m_courseChanges[i]);
+      // the first interface of an address wins, as the linear search did
+      m_addresses.insert (std::make_pair (m_interfaces->GetAddress (i), i));
+    }
+}
+
+bool
+BsmNodeGrid::FindAddress (const Ipv4Address &address, uint32_t &index) const
+{
+  std::unordered_map<Ipv4Address, uint32_t, Ipv4AddressHash>::const_iterator it = m_addresses.find (address);
+  if (it == m_addresses.end ())
+    {
+      return false;
+    }
+  index = it->second;
+  return true;
+}
+
+void
+BsmNodeGrid::Refresh (void)
+{
+  NS_LOG_FUNCTION (this);
+
+  // the interfaces are all assigned before the first BSM is sent
+  CacheNodes ();
+  uint32_t nNodes = m_nodes.size ();
+
+  double maxSpeedSq = 0.0;
+  for (uint32_t i = 0; i < nNodes; i++)
+    {
+      Vector velocity = m_models[i]->GetVelocity ();
+      maxSpeedSq = std::max (maxSpeedSq, velocity.x * velocity.x + velocity.y * velocity.y + velocity.z * velocity.z);
+    }
+  // both the sender and the receiver may move until the next refresh
+  m_maxSpeed = std::sqrt (maxSpeedSq);
+  m_cellSize = std::max (m_maxRange + 2.0 * m_maxSpeed * m_refresh.GetSeconds (), 1.0);
+
+  m_cells.clear ();
+  m_positions.resize (nNodes);
+  for (uint32_t i = 0; i < nNodes; i++)
+    {
+      Vector position = m_models[i]->GetPosition ();
+      m_positions[i] = position;
+      int64_t x = static_cast<int64_t> (std::floor (position.x / m_cellSize));
+      int64_t y = static_cast<int64_t> (std::floor (position.y / m_cellSize));
+      m_cells[GetCellKey (x, y)].push_back (i);
+    }
+
+  m_lastRefresh = Simulator::Now ();
+  m_valid = true;
+}
+
+void
+BsmNodeGrid::FindNear (const Vector &position, std::vector<uint32_t> &indices)
+{
+  if (!m_valid || Simulator::Now () >= m_lastRefresh + m_refresh)
+    {
+      Refresh ();
+    }
+
+  indices.clear ();
+  int64_t x = static_cast<int64_t> (std::floor (position.x / m_cellSize));
+  int64_t y = static_cast<int64_t> (std::floor (position.y / m_cellSize));
+  for (int64_t dx = -1; dx <= 1; dx++)
+    {
+      for (int64_t dy = -1; dy <= 1; dy++)
+        {
+          std::unordered_map<uint64_t, std::vector<uint32_t> >::const_iterator cell = m_cells.find (GetCellKey (x + dx, y + dy));
+          if (cell != m_cells.end ())
+            {
+              indices.insert (indices.end (), cell->second.begin (), cell->second.end ());
+            }
+        }
+    }
+}
+
+Ptr<Node>
+BsmNodeGrid::GetNode (uint32_t index) const
+{
+  return m_nodes[index];
+}
+
+Ptr<MobilityModel>
+BsmNodeGrid::GetMobilityModel (uint32_t index) const
+{
+  return m_models[index];
+}
+
+BsmScenario::BsmScenario (Ptr<BsmNodeGrid> nodeGrid, uint32_t wavePacketSize, uint32_t numWavePackets)
+  : m_nodeGrid (nodeGrid),
+    m_numWavePackets (numWavePackets),
+    m_wavePacketSize (wavePacketSize)
+{
+  NS_ASSERT (m_nodeGrid != 0);
+}
+
+Ptr<BsmNodeGrid>
+BsmScenario::GetNodeGrid (void) const
+{
+  return m_nodeGrid;
+}
+
+uint32_t
+BsmScenario::GetNumWavePackets (void) const
+{
+  return m_numWavePackets;
+}
+
+Ptr<Packet>
+BsmScenario::CreateBsm (void) const
+{
+  return Create<Packet> (m_wavePacketSize);
+}
+
+void
+BsmScenario::ScheduleTx (Time txTime, BsmApplication *app, uint32_t context)
+{
+  Tx tx;
+  tx.time = txTime;
+  tx.app = app;
+  tx.context = context;
+  m_txs.push_back (tx);
+  std::push_heap (m_txs.begin (), m_txs.end (), std::greater<Tx> ());
+
+  // the event only waits for the earliest transmission
+  if (m_txs.front ().app == app && m_txs.front ().time == txTime)
+    {
+      m_event.Cancel ();
+      m_event = Simulator::ScheduleWithContext (context, txTime - Simulator::Now (), &BsmScenario::DoTx, this);
+    }
+}
+
+void
+BsmScenario::DoTx (void)
+{
+  NS_LOG_FUNCTION (this);
+  Time now = Simulator::Now ();
+  std::pop_heap (m_txs.begin (), m_txs.end (), std::greater<Tx> ());
+  Tx tx = m_txs.back ();
+  m_txs.pop_back ();
+  Time txTime;
+  if (tx.app->GenerateScenarioTraffic (txTime))
+    {
+      tx.time = txTime;
+      m_txs.push_back (tx);
+      std::push_heap (m_txs.begin (), m_txs.end (), std::greater<Tx> ());
+    }
+  if (!m_txs.empty ())
+    {
+      m_event = Simulator::ScheduleWithContext (m_txs.front ().context, m_txs.front ().time - now,
+                                                &BsmScenario::DoTx, this);
+    }
+}
+
 // (Arbitrary) port for establishing socket to transmit WAVE BSMs
 int BsmApplication::wavePort = 9080;
 
@@ -76,6 +308,11 @@ BsmApplication::DoDispose (void)
 {
   NS_LOG_FUNCTION (this);
 
+  m_nodeGrid = 0;
+  m_scenario = 0;
+  m_socket = 0;
+  m_rxPosition = 0;
+
   // chain up
   Application::DoDispose ();
 }
@@ -94,6 +331,10 @@ void BsmApplication::StartApplication () // Called at time specified by Start
   Time totalTxTime = m_TotalSimTime - startTime;
   // total WAVE packets needing to be sent
   m_numWavePackets = (uint32_t) (totalTxTime.GetDouble () / m_waveInterval.GetDouble ());
+  if (m_scenario != 0)
+    {
+      m_numWavePackets = m_scenario->GetNumWavePackets ();
+    }
 
   TypeId tid = TypeId::LookupByName ("ns3::UdpSocketFactory");
 
@@ -105,6 +346,12 @@ void BsmApplication::StartApplication () // Called at time specified by Start
   recvSink->Bind (local);
   recvSink->SetAllowBroadcast (true);
 
+  // resolve senders by address and positions without
+  // searching the interfaces for every BSM received
+  m_nodeGrid->CacheNodes ();
+  m_rxPosition = recvSink->GetNode ()->GetObject<MobilityModel> ();
+  NS_ASSERT (m_rxPosition != 0);
+
   // dest is broadcast address
   InetSocketAddress remote = InetSocketAddress (Ipv4Address ("255.255.255.255"), wavePort);
   recvSink->Connect (remote);
@@ -169,6 +416,13 @@ void BsmApplication::StartApplication () // Called at time specified by Start
   m_prevTxDelay = txDelay;
 
   Time txTime = startTime + tDrift + txDelay;
+  if (m_scenario != 0)
+    {
+      // all nodes share one event list
+      m_socket = recvSink;
+      m_scenario->ScheduleTx (Simulator::Now () + txTime, this, recvSink->GetNode ()->GetId ());
+      return;
+    }
   // schedule transmission of first packet
   Simulator::ScheduleWithContext (recvSink->GetNode ()->GetId (),
                                   txTime, &BsmApplication::GenerateWaveTraffic, this,
@@ -191,7 +445,9 @@ BsmApplication::Setup (Ipv4InterfaceContainer & i,
                        Ptr<WaveBsmStats> waveBsmStats,
                        std::vector<int> * nodesMoving,
                        int chAccessMode,
-                       Time txMaxDelay)
+                       Time txMaxDelay,
+                       Ptr<BsmNodeGrid> nodeGrid,
+                       Ptr<BsmScenario> scenario)
 {
   NS_LOG_FUNCTION (this);
 
@@ -205,6 +461,18 @@ BsmApplication::Setup (Ipv4InterfaceContainer & i,
   m_waveBsmStats = waveBsmStats;
   m_nodesMoving = nodesMoving;
   m_chAccessMode = chAccessMode;
+  m_adhocTxInterfaces = &i;
+  m_nodeId = nodeId;
+  m_txMaxDelay = txMaxDelay;
+
+  m_scenario = scenario;
+  if (m_scenario != 0)
+    {
+      // the ranges are set once for all applications
+      m_nodeGrid = m_scenario->GetNodeGrid ();
+      return;
+    }
+
   m_txSafetyRangesSq.clear ();
   m_txSafetyRangesSq.resize (size, 0);
 
@@ -214,9 +482,18 @@ BsmApplication::Setup (Ipv4InterfaceContainer & i,
       m_txSafetyRangesSq[index] = rangesSq[index];
     }
 
-  m_adhocTxInterfaces = &i;
-  m_nodeId = nodeId;
-  m_txMaxDelay = txMaxDelay;
+  m_waveBsmStats->SetTxSafetyRangesSq (m_txSafetyRangesSq);
+
+  m_nodeGrid = nodeGrid;
+  if (m_nodeGrid == 0)
+    {
+      double maxRangeSq = 0.0;
+      for (int index = 0; index < size; index++)
+        {
+          maxRangeSq = std::max (maxRangeSq, m_txSafetyRangesSq[index]);
+        }
+      m_nodeGrid = Create<BsmNodeGrid> (m_adhocTxInterfaces, m_waveInterval, std::sqrt (maxRangeSq));
+    }
 }
 
 void
@@ -229,89 +506,121 @@ BsmApplication::GenerateWaveTraffic (Ptr<Socket> socket, uint32_t pktSize,
   // more packets to send?
   if (pktCount > 0)
     {
-      // for now, we cannot tell if each node has
-      // started mobility.  so, as an optimization
-      // only send if  this node is moving
-      // if not, then skip
-      int txNodeId = sendingNodeId;
-      Ptr<Node> txNode = GetNode (txNodeId);
-      Ptr<MobilityModel> txPosition = txNode->GetObject<MobilityModel> ();
-      NS_ASSERT (txPosition != 0);
-
-      int senderMoving = m_nodesMoving->at (txNodeId);
-      if (senderMoving != 0)
+      SendBsm (socket, Create<Packet> (pktSize), sendingNodeId);
+
+      Time txTime = GetNextTxInterval (pktInterval);
+      Simulator::ScheduleWithContext (socket->GetNode ()->GetId (),
+                                      txTime, &BsmApplication::GenerateWaveTraffic, this,
+                                      socket, pktSize, pktCount - 1, pktInterval,  socket->GetNode ()->GetId ());
+    }
+  else
+    {
+      socket->Close ();
+    }
+}
+
+bool
+BsmApplication::GenerateScenarioTraffic (Time &txTime)
+{
+  NS_LOG_FUNCTION (this);
+
+  // more packets to send?
+  if (m_numWavePackets > 0)
+    {
+      SendBsm (m_socket, m_scenario->CreateBsm (), m_socket->GetNode ()->GetId ());
+      m_numWavePackets--;
+      txTime = Simulator::Now () + GetNextTxInterval (m_waveInterval);
+      return true;
+    }
+  m_socket->Close ();
+  return false;
+}
+
+void
+BsmApplication::SendBsm (Ptr<Socket> socket, Ptr<Packet> packet, uint32_t sendingNodeId)
+{
+  uint32_t pktSize = packet->GetSize ();
+  // for now, we cannot tell if each node has
+  // started mobility.  so, as an optimization
+  // only send if  this node is moving
+  // if not, then skip
+  int txNodeId = sendingNodeId;
+  Ptr<Node> txNode = GetNode (txNodeId);
+  Ptr<MobilityModel> txPosition = txNode->GetObject<MobilityModel> ();
+  NS_ASSERT (txPosition != 0);
+
+  int senderMoving = m_nodesMoving->at (txNodeId);
+  if (senderMoving != 0)
+    {
+      // send it!
+      socket->Send (packet);
+      // count it
+      m_waveBsmStats->IncTxPktCount ();
+      m_waveBsmStats->IncTxByteCount (pktSize);
+      // reading the count merges the threads, only do it for logging
+      if (m_waveBsmStats->GetLogging () != 0)
         {
-          // send it!
-          socket->Send (Create<Packet> (pktSize));
-          // count it
-          m_waveBsmStats->IncTxPktCount ();
-          m_waveBsmStats->IncTxByteCount (pktSize);
-          int wavePktsSent = m_waveBsmStats->GetTxPktCount ();
-          if ((m_waveBsmStats->GetLogging () != 0) && ((wavePktsSent % 1000) == 0))
+          int64_t wavePktsSent = m_waveBsmStats->GetTxPktCount ();
+          if ((wavePktsSent % 1000) == 0)
             {
               NS_LOG_UNCOND ("Sending WAVE pkt # " << wavePktsSent );
             }
+        }
 
-          // find other nodes within range that would be
-          // expected to receive this broadbast
-          int nRxNodes = m_adhocTxInterfaces->GetN ();
-          for (int i = 0; i < nRxNodes; i++)
-            {
-              Ptr<Node> rxNode = GetNode (i);
-              int rxNodeId = rxNode->GetId ();
+      // find other nodes within range that would be
+      // expected to receive this broadbast; only the
+      // nodes hashed next to the sender can be in range
+      Vector txPos = txPosition->GetPosition ();
+      m_nodeGrid->FindNear (txPos, m_nearNodes);
+      for (std::vector<uint32_t>::const_iterator i = m_nearNodes.begin (); i != m_nearNodes.end (); ++i)
+        {
+          Ptr<Node> rxNode = m_nodeGrid->GetNode (*i);
+          int rxNodeId = rxNode->GetId ();
 
-              if (rxNodeId != txNodeId)
+          if (rxNodeId != txNodeId)
+            {
+              Ptr<MobilityModel> rxPosition = m_nodeGrid->GetMobilityModel (*i);
+              // confirm that the receiving node
+              // has also started moving in the scenario
+              // if it has not started moving, then
+              // it is not a candidate to receive a packet
+              int receiverMoving = m_nodesMoving->at (rxNodeId);
+              if (receiverMoving == 1)
                 {
-                  Ptr<MobilityModel> rxPosition = rxNode->GetObject<MobilityModel> ();
-                  NS_ASSERT (rxPosition != 0);
-                  // confirm that the receiving node
-                  // has also started moving in the scenario
-                  // if it has not started moving, then
-                  // it is not a candidate to receive a packet
-                  int receiverMoving = m_nodesMoving->at (rxNodeId);
-                  if (receiverMoving == 1)
+                  Vector rxPos = rxPosition->GetPosition ();
+                  double dx = txPos.x - rxPos.x;
+                  double dy = txPos.y - rxPos.y;
+                  double dz = txPos.z - rxPos.z;
+                  double distSq = dx * dx + dy * dy + dz * dz;
+                  if (distSq > 0.0)
                     {
-                      double distSq = MobilityHelper::GetDistanceSquaredBetween (txNode, rxNode);
-                      if (distSq > 0.0)
-                        {
-                          // dest node within range?
-                          int rangeCount = m_txSafetyRangesSq.size ();
-                          for (int index = 1; index <= rangeCount; index++)
-                            {
-                              if (distSq <= m_txSafetyRangesSq[index - 1])
-                                {
-                                  // we should expect dest node to receive broadcast pkt
-                                  m_waveBsmStats->IncExpectedRxPktCount (index);
-                                }
-                            }
-                        }
+                      // we should expect dest node to receive broadcast pkt
+                      // within every range that includes it
+                      m_waveBsmStats->CountExpectedRxPkt (distSq);
                     }
                 }
             }
         }
+    }
+}
 
-      // every BSM must be scheduled with a tx time delay
-      // of +/- (5) ms.  See comments in StartApplication().
-      // we handle this as a tx delay of [0..10] ms
-      // from the start of the pktInterval boundary
-      uint32_t d_ns = static_cast<uint32_t> (m_txMaxDelay.GetInteger ());
-      Time txDelay = NanoSeconds (m_unirv->GetInteger (0, d_ns));
-
-      // do not want the tx delay to be cumulative, so
-      // deduct the previous delay value.  thus we adjust
-      // to schedule the next event at the next pktInterval,
-      // plus some new [0..10] ms tx delay
-      Time txTime = pktInterval - m_prevTxDelay + txDelay;
-      m_prevTxDelay = txDelay;
+Time
+BsmApplication::GetNextTxInterval (Time pktInterval)
+{
+  // every BSM must be scheduled with a tx time delay
+  // of +/- (5) ms.  See comments in StartApplication().
+  // we handle this as a tx delay of [0..10] ms
+  // from the start of the pktInterval boundary
+  uint32_t d_ns = static_cast<uint32_t> (m_txMaxDelay.GetInteger ());
+  Time txDelay = NanoSeconds (m_unirv->GetInteger (0, d_ns));
 
-      Simulator::ScheduleWithContext (socket->GetNode ()->GetId (),
-                                      txTime, &BsmApplication::GenerateWaveTraffic, this,
-                                      socket, pktSize, pktCount - 1, pktInterval,  socket->GetNode ()->GetId ());
-    }
-  else
-    {
-      socket->Close ();
-    }
+  // do not want the tx delay to be cumulative, so
+  // deduct the previous delay value.  thus we adjust
+  // to schedule the next event at the next pktInterval,
+  // plus some new [0..10] ms tx delay
+  Time txTime = pktInterval - m_prevTxDelay + txDelay;
+  m_prevTxDelay = txDelay;
+  return txTime;
 }
 
 void BsmApplication::ReceiveWavePacket (Ptr<Socket> socket)
@@ -327,28 +636,22 @@ void BsmApplication::ReceiveWavePacket (Ptr<Socket> socket)
       if (InetSocketAddress::IsMatchingType (senderAddr))
         {
           InetSocketAddress addr = InetSocketAddress::ConvertFrom (senderAddr);
-          int nodes = m_adhocTxInterfaces->GetN ();
-          for (int i = 0; i < nodes; i++)
+          uint32_t txIndex;
+          if (m_nodeGrid->FindAddress (addr.GetIpv4 (), txIndex))
             {
-              if (addr.GetIpv4 () == m_adhocTxInterfaces->GetAddress (i) )
-                {
-                  Ptr<Node> txNode = GetNode (i);
-                  HandleReceivedBsmPacket (txNode, rxNode);
-                }
+              HandleReceivedBsmPacket (txIndex, rxNode);
             }
         }
     }
 }
 
-void BsmApplication::HandleReceivedBsmPacket (Ptr<Node> txNode,
+void BsmApplication::HandleReceivedBsmPacket (uint32_t txIndex,
                                               Ptr<Node> rxNode)
 {
   NS_LOG_FUNCTION (this);
 
   m_waveBsmStats->IncRxPktCount ();
 
-  Ptr<MobilityModel> rxPosition = rxNode->GetObject<MobilityModel> ();
-  NS_ASSERT (rxPosition != 0);
   // confirm that the receiving node
   // has also started moving in the scenario
   // if it has not started moving, then
@@ -357,17 +660,15 @@ void BsmApplication::HandleReceivedBsmPacket (Ptr<Node> txNode,
   int receiverMoving = m_nodesMoving->at (rxNodeId);
   if (receiverMoving == 1)
     {
-      double rxDistSq = MobilityHelper::GetDistanceSquaredBetween (rxNode, txNode);
+      Vector rxPos = m_rxPosition->GetPosition ();
+      Vector txPos = m_nodeGrid->GetMobilityModel (txIndex)->GetPosition ();
+      double dx = rxPos.x - txPos.x;
+      double dy = rxPos.y - txPos.y;
+      double dz = rxPos.z - txPos.z;
+      double rxDistSq = dx * dx + dy * dy + dz * dz;
       if (rxDistSq > 0.0)
         {
-          int rangeCount = m_txSafetyRangesSq.size ();
-          for (int index = 1; index <= rangeCount; index++)
-            {
-              if (rxDistSq <= m_txSafetyRangesSq[index - 1])
-                {
-                  m_waveBsmStats->IncRxPktInRangeCount (index);
-                }
-            }
+          m_waveBsmStats->CountRxPktInRange (rxDistSq);
         }
     }
 }
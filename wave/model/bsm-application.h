@@ -26,8 +26,220 @@
 #include "ns3/wave-bsm-stats.h"
 #include "ns3/random-variable-stream.h"
 #include "ns3/internet-stack-helper.h"
+#include "ns3/ipv4-address.h"
+#include "ns3/mobility-model.h"
+#include "ns3/simple-ref-count.h"
+#include "ns3/event-id.h"
+#include "ns3/packet.h"
+#include <unordered_map>
 
 namespace ns3 {
+
+class BsmApplication;
+/**
+ * \ingroup wave
+ * \brief Spatial hash of the positions of the nodes of an
+ * Ipv4InterfaceContainer, shared by the BsmApplications sending on it.
+ *
+ * Counting the nodes that are expected to receive a BSM used to
+ * measure the distance to every node, O(N^2) per BSM interval.  The
+ * positions are instead hashed into square cells once per refresh
+ * interval, and a sender only looks at the 3x3 cells around it.  A cell
+ * is as wide as the largest safety range, plus twice the distance the
+ * fastest node covers in a refresh interval at its speed when hashed.
+ * The grid listens to the CourseChange of every node and rehashes early
+ * when a node goes faster than that speed, or jumps, so no node within
+ * range of the sender is missed as long as the mobility models notify
+ * every change of velocity (models that accelerate continuously do not).
+ * The exact distance is still checked against the current positions by
+ * the caller.
+ *
+ * The grid also caches the node, mobility model and address of every
+ * interface, so that a receiver finds the sender of a BSM by its address
+ * in constant time.
+ */
+class BsmNodeGrid : public SimpleRefCount<BsmNodeGrid>
+{
+public:
+  /**
+   * \brief Constructor
+   * \param i IPv4 interface container of the nodes
+   * \param refresh time during which the hashed positions are used
+   * \param maxRange the largest safety range, in m
+   * \return none
+   */
+  BsmNodeGrid (Ipv4InterfaceContainer * i, Time refresh, double maxRange);
+
+  /**
+   * \brief Destructor, stops listening to the mobility models
+   */
+  ~BsmNodeGrid ();
+
+  /**
+   * \brief Cache the node, mobility model and address of every interface,
+   * unless done already.  The interfaces must all be assigned.
+   * \return none
+   */
+  void CacheNodes (void);
+
+  /**
+   * \brief Find the interface of an address
+   * \param address the address, usually of a sender
+   * \param index set to the index into the interface container
+   * \return whether the address is one of the interface container
+   */
+  bool FindAddress (const Ipv4Address &address, uint32_t &index) const;
+
+  /**
+   * \brief Find the nodes that may be within the largest safety range
+   * of a position, rehashing the positions first if they are stale
+   * \param position the position, usually of a sender
+   * \param indices cleared, then filled with the candidate indices
+   * into the interface container
+   * \return none
+   */
+  void FindNear (const Vector &position, std::vector<uint32_t> &indices);
+
+  /**
+   * \param index index into the interface container
+   * \return the node
+   */
+  Ptr<Node> GetNode (uint32_t index) const;
+
+  /**
+   * \param index index into the interface container
+   * \return the mobility model of the node
+   */
+  Ptr<MobilityModel> GetMobilityModel (uint32_t index) const;
+
+private:
+  /**
+   * \brief Rehash the current positions of all nodes
+   * \return none
+   */
+  void Refresh (void);
+
+  /**
+   * \brief Invalidate the hashed positions if a node goes faster than
+   * the cells allow for, or has jumped
+   * \param grid the grid
+   * \param index index of the node into the interface container
+   * \param model the mobility model of the node
+   * \return none
+   */
+  static void CourseChanged (BsmNodeGrid *grid, uint32_t index, Ptr<const MobilityModel> model);
+
+  /**
+   * \brief Stop listening to the CourseChange of the cached nodes
+   * \return none
+   */
+  void DisconnectCourseChanges (void);
+
+  /**
+   * \param x x coordinate of the cell
+   * \param y y coordinate of the cell
+   * \return the key of the cell
+   */
+  static uint64_t GetCellKey (int64_t x, int64_t y);
+
+  Ipv4InterfaceContainer * m_interfaces; ///< nodes to hash
+  std::vector<Ptr<Node> > m_nodes; ///< node of each interface
+  std::vector<Ptr<MobilityModel> > m_models; ///< mobility of each node
+  /// CourseChange callback connected to each mobility model
+  std::vector<Callback<void, Ptr<const MobilityModel> > > m_courseChanges;
+  std::vector<Vector> m_positions; ///< position of each node when hashed
+  /// index of the interface of each address
+  std::unordered_map<Ipv4Address, uint32_t, Ipv4AddressHash> m_addresses;
+  Time m_refresh; ///< refresh interval
+  Time m_lastRefresh; ///< time the positions were hashed
+  bool m_valid; ///< whether the positions were ever hashed
+  double m_maxRange; ///< largest safety range, m
+  double m_cellSize; ///< width of a cell, m
+  double m_maxSpeed; ///< largest speed the cells allow for, m/s
+  /// indices of the nodes in each cell
+  std::unordered_map<uint64_t, std::vector<uint32_t> > m_cells;
+};
+
+/**
+ * \ingroup wave
+ * \brief What the BsmApplications of one WaveBsmHelper::Install share
+ * in high-scale mode.
+ *
+ * The node grid, the number of BSMs and the BSM size are the same for
+ * every application and are kept here once.  Instead of one pending
+ * event per node, the next transmissions of all nodes are kept in a heap
+ * ordered by their jittered time, and one event at a time waits for the
+ * earliest, in the context of its node.
+ */
+class BsmScenario : public SimpleRefCount<BsmScenario>
+{
+public:
+  /**
+   * \brief Constructor
+   * \param nodeGrid positions of the nodes, shared by the applications
+   * \param wavePacketSize the size, in bytes, of a WAVE BSM
+   * \param numWavePackets the number of BSMs every node sends
+   * \return none
+   */
+  BsmScenario (Ptr<BsmNodeGrid> nodeGrid, uint32_t wavePacketSize, uint32_t numWavePackets);
+
+  /**
+   * \return positions of the nodes
+   */
+  Ptr<BsmNodeGrid> GetNodeGrid (void) const;
+
+  /**
+   * \return the number of BSMs every node sends
+   */
+  uint32_t GetNumWavePackets (void) const;
+
+  /**
+   * \return a new BSM, with its own packet uid
+   */
+  Ptr<Packet> CreateBsm (void) const;
+
+  /**
+   * \brief Add the next transmission of an application
+   * \param txTime when to transmit
+   * \param app the application, which outlives the simulation
+   * \param context the id of its node
+   * \return none
+   */
+  void ScheduleTx (Time txTime, BsmApplication *app, uint32_t context);
+
+private:
+  /**
+   * \brief Transmit the earliest BSM, then wait for the next one.  BSMs
+   * due at the same time get one event each, so that every transmission
+   * runs in the context of its own node.
+   * \return none
+   */
+  void DoTx (void);
+
+  /// a pending transmission
+  struct Tx
+  {
+    Time time; ///< when to transmit
+    BsmApplication *app; ///< the application
+    uint32_t context; ///< the id of its node
+
+    /**
+     * \param o the other transmission
+     * \return whether this transmission is later, for a heap of the earliest
+     */
+    bool operator > (const Tx &o) const
+    {
+      return time > o.time;
+    }
+  };
+
+  Ptr<BsmNodeGrid> m_nodeGrid; ///< positions of the nodes
+  uint32_t m_numWavePackets; ///< BSMs per node
+  uint32_t m_wavePacketSize; ///< bytes of a BSM
+  std::vector<Tx> m_txs; ///< heap of pending transmissions, earliest first
+  EventId m_event; ///< the one event waiting for the earliest transmission
+};
+
 /**
  * \ingroup wave
  * \brief The BsmApplication class sends and receives the
@@ -70,6 +282,12 @@ public:
    * \param nodesMoving of whether or not node(s) are moving
    * \param mode
    * \param txDelay
+   * \param nodeGrid positions of the nodes of the interface container,
+   * shared by the applications installed on it; a private one is created
+   * if it is null
+   * \param scenario tables shared by the applications in high-scale mode,
+   * which replace nodeGrid; the caller then sets the safety ranges of
+   * waveBsmStats once
    * \return none
    */
   void Setup (Ipv4InterfaceContainer & i,
@@ -82,7 +300,9 @@ public:
               Ptr<WaveBsmStats> waveBsmStats,
               std::vector<int> * nodesMoving,
               int mode,
-              Time txDelay);
+              Time txDelay,
+              Ptr<BsmNodeGrid> nodeGrid = 0,
+              Ptr<BsmScenario> scenario = 0);
 
   /**
   * Assign a fixed random variable stream number to the random variables
@@ -104,6 +324,8 @@ protected:
   virtual void DoDispose (void);
 
 private:
+  friend class BsmScenario;
+
   // inherited from Application base class.
   virtual void StartApplication (void);    ///< Called at time specified by Start
   virtual void StopApplication (void);     ///< Called at time specified by Stop
@@ -122,6 +344,30 @@ private:
                             uint32_t pktCount, Time pktInterval,
                             uint32_t sendingNodeId);
 
+  /**
+   * \brief Transmits a WAVE BSM packet in high-scale mode
+   * \param txTime set to the time of the next transmission
+   * \return whether there is a next transmission
+   */
+  bool GenerateScenarioTraffic (Time &txTime);
+
+  /**
+   * \brief Transmits a WAVE BSM packet, if the sender is moving, and
+   * counts the nodes expected to receive it
+   * \param socket socket to use for transmission
+   * \param packet the WAVE BSM packet
+   * \param sendingNodeId
+   * \return none
+   */
+  void SendBsm (Ptr<Socket> socket, Ptr<Packet> packet, uint32_t sendingNodeId);
+
+  /**
+   * \brief Draw the tx delay of the next BSM
+   * \param pktInterval the interval between BSMs
+   * \return the time until the next BSM
+   */
+  Time GetNextTxInterval (Time pktInterval);
+
   /**
    * \brief Receive a WAVE BSM packet
    * \param socket the receiving socket
@@ -131,11 +377,11 @@ private:
 
   /**
    * \brief Handle the receipt of a WAVE BSM packet from sender to receiver
-   * \param txNode the sending node
+   * \param txIndex index of the sending node into the interface container
    * \param rxNode the receiving node
    * \return none
    */
-  void HandleReceivedBsmPacket (Ptr<Node> txNode,
+  void HandleReceivedBsmPacket (uint32_t txIndex,
                                 Ptr<Node> rxNode);
 
   /**
@@ -162,6 +408,11 @@ private:
   double m_gpsAccuracyNs; ///< GPS accuracy
   Ipv4InterfaceContainer * m_adhocTxInterfaces; ///< transmit interfaces
   std::vector<int> * m_nodesMoving; ///< nodes moving
+  Ptr<BsmNodeGrid> m_nodeGrid; ///< positions of the nodes
+  std::vector<uint32_t> m_nearNodes; ///< scratch list of candidate receivers
+  Ptr<BsmScenario> m_scenario; ///< shared tables in high-scale mode
+  Ptr<Socket> m_socket; ///< socket of the BSMs in high-scale mode
+  Ptr<MobilityModel> m_rxPosition; ///< mobility of the receiving node
   Ptr<UniformRandomVariable> m_unirv; ///< random variable
   int m_nodeId; ///< node ID
   /// WAVE channel access mode.  0=continuous PHY; 1=channel-switching
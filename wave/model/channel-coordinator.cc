@@ -18,6 +18,7 @@
 #include "channel-coordinator.h"
 #include "ns3/log.h"
 #include "ns3/simulator.h"
+#include <algorithm>
 
 namespace ns3 {
 
@@ -33,6 +34,224 @@ ChannelCoordinationListener::~ChannelCoordinationListener (void)
 
 /****************************************************************/
 
+ChannelCoordinationClock::ChannelCoordinationClock (Time cchi, Time schi, Time gi)
+  : m_cchi (cchi),
+    m_schi (schi),
+    m_gi (gi),
+    m_guardCount (0),
+    m_lastGuardSlot (Seconds (-1.0))
+{
+  NS_LOG_FUNCTION (this << cchi << schi << gi);
+}
+
+ChannelCoordinationClock::Clocks &
+ChannelCoordinationClock::GetClocks (void)
+{
+  static Clocks clocks;
+  return clocks;
+}
+
+Ptr<ChannelCoordinationClock>
+ChannelCoordinationClock::Get (Time cchi, Time schi, Time gi)
+{
+  NS_LOG_FUNCTION (cchi << schi << gi);
+  Clocks &clocks = GetClocks ();
+  for (Clocks::const_iterator i = clocks.begin (); i != clocks.end (); ++i)
+    {
+      if ((*i)->m_cchi == cchi && (*i)->m_schi == schi && (*i)->m_gi == gi)
+        {
+          return *i;
+        }
+    }
+  if (clocks.empty ())
+    {
+      // the events of the clocks do not survive the simulator
+      Simulator::ScheduleDestroy (&ChannelCoordinationClock::DestroyClocks);
+    }
+  Ptr<ChannelCoordinationClock> clock = Create<ChannelCoordinationClock> (cchi, schi, gi);
+  clocks.push_back (clock);
+  return clock;
+}
+
+void
+ChannelCoordinationClock::DestroyClocks (void)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  Clocks &clocks = GetClocks ();
+  for (Clocks::iterator i = clocks.begin (); i != clocks.end (); ++i)
+    {
+      (*i)->m_coordinators.clear ();
+      (*i)->m_coordination = EventId ();
+    }
+  clocks.clear ();
+}
+
+void
+ChannelCoordinationClock::Join (ChannelCoordinator *coordinator, bool notifyNow)
+{
+  NS_LOG_FUNCTION (this << coordinator << notifyNow);
+  m_coordinators.push_back (coordinator);
+  if (m_coordinators.size () == 1)
+    {
+      Start (notifyNow);
+    }
+  else if (notifyNow && m_lastGuardSlot == Now ())
+    {
+      // joined after the others were notified of this guard slot
+      coordinator->NotifyGuardSlot ((m_guardCount % 2) == 1);
+    }
+}
+
+void
+ChannelCoordinationClock::Start (bool notifyNow)
+{
+  NS_LOG_FUNCTION (this << notifyNow);
+  // sync intervals are aligned with the beginning of second 0
+  Time interval = TimeStep (Now ().GetTimeStep () % (m_cchi + m_schi).GetTimeStep ());
+  if (interval.IsZero () && notifyNow)
+    {
+      m_guardCount = 0;
+      NotifyGuardSlot ();
+    }
+  else if (interval < m_gi)
+    {
+      // in the guard slot of CCHI, the next one is in SCHI
+      m_guardCount = 1;
+      m_coordination = Simulator::Schedule (m_gi - interval, &ChannelCoordinationClock::NotifyCchSlot, this);
+    }
+  else if (interval < m_cchi)
+    {
+      m_guardCount = 1;
+      m_coordination = Simulator::Schedule (m_cchi - interval, &ChannelCoordinationClock::NotifyGuardSlot, this);
+    }
+  else if (interval < m_cchi + m_gi)
+    {
+      m_guardCount = 0;
+      m_coordination = Simulator::Schedule (m_cchi + m_gi - interval, &ChannelCoordinationClock::NotifySchSlot, this);
+    }
+  else
+    {
+      m_guardCount = 0;
+      m_coordination = Simulator::Schedule (m_cchi + m_schi - interval, &ChannelCoordinationClock::NotifyGuardSlot, this);
+    }
+}
+
+void
+ChannelCoordinationClock::Leave (ChannelCoordinator *coordinator)
+{
+  NS_LOG_FUNCTION (this << coordinator);
+  std::vector<ChannelCoordinator *>::iterator i = std::find (m_coordinators.begin (), m_coordinators.end (), coordinator);
+  if (i == m_coordinators.end ())
+    {
+      return;
+    }
+  m_coordinators.erase (i);
+  if (!m_coordinators.empty ())
+    {
+      return;
+    }
+  if (!m_coordination.IsExpired ())
+    {
+      m_coordination.Cancel ();
+    }
+  m_guardCount = 0;
+  m_lastGuardSlot = Seconds (-1.0);
+  Clocks &clocks = GetClocks ();
+  Clocks::iterator c = std::find (clocks.begin (), clocks.end (), Ptr<ChannelCoordinationClock> (this));
+  if (c != clocks.end ())
+    {
+      clocks.erase (c);
+    }
+}
+
+void
+ChannelCoordinationClock::NotifySchSlot (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_coordination = Simulator::Schedule (m_schi - m_gi, &ChannelCoordinationClock::NotifyGuardSlot, this);
+  // a listener may make its coordinator leave
+  std::vector<ChannelCoordinator *> coordinators (m_coordinators);
+  for (std::vector<ChannelCoordinator *>::iterator i = coordinators.begin (); i != coordinators.end (); ++i)
+    {
+      Dispatch (*i, SCH_SLOT);
+    }
+}
+
+void
+ChannelCoordinationClock::NotifyCchSlot (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_coordination = Simulator::Schedule (m_cchi - m_gi, &ChannelCoordinationClock::NotifyGuardSlot, this);
+  std::vector<ChannelCoordinator *> coordinators (m_coordinators);
+  for (std::vector<ChannelCoordinator *>::iterator i = coordinators.begin (); i != coordinators.end (); ++i)
+    {
+      Dispatch (*i, CCH_SLOT);
+    }
+}
+
+void
+ChannelCoordinationClock::NotifyGuardSlot (void)
+{
+  NS_LOG_FUNCTION (this);
+  bool inCchi = ((m_guardCount % 2) == 0);
+  if (inCchi)
+    {
+      m_coordination = Simulator::Schedule (m_gi, &ChannelCoordinationClock::NotifyCchSlot, this);
+    }
+  else
+    {
+      m_coordination = Simulator::Schedule (m_gi, &ChannelCoordinationClock::NotifySchSlot, this);
+    }
+  m_guardCount++;
+  m_lastGuardSlot = Now ();
+  std::vector<ChannelCoordinator *> coordinators (m_coordinators);
+  for (std::vector<ChannelCoordinator *>::iterator i = coordinators.begin (); i != coordinators.end (); ++i)
+    {
+      Dispatch (*i, inCchi ? GUARD_SLOT_IN_CCHI : GUARD_SLOT_IN_SCHI);
+    }
+}
+
+void
+ChannelCoordinationClock::Dispatch (ChannelCoordinator *coordinator, enum Slot slot)
+{
+  if (coordinator->m_context != Simulator::GetContext ())
+    {
+      // the notifications of a coordinator happen in the context it was
+      // started in, as they did when it ran its own events
+      Simulator::ScheduleWithContext (coordinator->m_context, Seconds (0), &ChannelCoordinationClock::Deliver,
+                                      Ptr<ChannelCoordinationClock> (this), Ptr<ChannelCoordinator> (coordinator), slot);
+      return;
+    }
+  Deliver (Ptr<ChannelCoordinator> (coordinator), slot);
+}
+
+void
+ChannelCoordinationClock::Deliver (Ptr<ChannelCoordinator> coordinator, enum Slot slot)
+{
+  // a listener of another coordinator may have made this one leave
+  if (PeekPointer (coordinator->m_clock) != this)
+    {
+      return;
+    }
+  switch (slot)
+    {
+    case GUARD_SLOT_IN_CCHI:
+      coordinator->NotifyGuardSlot (true);
+      break;
+    case GUARD_SLOT_IN_SCHI:
+      coordinator->NotifyGuardSlot (false);
+      break;
+    case CCH_SLOT:
+      coordinator->NotifyCchSlot ();
+      break;
+    case SCH_SLOT:
+      coordinator->NotifySchSlot ();
+      break;
+    }
+}
+
+/****************************************************************/
+
 NS_OBJECT_ENSURE_REGISTERED (ChannelCoordinator);
 
 TypeId
@@ -59,7 +278,8 @@ ChannelCoordinator::GetTypeId (void)
 }
 
 ChannelCoordinator::ChannelCoordinator ()
-  : m_guardCount (0)
+  : m_started (false),
+    m_context (Simulator::NO_CONTEXT)
 {
   NS_LOG_FUNCTION (this);
 }
@@ -282,10 +502,9 @@ Time
 ChannelCoordinator::GetIntervalTime (Time duration) const
 {
   NS_LOG_FUNCTION (this << duration);
+  // sync intervals are aligned with the beginning of second 0
   Time future = Now () + duration;
-  Time sync = GetSyncInterval ();
-  uint32_t n = future.GetMilliSeconds () / sync.GetMilliSeconds ();
-  return future - MilliSeconds (n * sync.GetMilliSeconds ());
+  return TimeStep (future.GetTimeStep () % GetSyncInterval ().GetTimeStep ());
 }
 
 Time
@@ -301,6 +520,7 @@ ChannelCoordinator::RegisterListener (Ptr<ChannelCoordinationListener> listener)
   NS_LOG_FUNCTION (this << listener);
   NS_ASSERT (listener != 0);
   m_listeners.push_back (listener);
+  JoinClock (false);
 }
 
 void
@@ -313,9 +533,13 @@ ChannelCoordinator::UnregisterListener (Ptr<ChannelCoordinationListener> listene
       if ((*i) == listener)
         {
           m_listeners.erase (i);
-          return;
+          break;
         }
     }
+  if (m_listeners.empty ())
+    {
+      LeaveClock ();
+    }
 }
 
 void
@@ -323,6 +547,7 @@ ChannelCoordinator::UnregisterAllListeners (void)
 {
   NS_LOG_FUNCTION (this);
   m_listeners.clear ();
+  LeaveClock ();
 }
 
 void
@@ -339,25 +564,47 @@ ChannelCoordinator::StartChannelCoordination (void)
     {
       NS_FATAL_ERROR ("the channel intervals configured for channel coordination events are invalid");
     }
-  m_guardCount = 0;
-  NotifyGuardSlot ();
+  m_started = true;
+  m_context = Simulator::GetContext ();
+  JoinClock (true);
 }
 
 void
 ChannelCoordinator::StopChannelCoordination (void)
 {
-  if (!m_coordination.IsExpired ())
+  m_started = false;
+  LeaveClock ();
+}
+
+void
+ChannelCoordinator::JoinClock (bool notifyNow)
+{
+  if (!m_started || m_clock != 0 || m_listeners.empty ())
     {
-      m_coordination.Cancel ();
+      return;
     }
-  m_guardCount = 0;
+  NS_LOG_FUNCTION (this << notifyNow);
+  // devices with the same intervals share the events of one clock
+  m_clock = ChannelCoordinationClock::Get (m_cchi, m_schi, m_gi);
+  m_clock->Join (this, notifyNow);
+}
+
+void
+ChannelCoordinator::LeaveClock (void)
+{
+  if (m_clock == 0)
+    {
+      return;
+    }
+  NS_LOG_FUNCTION (this);
+  m_clock->Leave (this);
+  m_clock = 0;
 }
 
 void
 ChannelCoordinator::NotifySchSlot (void)
 {
   NS_LOG_FUNCTION (this);
-  m_coordination = Simulator::Schedule (GetSchSlot (), &ChannelCoordinator::NotifyGuardSlot, this);
   for (ListenersI i = m_listeners.begin (); i != m_listeners.end (); ++i)
     {
       (*i)->NotifySchSlotStart (GetSchSlot ());
@@ -368,7 +615,6 @@ void
 ChannelCoordinator::NotifyCchSlot (void)
 {
   NS_LOG_FUNCTION (this);
-  m_coordination = Simulator::Schedule (GetCchSlot (), &ChannelCoordinator::NotifyGuardSlot, this);
   for (ListenersI i = m_listeners.begin (); i != m_listeners.end (); ++i)
     {
       (*i)->NotifyCchSlotStart (GetCchSlot ());
@@ -376,24 +622,14 @@ ChannelCoordinator::NotifyCchSlot (void)
 }
 
 void
-ChannelCoordinator::NotifyGuardSlot (void)
+ChannelCoordinator::NotifyGuardSlot (bool inCchi)
 {
-  NS_LOG_FUNCTION (this);
+  NS_LOG_FUNCTION (this << inCchi);
   Time guardSlot = GetGuardInterval ();
-  bool inCchi = ((m_guardCount % 2) == 0);
-  if (inCchi)
-    {
-      m_coordination = Simulator::Schedule (guardSlot, &ChannelCoordinator::NotifyCchSlot, this);
-    }
-  else
-    {
-      m_coordination = Simulator::Schedule (guardSlot, &ChannelCoordinator::NotifySchSlot, this);
-    }
   for (ListenersI i = m_listeners.begin (); i != m_listeners.end (); ++i)
     {
       (*i)->NotifyGuardSlotStart (guardSlot, inCchi);
     }
-  m_guardCount++;
 }
 
 } // namespace ns3
@@ -45,6 +45,119 @@ public:
    */
   virtual void NotifyGuardSlotStart (Time duration, bool cchi) = 0;
 };
+
+class ChannelCoordinator;
+
+/**
+ * \ingroup wave
+ * \brief the slot boundaries shared by all channel coordinators with the
+ * same CCH, SCH and guard intervals.
+ *
+ * Since all devices are supposed to be synchronized by "perfect GPS", their
+ * slots start at the same times.  Rather than every ChannelCoordinator
+ * running its own chain of events, one event per slot boundary notifies all
+ * coordinators that joined the clock, which in turn notify their listeners.
+ * A coordinator initialized in another context than the one of the slot
+ * event is notified by an event of its own context at the same time, so
+ * the channel switches of a node and the events they schedule keep the
+ * context of the node.  The clocks are released when the simulator is
+ * destroyed.
+ */
+class ChannelCoordinationClock : public SimpleRefCount<ChannelCoordinationClock>
+{
+public:
+  /**
+   * \param cchi the CCH interval
+   * \param schi the SCH interval
+   * \param gi the guard interval
+   */
+  ChannelCoordinationClock (Time cchi, Time schi, Time gi);
+  /**
+   * \param cchi the CCH interval
+   * \param schi the SCH interval
+   * \param gi the guard interval
+   * \return the clock of these intervals, created if there is none yet
+   */
+  static Ptr<ChannelCoordinationClock> Get (Time cchi, Time schi, Time gi);
+  /**
+   * \param coordinator the coordinator to notify of slot starts from now on
+   * \param notifyNow whether to notify the coordinator of a guard slot
+   * starting now, if there is one
+   *
+   * The clock is started by the first coordinator, in phase with the
+   * sync intervals since time 0.
+   */
+  void Join (ChannelCoordinator *coordinator, bool notifyNow);
+  /**
+   * \param coordinator the coordinator not to notify any more
+   *
+   * The clock stops when the last coordinator leaves it.
+   */
+  void Leave (ChannelCoordinator *coordinator);
+
+private:
+  /// clocks typedef
+  typedef std::vector<Ptr<ChannelCoordinationClock> > Clocks;
+  /**
+   * \return the clocks of all interval configurations
+   */
+  static Clocks & GetClocks (void);
+  /**
+   * stop all clocks and release them
+   */
+  static void DestroyClocks (void);
+  /**
+   * \param notifyNow whether to notify a guard slot starting now
+   *
+   * schedule the next slot boundary after the current time
+   */
+  void Start (bool notifyNow);
+  /**
+   * notify coordinators of a SCH slot start
+   */
+  void NotifySchSlot (void);
+  /**
+   * notify coordinators of a CCH slot start
+   */
+  void NotifyCchSlot (void);
+  /**
+   * notify coordinators of a guard slot start
+   */
+  void NotifyGuardSlot (void);
+
+  /// the slot starts a coordinator is notified of
+  enum Slot
+  {
+    GUARD_SLOT_IN_CCHI, ///< guard slot in the GI of CCHI
+    GUARD_SLOT_IN_SCHI, ///< guard slot in the GI of SCHI
+    CCH_SLOT,           ///< CCH slot
+    SCH_SLOT,           ///< SCH slot
+  };
+  /**
+   * \param coordinator the coordinator to notify
+   * \param slot the slot starting now
+   *
+   * notify the coordinator now if it is in the current context, else
+   * schedule the notification in its context
+   */
+  void Dispatch (ChannelCoordinator *coordinator, enum Slot slot);
+  /**
+   * \param coordinator the coordinator to notify
+   * \param slot the slot starting now
+   *
+   * notify the coordinator, unless it left the clock meanwhile
+   */
+  void Deliver (Ptr<ChannelCoordinator> coordinator, enum Slot slot);
+
+  Time m_cchi;  ///< CchInterval
+  Time m_schi;  ///< SchInterval
+  Time m_gi;    ///< GuardInterval
+  std::vector<ChannelCoordinator *> m_coordinators; ///< joined coordinators, unregister on dispose
+  uint32_t m_guardCount; ///< guard count
+  Time m_lastGuardSlot; ///< start of the last guard slot notified
+  EventId m_coordination; ///< coordination event
+};
+
 /**
  * \ingroup wave
  * \brief ChannelCoordinator deals with channel coordination in data plane (see 1609.4 chapter 5.2)
@@ -189,7 +302,9 @@ public:
    * \param listener the new listener for channel coordination events.
    *
    * Add the input listener to the list of objects to be notified of
-   * channel coordination events.
+   * channel coordination events.  A coordinator without listeners makes
+   * no events; the methods above compute the intervals from the current
+   * time and work all the same.
    */
   void RegisterListener (Ptr<ChannelCoordinationListener> listener);
   /**
@@ -204,6 +319,8 @@ public:
   void UnregisterAllListeners (void);
 
 private:
+  friend class ChannelCoordinationClock;
+
   virtual void DoDispose (void);
   virtual void DoInitialize (void);
 
@@ -211,6 +328,15 @@ private:
    * start to make channel coordination events
    */
   void StartChannelCoordination (void);
+  /**
+   * join the clock, as long as coordination is started and someone listens
+   * \param notifyNow whether to notify listeners of a guard slot starting now
+   */
+  void JoinClock (bool notifyNow);
+  /**
+   * leave the clock, no more events
+   */
+  void LeaveClock (void);
   /**
    * stop channel coordination events
    */
@@ -225,8 +351,9 @@ private:
   void NotifyCchSlot (void);
   /**
    * notify listeners of a guard slot start
+   * \param inCchi whether the guard slot is in the GI of CCHI or SCHI.
    */
-  void NotifyGuardSlot (void);
+  void NotifyGuardSlot (bool inCchi);
   /**
    * \return SCH channel access time which is SchInterval - GuardInterval, default 46ms
    */
@@ -246,8 +373,9 @@ private:
   typedef std::vector<Ptr<ChannelCoordinationListener> >::iterator ListenersI;
   Listeners m_listeners; ///< listeners
 
-  uint32_t m_guardCount; ///< guard count
-  EventId m_coordination; ///< coordination event
+  bool m_started; ///< whether channel coordination is started
+  uint32_t m_context; ///< the context channel coordination was started in
+  Ptr<ChannelCoordinationClock> m_clock; ///< the clock making coordination events, null while nobody listens
 };
 
 }
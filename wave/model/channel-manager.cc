@@ -36,26 +36,23 @@ ChannelManager::GetTypeId (void)
   return tid;
 }
 
+constexpr uint32_t ChannelManager::WAVE_CHANNELS;
+constexpr uint32_t ChannelManager::WaveChannels[];
+constexpr uint32_t ChannelManager::Schs[];
+
 ChannelManager::ChannelManager ()
 {
   NS_LOG_FUNCTION (this);
-  m_channels.insert (std::make_pair (CCH, new WaveChannel (CCH)));
-  m_channels.insert (std::make_pair (SCH1, new WaveChannel (SCH1)));
-  m_channels.insert (std::make_pair (SCH2, new WaveChannel (SCH2)));
-  m_channels.insert (std::make_pair (SCH3, new WaveChannel (SCH3)));
-  m_channels.insert (std::make_pair (SCH4, new WaveChannel (SCH4)));
-  m_channels.insert (std::make_pair (SCH5, new WaveChannel (SCH5)));
-  m_channels.insert (std::make_pair (SCH6, new WaveChannel (SCH6)));
+  m_channels.reserve (WAVE_CHANNELS);
+  for (uint32_t slot = 0; slot < WAVE_CHANNELS; ++slot)
+    {
+      m_channels.push_back (WaveChannel (SCH1 + 2 * slot));
+    }
 }
 
 ChannelManager::~ChannelManager ()
 {
   NS_LOG_FUNCTION (this);
-  std::map<uint32_t, WaveChannel *> ::iterator i;
-  for (i = m_channels.begin (); i != m_channels.end (); ++i)
-    {
-      delete (i->second);
-    }
   m_channels.clear ();
 }
 
@@ -70,109 +67,61 @@ std::vector<uint32_t>
 ChannelManager::GetSchs (void)
 {
   NS_LOG_FUNCTION_NOARGS ();
-  std::vector<uint32_t> schs;
-  schs.push_back (SCH1);
-  schs.push_back (SCH2);
-  schs.push_back (SCH3);
-  schs.push_back (SCH4);
-  schs.push_back (SCH5);
-  schs.push_back (SCH6);
-  return schs;
+  return std::vector<uint32_t> (Schs, Schs + WAVE_CHANNELS - 1);
 }
 
 std::vector<uint32_t>
 ChannelManager::GetWaveChannels (void)
 {
   NS_LOG_FUNCTION_NOARGS ();
-  std::vector<uint32_t> channels;
-  channels.push_back (CCH);
-  channels.push_back (SCH1);
-  channels.push_back (SCH2);
-  channels.push_back (SCH3);
-  channels.push_back (SCH4);
-  channels.push_back (SCH5);
-  channels.push_back (SCH6);
-  return channels;
+  return std::vector<uint32_t> (WaveChannels, WaveChannels + WAVE_CHANNELS);
 }
 
 uint32_t
 ChannelManager::GetNumberOfWaveChannels (void)
 {
   NS_LOG_FUNCTION_NOARGS ();
-  static  uint32_t NumberOfWaveChannels  = GetWaveChannels ().size ();
-  return NumberOfWaveChannels;
-}
-
-bool
-ChannelManager::IsCch (uint32_t channelNumber)
-{
-  NS_LOG_FUNCTION_NOARGS ();
-  return channelNumber == CCH;
-}
-
-bool
-ChannelManager::IsSch (uint32_t channelNumber)
-{
-  NS_LOG_FUNCTION_NOARGS ();
-  if (channelNumber < SCH1 || channelNumber > SCH6)
-    {
-      return false;
-    }
-  if (channelNumber % 2 == 1)
-    {
-      return false;
-    }
-  return (channelNumber != CCH);
-}
-
-bool
-ChannelManager::IsWaveChannel (uint32_t channelNumber)
-{
-  NS_LOG_FUNCTION_NOARGS ();
-  if (channelNumber < SCH1 || channelNumber > SCH6)
-    {
-      return false;
-    }
-  if (channelNumber % 2 == 1)
-    {
-      return false;
-    }
-  return true;
+  return WAVE_CHANNELS;
 }
 
 uint32_t
 ChannelManager::GetOperatingClass (uint32_t channelNumber)
 {
   NS_LOG_FUNCTION (this << channelNumber);
-  return m_channels[channelNumber]->operatingClass;
+  NS_ASSERT (IsWaveChannel (channelNumber));
+  return m_channels[GetWaveChannelSlot (channelNumber)].operatingClass;
 }
 
 bool
 ChannelManager::GetManagementAdaptable (uint32_t channelNumber)
 {
   NS_LOG_FUNCTION (this << channelNumber);
-  return m_channels[channelNumber]->adaptable;
+  NS_ASSERT (IsWaveChannel (channelNumber));
+  return m_channels[GetWaveChannelSlot (channelNumber)].adaptable;
 }
 
 WifiMode
 ChannelManager::GetManagementDataRate (uint32_t channelNumber)
 {
   NS_LOG_FUNCTION (this << channelNumber);
-  return m_channels[channelNumber]->dataRate;
+  NS_ASSERT (IsWaveChannel (channelNumber));
+  return m_channels[GetWaveChannelSlot (channelNumber)].dataRate;
 }
 
 WifiPreamble
 ChannelManager::GetManagementPreamble (uint32_t channelNumber)
 {
   NS_LOG_FUNCTION (this << channelNumber);
-  return m_channels[channelNumber]->preamble;
+  NS_ASSERT (IsWaveChannel (channelNumber));
+  return m_channels[GetWaveChannelSlot (channelNumber)].preamble;
 }
 
 uint32_t
 ChannelManager::GetManagementPowerLevel (uint32_t channelNumber)
 {
   NS_LOG_FUNCTION (this << channelNumber);
-  return m_channels[channelNumber]->txPowerLevel;
+  NS_ASSERT (IsWaveChannel (channelNumber));
+  return m_channels[GetWaveChannelSlot (channelNumber)].txPowerLevel;
 }
 
 } // namespace ns3
@@ -17,7 +17,6 @@
  */
 #ifndef CHANNEL_MANAGER_H
 #define CHANNEL_MANAGER_H
-#include <map>
 #include <vector>
 #include "ns3/object.h"
 #include "ns3/wifi-mode.h"
@@ -92,17 +91,42 @@ public:
    * \param channelNumber the specific channel
    * \return whether channel is valid CCH channel
    */
-  static bool IsCch (uint32_t channelNumber);
+  static constexpr bool IsCch (uint32_t channelNumber)
+  {
+    return channelNumber == CCH;
+  }
   /**
    * \param channelNumber the specific channel
    * \return whether channel is valid SCH channel
    */
-  static bool IsSch (uint32_t channelNumber);
+  static constexpr bool IsSch (uint32_t channelNumber)
+  {
+    return IsWaveChannel (channelNumber) && channelNumber != CCH;
+  }
   /**
    * \param channelNumber the specific channel
    * \return whether channel is valid WAVE channel
    */
-  static bool IsWaveChannel (uint32_t channelNumber);
+  static constexpr bool IsWaveChannel (uint32_t channelNumber)
+  {
+    return channelNumber >= SCH1 && channelNumber <= SCH6 && channelNumber % 2 == 0;
+  }
+  /**
+   * \param channelNumber a valid WAVE channel
+   * \return the slot of the channel in tables of WAVE channels, from 0 for
+   * SCH1 (172) to 6 for SCH6 (184)
+   */
+  static constexpr uint32_t GetWaveChannelSlot (uint32_t channelNumber)
+  {
+    return (channelNumber - SCH1) / 2;
+  }
+
+  /// the number of WAVE channels, and of slots
+  static constexpr uint32_t WAVE_CHANNELS = 7;
+  /// the WAVE channels, in the order of GetWaveChannels
+  static constexpr uint32_t WaveChannels[WAVE_CHANNELS] = { CCH, SCH1, SCH2, SCH3, SCH4, SCH5, SCH6 };
+  /// the WAVE SCHs, in the order of GetSchs
+  static constexpr uint32_t Schs[WAVE_CHANNELS - 1] = { SCH1, SCH2, SCH3, SCH4, SCH5, SCH6 };
 
   /**
    * \param channelNumber the specific channel
@@ -160,7 +184,7 @@ private:
     {
     }
   };
-  std::map<uint32_t, WaveChannel *> m_channels; ///< list of channels
+  std::vector<WaveChannel> m_channels; ///< channels, by slot
 };
 
 }
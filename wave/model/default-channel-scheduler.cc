@@ -98,6 +98,10 @@ void
 DefaultChannelScheduler::DoDispose (void)
 {
   NS_LOG_FUNCTION (this);
+  if (m_channelAccess == AlternatingAccess)
+    {
+      m_coordinator->UnregisterListener (m_coordinationListener);
+    }
   m_coordinator = 0;
   if (m_coordinationListener != 0)
     {
@@ -127,8 +131,9 @@ DefaultChannelScheduler::SetWaveNetDevice (Ptr<WaveNetDevice> device)
   // since default channel scheduler is in the context of single-PHY, we only use one phy object.
   m_phy = device->GetPhy (0);
   m_coordinator = device->GetChannelCoordinator ();
+  // registered while alternating access is assigned, the only
+  // access that switches channels on coordination events
   m_coordinationListener = Create<CoordinationListener> (this);
-  m_coordinator->RegisterListener (m_coordinationListener);
 }
 
 enum ChannelAccess
@@ -177,6 +182,7 @@ DefaultChannelScheduler::AssignAlternatingAccess (uint32_t channelNumber, bool i
 
   m_channelNumber = sch;
   m_channelAccess = AlternatingAccess;
+  m_coordinator->RegisterListener (m_coordinationListener);
   return true;
 }
 
@@ -390,6 +396,10 @@ DefaultChannelScheduler::ReleaseAccess (uint32_t channelNumber)
     {
       return false;
     }
+  if (m_channelAccess == AlternatingAccess)
+    {
+      m_coordinator->UnregisterListener (m_coordinationListener);
+    }
   // cancel  current SCH MAC activity and assigned default CCH access.
   SwitchToNextChannel (m_channelNumber, CCH);
   m_channelAccess = DefaultCchAccess;
@@ -53,6 +53,8 @@ OcbWifiMac::GetTypeId (void)
 }
 
 OcbWifiMac::OcbWifiMac (void)
+  : m_headersQos (false),
+    m_headersHt (false)
 {
   NS_LOG_FUNCTION (this);
   // Let the lower layers know that we are acting as an OCB node
@@ -155,10 +157,43 @@ OcbWifiMac::SetLinkDownCallback (Callback<void> linkDown)
   NS_LOG_WARN ("in OCB mode the like will never down, so linkDown will never be called");
 }
 
-void
-OcbWifiMac::Enqueue (Ptr<const Packet> packet, Mac48Address to)
+uint64_t
+OcbWifiMac::GetDataHeaderKey (Mac48Address to, uint8_t tid)
 {
-  NS_LOG_FUNCTION (this << packet << to);
+  uint8_t buffer[6];
+  to.CopyTo (buffer);
+  uint64_t key = 0;
+  for (uint32_t i = 0; i < 6; i++)
+    {
+      key = (key << 8) | buffer[i];
+    }
+  return (key << 8) | tid;
+}
+
+const WifiMacHeader &
+OcbWifiMac::GetDataHeader (Mac48Address to, uint8_t tid)
+{
+  bool qos = GetQosSupported ();
+  bool ht = GetHtSupported () || GetVhtSupported ();
+  if (m_stationManager != m_headersManager || GetAddress () != m_headersAddress
+      || qos != m_headersQos || ht != m_headersHt)
+    {
+      m_dataHeaders.clear ();
+      m_headersManager = m_stationManager;
+      m_headersAddress = GetAddress ();
+      m_headersQos = qos;
+      m_headersHt = ht;
+    }
+
+  uint64_t key = GetDataHeaderKey (to, tid);
+  DataHeaders::const_iterator i = m_dataHeaders.find (key);
+  // a group address has no rates of its own to remember, once its header
+  // is built the station manager knows about it
+  if (i != m_dataHeaders.end () && to.IsGroup ())
+    {
+      return i->second;
+    }
+
   if (m_stationManager->IsBrandNew (to))
     {
       //In ad hoc mode, we assume that every destination supports all
@@ -175,15 +210,13 @@ OcbWifiMac::Enqueue (Ptr<const Packet> packet, Mac48Address to)
       m_stationManager->AddAllSupportedModes (to);
       m_stationManager->RecordDisassociated (to);
     }
+  if (i != m_dataHeaders.end ())
+    {
+      return i->second;
+    }
 
   WifiMacHeader hdr;
-
-  // If we are not a QoS STA then we definitely want to use AC_BE to
-  // transmit the packet. A TID of zero will map to AC_BE (through \c
-  // QosUtilsMapTidToAc()), so we use that as our default here.
-  uint8_t tid = 0;
-
-  if (GetQosSupported ())
+  if (qos)
     {
       hdr.SetType (WIFI_MAC_QOSDATA);
       hdr.SetQosAckPolicy (WifiMacHeader::NORMAL_ACK);
@@ -194,16 +227,6 @@ OcbWifiMac::Enqueue (Ptr<const Packet> packet, Mac48Address to)
       // however in OCB mode, 802.11p do not allow transmit multiple frames
       // so TxopLimit must equal 0
       hdr.SetQosTxopLimit (0);
-
-      // Fill in the QoS control field in the MAC header
-      tid = QosUtilsGetTidForPacket (packet);
-      // Any value greater than 7 is invalid and likely indicates that
-      // the packet had no QoS tag, so we revert to zero, which'll
-      // mean that AC_BE is used.
-      if (tid > 7)
-        {
-          tid = 0;
-        }
       hdr.SetQosTid (tid);
     }
   else
@@ -211,16 +234,42 @@ OcbWifiMac::Enqueue (Ptr<const Packet> packet, Mac48Address to)
       hdr.SetType (WIFI_MAC_DATA);
     }
 
-  if (GetHtSupported () || GetVhtSupported ())
+  if (ht)
     {
       hdr.SetNoOrder ();
     }
   hdr.SetAddr1 (to);
-  hdr.SetAddr2 (GetAddress ());
+  hdr.SetAddr2 (m_headersAddress);
   hdr.SetAddr3 (WILDCARD_BSSID);
   hdr.SetDsNotFrom ();
   hdr.SetDsNotTo ();
+  return m_dataHeaders.insert (std::make_pair (key, hdr)).first->second;
+}
+
+void
+OcbWifiMac::Enqueue (Ptr<const Packet> packet, Mac48Address to)
+{
+  NS_LOG_FUNCTION (this << packet << to);
+
+  // If we are not a QoS STA then we definitely want to use AC_BE to
+  // transmit the packet. A TID of zero will map to AC_BE (through \c
+  // QosUtilsMapTidToAc()), so we use that as our default here.
+  uint8_t tid = 0;
+
+  if (GetQosSupported ())
+    {
+      // Fill in the QoS control field in the MAC header
+      tid = QosUtilsGetTidForPacket (packet);
+      // Any value greater than 7 is invalid and likely indicates that
+      // the packet had no QoS tag, so we revert to zero, which'll
+      // mean that AC_BE is used.
+      if (tid > 7)
+        {
+          tid = 0;
+        }
+    }
 
+  const WifiMacHeader &hdr = GetDataHeader (to, tid);
   if (GetQosSupported ())
     {
       // Sanity check that the TID is valid
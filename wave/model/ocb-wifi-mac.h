@@ -22,6 +22,7 @@
 #ifndef OCB_WIFI_MAC_H
 #define OCB_WIFI_MAC_H
 
+#include <unordered_map>
 #include "ns3/object-factory.h"
 #include "ns3/regular-wifi-mac.h"
 #include "ns3/wifi-mac-queue.h"
@@ -178,7 +179,28 @@ protected:
 private:
   virtual void Receive (Ptr<Packet> packet, const WifiMacHeader *hdr);
 
+  /// data frame headers by destination and TID
+  typedef std::unordered_map<uint64_t, WifiMacHeader> DataHeaders;
+
+  /**
+   * \param to the destination of the frame
+   * \param tid the TID of the frame, 0 without QoS
+   * \return the key of the data frame header in m_dataHeaders
+   */
+  static uint64_t GetDataHeaderKey (Mac48Address to, uint8_t tid);
+  /**
+   * \param to the destination of the frame
+   * \param tid the TID of the frame, 0 without QoS
+   * \return the data frame header, which Enqueue builds only once
+   */
+  const WifiMacHeader & GetDataHeader (Mac48Address to, uint8_t tid);
+
   VendorSpecificContentManager m_vscManager; ///< VSC manager
+  DataHeaders m_dataHeaders; ///< data frame headers by destination and TID
+  Ptr<WifiRemoteStationManager> m_headersManager; ///< station manager when m_dataHeaders was filled
+  Mac48Address m_headersAddress; ///< address when m_dataHeaders was filled
+  bool m_headersQos; ///< QoS support when m_dataHeaders was filled
+  bool m_headersHt; ///< HT or VHT support when m_dataHeaders was filled
 };
 
 }
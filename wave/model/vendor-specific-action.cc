@@ -19,6 +19,7 @@
 #include <iomanip>
 #include <iostream>
 #include <cstring>
+#include <unordered_set>
 #include "ns3/log.h"
 #include "ns3/assert.h"
 #include "vendor-specific-action.h"
@@ -125,6 +126,43 @@ OrganizationIdentifier::Serialize (Buffer::Iterator start) const
   start.Write (m_oi, GetSerializedSize ());
 }
 
+uint64_t
+OrganizationIdentifier::GetKey (void) const
+{
+  uint64_t key = m_type;
+  switch (m_type)
+    {
+    case OUI24:
+      return (key << 40) | (m_oi[0] << 16) | (m_oi[1] << 8) | m_oi[2];
+    case OUI36:
+      // only the high half of the 5th byte belongs to the OI, the low
+      // half is the management id
+      return (key << 40) | (uint64_t (m_oi[0]) << 28) | (m_oi[1] << 20)
+             | (m_oi[2] << 12) | (m_oi[3] << 4) | (m_oi[4] >> 4);
+    case Unknown:
+    default:
+      return 0;
+    }
+}
+
+/**
+ * \returns the keys of the OrganizationIdentifiers Deserialize accepts
+ */
+static std::unordered_set<uint64_t> &
+GetRegisteredIdentifiers (void)
+{
+  static std::unordered_set<uint64_t> keys;
+  return keys;
+}
+
+void
+OrganizationIdentifier::Register (const OrganizationIdentifier &oi)
+{
+  NS_LOG_FUNCTION (oi);
+  NS_ASSERT (!oi.IsNull ());
+  GetRegisteredIdentifiers ().insert (oi.GetKey ());
+}
+
 /*  because OrganizationIdentifier field is not standard
  *  and the length of OrganizationIdentifier is variable
  *  so data parse here is troublesome
@@ -133,33 +171,23 @@ uint32_t
 OrganizationIdentifier::Deserialize (Buffer::Iterator start)
 {
   NS_LOG_FUNCTION (this << &start);
+  const std::unordered_set<uint64_t> &keys = GetRegisteredIdentifiers ();
   // first try to parse OUI24 with 3 bytes
   start.Read (m_oi,  3);
-  for (std::vector<OrganizationIdentifier>::iterator  i = OrganizationIdentifiers.begin (); i != OrganizationIdentifiers.end (); ++i)
+  m_type = OUI24;
+  if (keys.find (GetKey ()) != keys.end ())
     {
-      if ((i->m_type == OUI24)
-          && (std::memcmp (i->m_oi, m_oi, 3) == 0 ))
-        {
-          m_type = OUI24;
-          return 3;
-        }
+      return 3;
     }
 
   // then try to parse OUI36 with 5 bytes
   start.Read (m_oi + 3,  2);
-  for (std::vector<OrganizationIdentifier>::iterator  i = OrganizationIdentifiers.begin (); i != OrganizationIdentifiers.end (); ++i)
+  m_type = OUI36;
+  if (keys.find (GetKey ()) != keys.end ())
     {
-      if ((i->m_type == OUI36)
-          && (std::memcmp (i->m_oi, m_oi, 4) == 0 ))
-        {
-          // OUI36 first check 4 bytes, then check half of the 5th byte
-          if ((i->m_oi[4] & 0xf0) == (m_oi[4] & 0xf0))
-            {
-              m_type = OUI36;
-              return 5;
-            }
-        }
+      return 5;
     }
+  m_type = Unknown;
 
   // if we cannot deserialize the organization identifier field,
   // we will fail
@@ -356,26 +384,22 @@ VendorSpecificContentManager::RegisterVscCallback (OrganizationIdentifier oi, Vs
     {
       NS_LOG_WARN ("there is already a VsaCallback registered for OrganizationIdentifier " << oi);
     }
-  m_callbacks.insert (std::make_pair (oi, cb));
+  OrganizationIdentifier::Register (oi);
+  m_callbacks.insert (std::make_pair (oi.GetKey (), cb));
 }
 
 void
 VendorSpecificContentManager::DeregisterVscCallback (OrganizationIdentifier &oi)
 {
   NS_LOG_FUNCTION (this << oi);
-  m_callbacks.erase (oi);
+  m_callbacks.erase (oi.GetKey ());
 }
 
 bool
 VendorSpecificContentManager::IsVscCallbackRegistered (OrganizationIdentifier &oi)
 {
   NS_LOG_FUNCTION (this << oi);
-  if (m_callbacks.find (oi) == m_callbacks.end ())
-    {
-      OrganizationIdentifiers.push_back (oi);
-      return false;
-    }
-  return true;
+  return m_callbacks.find (oi.GetKey ()) != m_callbacks.end ();
 }
 
 ///VSC callback function
@@ -386,7 +410,7 @@ VendorSpecificContentManager::FindVscCallback (OrganizationIdentifier &oi)
 {
   NS_LOG_FUNCTION (this << oi);
   VscCallbacksI i;
-  i = m_callbacks.find (oi);
+  i = m_callbacks.find (oi.GetKey ());
   return (i == m_callbacks.end ()) ? null_callback : i->second;
 }
 
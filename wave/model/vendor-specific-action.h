@@ -20,7 +20,7 @@
 #define Vendor_Specific_Action_H
 
 #include <ostream>
-#include <map>
+#include <unordered_map>
 #include "ns3/header.h"
 #include "ns3/packet.h"
 #include "ns3/pointer.h"
@@ -89,6 +89,20 @@ public:
    * \returns whether this OrganizationIdentifier is OUI24 or OUI36.
    */
   enum OrganizationIdentifierType GetType (void) const;
+  /**
+   * \returns the type and the significant bits of this OrganizationIdentifier
+   * packed in one integer, equal keys for equal OrganizationIdentifiers
+   */
+  uint64_t GetKey (void) const;
+
+  /**
+   * Make an OrganizationIdentifier known to Deserialize, which cannot
+   * tell the length of the field otherwise.  The registry keeps every
+   * OrganizationIdentifier once however often it is registered.
+   *
+   * \param oi the OrganizationIdentifier of received VSA frames
+   */
+  static void Register (const OrganizationIdentifier &oi);
 
   // below methods will be called by VendorSpecificActionHeader
   /**
@@ -233,14 +247,13 @@ public:
 
 private:
   /// VSC callback typedef
-  typedef std::map<OrganizationIdentifier,VscCallback> VscCallbacks;
+  typedef std::unordered_map<uint64_t,VscCallback> VscCallbacks;
   /// VSC callback iterator typedef
-  typedef std::map<OrganizationIdentifier,VscCallback>::iterator VscCallbacksI;
+  typedef std::unordered_map<uint64_t,VscCallback>::iterator VscCallbacksI;
 
-  VscCallbacks m_callbacks; ///< VSC callbacks
+  VscCallbacks m_callbacks; ///< VSC callbacks by OrganizationIdentifier key
 };
 
-static std::vector<OrganizationIdentifier> OrganizationIdentifiers; ///< the OIs
 }
 
 #endif /* Vendor_Specific_Action_H */
@@ -100,6 +100,8 @@ VsaManager::SendVsa (const VsaInfo & vsaInfo)
 
   // if destination MAC address is the unicast address or  repeat rate is 0,
   // then only single one VSA frame is to be sent.
+  Ptr<Packet> vsc = vsaInfo.vsc->Copy ();
+  TagVsc (vsc, vsaInfo.channelNumber);
   if (vsaInfo.peer.IsGroup () && (vsaInfo.repeatRate != 0))
     {
       VsaWork *vsa = new VsaWork ();
@@ -107,32 +109,77 @@ VsaManager::SendVsa (const VsaInfo & vsaInfo)
       vsa->channelNumber = vsaInfo.channelNumber;
       vsa->peer = vsaInfo.peer;
       vsa->repeatPeriod = MilliSeconds (VSA_REPEAT_PERIOD * 1000 / vsaInfo.repeatRate);
-      vsa->vsc = vsaInfo.vsc;
+      vsa->vsc = vsc;
       vsa->oi = oi;
-      vsa->repeat =  Simulator::Schedule (vsa->repeatPeriod, &VsaManager::DoRepeat, this, vsa);
+      ScheduleVsa (Simulator::Now () + vsa->repeatPeriod, vsa, true);
       m_vsas.push_back (vsa);
+      // a first transmission outside of its channel interval waits with
+      // the repeats, so that cancelling the VSA drops it as well
+      Time wait = NeedTimeToInterval (vsaInfo.sendInterval);
+      if (wait.IsStrictlyPositive ())
+        {
+          ScheduleVsa (Simulator::Now () + wait, vsa, false);
+          return;
+        }
+      vsc = vsc->Copy ();
     }
-  DoSendVsa (vsaInfo.sendInterval, vsaInfo.channelNumber, vsaInfo.vsc->Copy (), oi, vsaInfo.peer);
+  DoSendVsa (vsaInfo.sendInterval, vsaInfo.channelNumber, vsc, oi, vsaInfo.peer);
 }
 
 void
-VsaManager::DoRepeat (VsaWork *vsa)
+VsaManager::ScheduleVsa (Time time, VsaWork *vsa, bool repeat)
 {
-  NS_LOG_FUNCTION (this << vsa);
-  vsa->repeat =  Simulator::Schedule (vsa->repeatPeriod, &VsaManager::DoRepeat, this, vsa);
-  DoSendVsa (vsa->sentInterval, vsa->channelNumber, vsa->vsc->Copy (), vsa->oi, vsa->peer);
+  NS_LOG_FUNCTION (this << time << vsa << repeat);
+  VsaTimer timer;
+  timer.vsa = vsa;
+  timer.repeat = repeat;
+  VsaTimers::iterator i = m_timers.insert (std::make_pair (time, timer));
+  // the event of the device only waits for the earliest transmission
+  if (i == m_timers.begin ())
+    {
+      m_timer.Cancel ();
+      m_timer = Simulator::Schedule (time - Simulator::Now (), &VsaManager::DoTimer, this);
+    }
 }
 
 void
-VsaManager::DoSendVsa (enum VsaTransmitInterval  interval, uint32_t channel,
-                       Ptr<Packet> vsc, OrganizationIdentifier oi, Mac48Address peer)
+VsaManager::DoTimer (void)
 {
-  NS_LOG_FUNCTION (this << interval << channel << vsc << oi << peer);
-  NS_ASSERT (m_device != 0);
-  Ptr<ChannelCoordinator> coordinator = m_device->GetChannelCoordinator ();
-  Ptr<ChannelScheduler> scheduler = m_device->GetChannelScheduler ();
-  Ptr<ChannelManager> manager = m_device->GetChannelManager ();
+  NS_LOG_FUNCTION (this);
+  Time now = Simulator::Now ();
+  while (!m_timers.empty () && m_timers.begin ()->first <= now)
+    {
+      VsaTimer timer = m_timers.begin ()->second;
+      m_timers.erase (m_timers.begin ());
+      VsaWork *vsa = timer.vsa;
+      if (timer.repeat)
+        {
+          m_timers.insert (std::make_pair (now + vsa->repeatPeriod, timer));
+        }
+
+      // a repeat outside of its channel interval waits here for the
+      // interval instead of being rescheduled by DoSendVsa
+      Time wait = NeedTimeToInterval (vsa->sentInterval);
+      if (wait.IsStrictlyPositive ())
+        {
+          VsaTimer send = timer;
+          send.repeat = false;
+          m_timers.insert (std::make_pair (now + wait, send));
+          continue;
+        }
+      TransmitVsa (vsa->channelNumber, vsa->vsc->Copy (), vsa->oi, vsa->peer);
+    }
+  if (!m_timers.empty ())
+    {
+      m_timer = Simulator::Schedule (m_timers.begin ()->first - now, &VsaManager::DoTimer, this);
+    }
+}
 
+Time
+VsaManager::NeedTimeToInterval (enum VsaTransmitInterval interval) const
+{
+  NS_LOG_FUNCTION (this << interval);
+  Ptr<ChannelCoordinator> coordinator = m_device->GetChannelCoordinator ();
   // if the request is for transmitting in SCH Interval (or CCH Interval), but currently
   // is not in SCH Interval (or CCH Interval) and , then the WAVE device  will wait
   // some time to insert this VSA frame into MAC internal queue.
@@ -140,35 +187,23 @@ VsaManager::DoSendVsa (enum VsaTransmitInterval  interval, uint32_t channel,
   // insert this VSA frame into MAC internal queue immediately.
   if (interval == VSA_TRANSMIT_IN_SCHI)
     {
-      Time wait = coordinator->NeedTimeToSchInterval ();
-      if (wait != Seconds (0))
-        {
-          Simulator::Schedule (wait, &VsaManager::DoSendVsa, this,
-                               interval, channel, vsc, oi, peer);
-          return;
-        }
+      return coordinator->NeedTimeToSchInterval ();
     }
   else if (interval == VSA_TRANSMIT_IN_CCHI)
     {
-      Time wait = coordinator->NeedTimeToCchInterval ();
-      if (wait != Seconds (0))
-        {
-          Simulator::Schedule (wait, &VsaManager::DoSendVsa, this,
-                               interval, channel, vsc, oi, peer);
-          return;
-        }
-    }
-  else
-    {
-      NS_ASSERT (interval == VSA_TRANSMIT_IN_BOTHI);
-      // do nothing here, since VSA_IN_BOTHI allows to sent VSA frames in any interval.
+      return coordinator->NeedTimeToCchInterval ();
     }
+  NS_ASSERT (interval == VSA_TRANSMIT_IN_BOTHI);
+  // VSA_IN_BOTHI allows to sent VSA frames in any interval.
+  return Seconds (0);
+}
 
-  if (!scheduler->IsChannelAccessAssigned (channel))
-    {
-      NS_LOG_DEBUG ("there is no channel access assigned for channel " << channel);
-      return;
-    }
+void
+VsaManager::TagVsc (Ptr<Packet> vsc, uint32_t channel) const
+{
+  NS_LOG_FUNCTION (this << vsc << channel);
+  NS_ASSERT (m_device != 0);
+  Ptr<ChannelManager> manager = m_device->GetChannelManager ();
 
   // refer to 1609.4-2010 chapter 5.4.1
   // Management frames are assigned the highest AC (AC_VO).
@@ -183,11 +218,62 @@ VsaManager::DoSendVsa (enum VsaTransmitInterval  interval, uint32_t channel,
   txVector.SetPreambleType (manager->GetManagementPreamble (channel));
   HigherLayerTxVectorTag tag = HigherLayerTxVectorTag (txVector, manager->GetManagementAdaptable (channel));
   vsc->AddPacketTag (tag);
+}
+
+void
+VsaManager::DoSendVsa (enum VsaTransmitInterval  interval, uint32_t channel,
+                       Ptr<Packet> vsc, OrganizationIdentifier oi, Mac48Address peer)
+{
+  NS_LOG_FUNCTION (this << interval << channel << vsc << oi << peer);
+  NS_ASSERT (m_device != 0);
+  Time wait = NeedTimeToInterval (interval);
+  if (wait != Seconds (0))
+    {
+      Simulator::Schedule (wait, &VsaManager::DoSendVsa, this,
+                           interval, channel, vsc, oi, peer);
+      return;
+    }
+  TransmitVsa (channel, vsc, oi, peer);
+}
+
+void
+VsaManager::TransmitVsa (uint32_t channel, Ptr<Packet> vsc, const OrganizationIdentifier &oi, Mac48Address peer)
+{
+  NS_LOG_FUNCTION (this << channel << vsc << oi << peer);
+  if (!m_device->GetChannelScheduler ()->IsChannelAccessAssigned (channel))
+    {
+      NS_LOG_DEBUG ("there is no channel access assigned for channel " << channel);
+      return;
+    }
 
   Ptr<OcbWifiMac> mac = m_device->GetMac (channel);
   mac->SendVsc (vsc, peer, oi);
 }
 
+void
+VsaManager::RemoveVsa (VsaWork *vsa)
+{
+  NS_LOG_FUNCTION (this << vsa);
+  for (VsaTimers::iterator i = m_timers.begin (); i != m_timers.end (); )
+    {
+      if (i->second.vsa == vsa)
+        {
+          m_timers.erase (i++);
+        }
+      else
+        {
+          ++i;
+        }
+    }
+  // DoTimer finds nothing due if the earliest transmission was removed
+  if (m_timers.empty ())
+    {
+      m_timer.Cancel ();
+    }
+  vsa->vsc = 0;
+  delete vsa;
+}
+
 void
 VsaManager::RemoveAll (void)
 {
@@ -195,14 +281,12 @@ VsaManager::RemoveAll (void)
   for (std::vector<VsaWork *>::iterator i = m_vsas.begin ();
        i != m_vsas.end (); ++i)
     {
-      if (!(*i)->repeat.IsExpired ())
-        {
-          (*i)->repeat.Cancel ();
-        }
       (*i)->vsc = 0;
       delete (*i);
     }
   m_vsas.clear ();
+  m_timers.clear ();
+  m_timer.Cancel ();
 }
 
 void
@@ -214,12 +298,7 @@ VsaManager::RemoveByChannel (uint32_t channelNumber)
     {
       if ((*i)->channelNumber == channelNumber)
         {
-          if (!(*i)->repeat.IsExpired ())
-            {
-              (*i)->repeat.Cancel ();
-            }
-          (*i)->vsc = 0;
-          delete (*i);
+          RemoveVsa (*i);
           i = m_vsas.erase (i);
         }
       else
@@ -239,12 +318,7 @@ VsaManager::RemoveByOrganizationIdentifier (const OrganizationIdentifier &oi)
     {
       if ((*i)->oi == oi)
         {
-          if (!(*i)->repeat.IsExpired ())
-            {
-              (*i)->repeat.Cancel ();
-            }
-          (*i)->vsc = 0;
-          delete (*i);
+          RemoveVsa (*i);
           i = m_vsas.erase (i);
         }
       else
@@ -18,6 +18,7 @@
  */
 #ifndef VSA_MANAGER_H
 #define VSA_MANAGER_H
+#include <map>
 #include <vector>
 #include "wave-net-device.h"
 
@@ -172,30 +173,67 @@ private:
   {
     Mac48Address peer; ///< peer
     OrganizationIdentifier oi; ///< OI
-    Ptr<Packet> vsc; ///< VSC
+    Ptr<Packet> vsc; ///< VSC, tagged once, every repeat sends a copy sharing its buffer
     uint32_t channelNumber; ///< channel number
     enum VsaTransmitInterval sentInterval; ///< VSA transmit interval
     Time repeatPeriod; ///< repeat period
-    EventId repeat; ///< repeat ID
   };
 
+  /// a pending transmission of a repeated VSA
+  struct VsaTimer
+  {
+    VsaWork *vsa; ///< the repeated VSA
+    bool repeat; ///< true for the next repeat, false for a send waiting for its channel interval
+  };
+  /// pending transmissions by time
+  typedef std::multimap<Time, VsaTimer> VsaTimers;
+
   /**
+   * \param time when to transmit
    * \param vsa the specific VSA repeat work
+   * \param repeat whether this is the next repeat or a send waiting for its channel interval
+   */
+  void ScheduleVsa (Time time, VsaWork *vsa, bool repeat);
+  /**
+   * Transmit every repeated VSA which is due, then wait for the next one
+   */
+  void DoTimer (void);
+  /**
+   * \param vsa the specific VSA repeat work to cancel and delete
+   */
+  void RemoveVsa (VsaWork *vsa);
+  /**
+   * \param interval the specific channel interval for VSA transmission
+   * \return the time to wait until that channel interval
+   */
+  Time NeedTimeToInterval (enum VsaTransmitInterval interval) const;
+  /**
+   * \param vsc the data field of VSA frame, tagged in place
+   * \param channel the specific channel number for VSA transmission
    *
-   * Repeat to send VSA frames
+   * Add the priority and tx vector of management frames on the channel
    */
-  void DoRepeat (VsaWork *vsa);
+  void TagVsc (Ptr<Packet> vsc, uint32_t channel) const;
   /**
    * \param interval the specific channel interval for VSA transmission
    * \param channel the specific channel number for VSA transmission
-   * \param vsc the data field of VSA frame that contains vendor specific content
+   * \param vsc the data field of VSA frame that contains vendor specific content, already tagged
    * \param oi the Organization Identifier for VSA frame
    * \param peer the destination address
    */
   void DoSendVsa (enum VsaTransmitInterval  interval, uint32_t channel, Ptr<Packet> vsc, OrganizationIdentifier oi, Mac48Address peer);
+  /**
+   * \param channel the specific channel number for VSA transmission
+   * \param vsc the data field of VSA frame that contains vendor specific content, already tagged
+   * \param oi the Organization Identifier for VSA frame
+   * \param peer the destination address
+   */
+  void TransmitVsa (uint32_t channel, Ptr<Packet> vsc, const OrganizationIdentifier &oi, Mac48Address peer);
 
   Callback<bool, Ptr<const Packet>,const Address &, uint32_t, uint32_t> m_vsaReceived; ///< VSA received callback
   std::vector<VsaWork *> m_vsas; ///< VSAs
+  VsaTimers m_timers; ///< pending transmissions of the repeated VSAs
+  EventId m_timer; ///< the one event of the device for m_timers
   Ptr<WaveNetDevice> m_device; ///< the device
 };
 
@@ -117,6 +117,10 @@ WaveNetDevice::DoDispose (void)
       mac->Dispose ();
     }
   m_macEntities.clear ();
+  for (uint32_t slot = 0; slot < ChannelManager::WAVE_CHANNELS; ++slot)
+    {
+      m_macSlots[slot] = 0;
+    }
   m_channelCoordinator->Dispose ();
   m_channelManager->Dispose ();
   m_channelScheduler->Dispose ();
@@ -180,22 +184,24 @@ WaveNetDevice::AddMac (uint32_t channelNumber, Ptr<OcbWifiMac> mac)
     {
       NS_FATAL_ERROR ("The channel " << channelNumber << " is not a valid WAVE channel number");
     }
-  if (m_macEntities.find (channelNumber) != m_macEntities.end ())
+  uint32_t slot = ChannelManager::GetWaveChannelSlot (channelNumber);
+  if (m_macSlots[slot] != 0)
     {
       NS_FATAL_ERROR ("The MAC entity for channel " << channelNumber << " already exists.");
     }
   m_macEntities.insert (std::make_pair (channelNumber, mac));
+  m_macSlots[slot] = mac;
 }
 Ptr<OcbWifiMac>
 WaveNetDevice::GetMac (uint32_t channelNumber) const
 {
   NS_LOG_FUNCTION (this << channelNumber);
-  MacEntitiesI i = m_macEntities.find (channelNumber);
-  if (i == m_macEntities.end ())
+  if (!ChannelManager::IsWaveChannel (channelNumber)
+      || m_macSlots[ChannelManager::GetWaveChannelSlot (channelNumber)] == 0)
     {
       NS_FATAL_ERROR ("there is no available MAC entity for channel " << channelNumber);
     }
-  return i->second;
+  return m_macSlots[ChannelManager::GetWaveChannelSlot (channelNumber)];
 }
 
 std::map<uint32_t, Ptr<OcbWifiMac> >
@@ -214,6 +220,52 @@ WaveNetDevice::AddPhy (Ptr<WifiPhy> phy)
       NS_FATAL_ERROR ("This PHY entity is already inserted");
     }
   m_phyEntities.push_back (phy);
+  m_checkedModes.clear ();
+  m_supportedModes.clear ();
+}
+
+bool
+WaveNetDevice::IsModeSupported (WifiMode mode)
+{
+  uint32_t uid = mode.GetUid ();
+  if (uid >= m_checkedModes.size ())
+    {
+      m_checkedModes.resize (uid + 1, false);
+      m_supportedModes.resize (uid + 1, false);
+    }
+  if (!m_checkedModes[uid])
+    {
+      bool supported = true;
+      for (PhyEntitiesI i = m_phyEntities.begin (); i != m_phyEntities.end (); ++i)
+        {
+          if (!((*i)->IsModeSupported (mode)))
+            {
+              supported = false;
+              break;
+            }
+        }
+      m_checkedModes[uid] = true;
+      m_supportedModes[uid] = supported;
+    }
+  return m_supportedModes[uid];
+}
+
+const HigherLayerTxVectorTag &
+WaveNetDevice::GetTxVectorTag (WifiMode mode, uint32_t txPowerLevel, WifiPreamble preamble)
+{
+  // power levels are below 8, preambles below 256
+  uint64_t key = (static_cast<uint64_t> (mode.GetUid ()) << 32) | (txPowerLevel << 8) | static_cast<uint32_t> (preamble);
+  TxVectorTags::const_iterator i = m_txVectorTags.find (key);
+  if (i == m_txVectorTags.end ())
+    {
+      WifiTxVector txVector;
+      txVector.SetChannelWidth (10);
+      txVector.SetTxPowerLevel (txPowerLevel);
+      txVector.SetMode (mode);
+      txVector.SetPreambleType (preamble);
+      i = m_txVectorTags.insert (std::make_pair (key, HigherLayerTxVectorTag (txVector, false))).first;
+    }
+  return i->second;
 }
 Ptr<WifiPhy>
 WaveNetDevice::GetPhy (uint32_t index) const
@@ -330,14 +382,17 @@ WaveNetDevice::RegisterTxProfile (const TxProfile & txprofile)
   else
     {
       // if current PHY devices do not support data rate of the tx profile
-      for (PhyEntitiesI i = m_phyEntities.begin (); i != m_phyEntities.end (); ++i)
+      if (!IsModeSupported (txprofile.dataRate))
         {
-          if (!((*i)->IsModeSupported (txprofile.dataRate)))
-            {
-              NS_LOG_DEBUG ("This data rate " << txprofile.dataRate.GetUniqueName () << " is not supported by current PHY device");
-              return false;
-            }
+          NS_LOG_DEBUG ("This data rate " << txprofile.dataRate.GetUniqueName () << " is not supported by current PHY device");
+          return false;
         }
+      // the tag of every packet sent with the profile
+      WifiTxVector txVector;
+      txVector.SetTxPowerLevel (txprofile.txPowerLevel);
+      txVector.SetMode (txprofile.dataRate);
+      txVector.SetPreambleType (txprofile.preamble);
+      m_txProfileTag = HigherLayerTxVectorTag (txVector, txprofile.adaptable);
     }
 
   m_txProfile = new TxProfile ();
@@ -399,20 +454,11 @@ WaveNetDevice::SendX (Ptr<Packet> packet, const Address & dest, uint32_t protoco
   else
     {
       // if current PHY devices do not support data rate of the  tx profile
-      for (PhyEntitiesI i = m_phyEntities.begin (); i != m_phyEntities.end (); ++i)
+      if (!IsModeSupported (txInfo.dataRate))
         {
-          if ( !((*i)->IsModeSupported (txInfo.dataRate)))
-            {
-              return false;
-            }
+          return false;
         }
-      WifiTxVector txVector;
-      txVector.SetChannelWidth (10);
-      txVector.SetTxPowerLevel (txInfo.txPowerLevel);
-      txVector.SetMode (txInfo.dataRate);
-      txVector.SetPreambleType (txInfo.preamble);
-      HigherLayerTxVectorTag tag = HigherLayerTxVectorTag (txVector, false);
-      packet->AddPacketTag (tag);
+      packet->AddPacketTag (GetTxVectorTag (txInfo.dataRate, txInfo.txPowerLevel, txInfo.preamble));
     }
 
   LlcSnapHeader llc;
@@ -615,12 +661,7 @@ WaveNetDevice::Send (Ptr<Packet> packet, const Address& dest, uint16_t protocol)
     }
   else
     {
-      WifiTxVector txVector;
-      txVector.SetTxPowerLevel (m_txProfile->txPowerLevel);
-      txVector.SetMode (m_txProfile->dataRate);
-      txVector.SetPreambleType (m_txProfile->preamble);
-      HigherLayerTxVectorTag tag = HigherLayerTxVectorTag (txVector, m_txProfile->adaptable);
-      packet->AddPacketTag (tag);
+      packet->AddPacketTag (m_txProfileTag);
     }
 
   LlcSnapHeader llc;
@@ -667,7 +708,7 @@ WaveNetDevice::IsAvailableChannel (uint32_t channelNumber) const
       NS_LOG_DEBUG ("this is no a valid WAVE channel for channel " << channelNumber);
       return false;
     }
-  if (m_macEntities.find (channelNumber) == m_macEntities.end ())
+  if (m_macSlots[ChannelManager::GetWaveChannelSlot (channelNumber)] == 0)
     {
       NS_LOG_DEBUG ("this is no available WAVE entity  for channel " << channelNumber);
       return false;
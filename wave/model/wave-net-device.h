@@ -21,6 +21,7 @@
 #define WAVE_NET_DEVICE_H
 
 #include <map>
+#include <unordered_map>
 #include <vector>
 #include "ns3/packet.h"
 #include "ns3/traced-callback.h"
@@ -32,6 +33,7 @@
 #include "channel-manager.h"
 #include "channel-scheduler.h"
 #include "vsa-manager.h"
+#include "higher-tx-tag.h"
 namespace ns3 {
 struct SchInfo;
 struct VsaInfo;
@@ -377,12 +379,28 @@ private:
    * \param to
    */
   void ForwardUp (Ptr<Packet> packet, Mac48Address from, Mac48Address to);
+  /**
+   * \param mode the data rate
+   * \return whether all PHY entities support the data rate
+   *
+   * The answer is cached per mode until a PHY entity is added.
+   */
+  bool IsModeSupported (WifiMode mode);
+  /**
+   * \param mode the data rate
+   * \param txPowerLevel the transmit power level
+   * \param preamble the preamble
+   * \return the non-adaptable tag with these tx parameters, built once
+   */
+  const HigherLayerTxVectorTag & GetTxVectorTag (WifiMode mode, uint32_t txPowerLevel, WifiPreamble preamble);
 
   /// MacEntities typedef
   typedef std::map<uint32_t, Ptr<OcbWifiMac> > MacEntities;
   /// MacEntities iterator typedef
   typedef std::map<uint32_t, Ptr<OcbWifiMac> >::const_iterator MacEntitiesI;
   MacEntities m_macEntities; ///< MAC entities
+  /// the MAC entities of m_macEntities by channel slot, for lookups per packet
+  Ptr<OcbWifiMac> m_macSlots[ChannelManager::WAVE_CHANNELS];
   /// PhyEntities typedef
   typedef std::vector<Ptr<WifiPhy> > PhyEntities; 
   /// PhyEntities iterator typedef
@@ -394,6 +412,12 @@ private:
   Ptr<ChannelCoordinator> m_channelCoordinator; ///< the channel coordinator
   Ptr<VsaManager> m_vsaManager; ///< the VSA manager 
   TxProfile *m_txProfile; ///< transmit profile
+  HigherLayerTxVectorTag m_txProfileTag; ///< tag with the tx parameters of m_txProfile
+  std::vector<bool> m_checkedModes; ///< by mode UID, whether m_supportedModes is known
+  std::vector<bool> m_supportedModes; ///< by mode UID, whether all PHY entities support the mode
+  /// tags by mode UID, power level and preamble
+  typedef std::unordered_map<uint64_t, HigherLayerTxVectorTag> TxVectorTags;
+  TxVectorTags m_txVectorTags; ///< tags built by SendX
   /**
    * \todo The Address arguments should be passed
    * by const reference, since they are large.
@@ -16,6 +16,7 @@
  * Author: Junling Bu <linlinjavaer@gmail.com>
  */
 #include <cmath>
+#include <sstream>
 #include "ns3/test.h"
 #include "ns3/config.h"
 #include "ns3/string.h"
@@ -256,6 +257,173 @@ ChannelCoordinationTestCase::DoRun ()
   Simulator::Destroy ();
 }
 
+/**
+ * \ingroup wave-test
+ * \ingroup tests
+ *
+ * \brief RecordingCoordinationListener records the channel coordination
+ * events it is notified of as "<ms>:<slot> ", where the slot is G for the
+ * guard slot of CCHI, g for the guard slot of SCHI, C for CCH and S for SCH.
+ */
+class RecordingCoordinationListener : public ChannelCoordinationListener
+{
+public:
+  /**
+   * Constructor
+   *
+   * \param record the record to append the events to
+   */
+  RecordingCoordinationListener (std::string *record)
+    : m_record (record)
+  {
+  }
+  virtual ~RecordingCoordinationListener (void)
+  {
+  }
+  virtual void NotifyCchSlotStart (Time duration)
+  {
+    Record ("C");
+  }
+  virtual void NotifySchSlotStart (Time duration)
+  {
+    Record ("S");
+  }
+  virtual void NotifyGuardSlotStart (Time duration, bool cchi)
+  {
+    Record (cchi ? "G" : "g");
+  }
+private:
+  /**
+   * Append an event to the record
+   * \param slot the slot starting now
+   */
+  void Record (const char *slot)
+  {
+    std::ostringstream oss;
+    oss << Now ().GetMilliSeconds () << ":" << slot << " ";
+    *m_record += oss.str ();
+  }
+  std::string *m_record; ///< the record
+};
+
+/**
+ * \ingroup wave-test
+ * \ingroup tests
+ *
+ * \brief This test case tests channel coordination events of listeners
+ * registered while channel coordination is running.
+ * In particular, it checks the following:
+ * - a coordinator joins the clock when the first listener registers,
+ *   anywhere in a sync interval, and notifies every slot start after that
+ * - a coordinator joining a running clock notifies the same slot starts
+ * - a coordinator leaves the clock when the last listener unregisters, and
+ *   joins it again in phase when a listener registers again.
+ */
+class ChannelCoordinationJoinTestCase : public TestCase
+{
+public:
+  ChannelCoordinationJoinTestCase (void);
+  virtual ~ChannelCoordinationJoinTestCase (void);
+
+private:
+  /**
+   * \param from the time after which slot starts are notified, in ms
+   * \param to the time before which slot starts are notified, in ms
+   * \returns the record of a RecordingCoordinationListener notified of all
+   * slot starts of the default intervals in between
+   */
+  static std::string MakeRecord (int64_t from, int64_t to);
+  virtual void DoRun (void);
+};
+
+ChannelCoordinationJoinTestCase::ChannelCoordinationJoinTestCase (void)
+  : TestCase ("channel-coordination-join")
+{
+}
+ChannelCoordinationJoinTestCase::~ChannelCoordinationJoinTestCase (void)
+{
+}
+
+std::string
+ChannelCoordinationJoinTestCase::MakeRecord (int64_t from, int64_t to)
+{
+  // the slot starts of a sync interval with CCHI = SCHI = 50ms and GI = 4ms
+  const static int64_t offsets[4] = {0, 4, 50, 54};
+  const static char *slots[4] = {"G", "C", "g", "S"};
+  std::ostringstream oss;
+  for (int64_t synci = 0; synci < to; synci += 100)
+    {
+      for (uint32_t i = 0; i != 4; ++i)
+        {
+          int64_t time = synci + offsets[i];
+          if (time > from && time < to)
+            {
+              oss << time << ":" << slots[i] << " ";
+            }
+        }
+    }
+  return oss.str ();
+}
+
+void
+ChannelCoordinationJoinTestCase::DoRun ()
+{
+  // a listener registered in the guard slot of CCHI, in CCHI, in the guard
+  // slot of SCHI and in SCHI is notified of the slot starts after that
+  const static int64_t joins[4] = {2, 30, 52, 70};
+  for (uint32_t i = 0; i != 4; ++i)
+    {
+      std::string record;
+      Ptr<ChannelCoordinator> coordinator = CreateObject<ChannelCoordinator> ();
+      coordinator->Initialize ();
+      Ptr<ChannelCoordinationListener> listener = Create<RecordingCoordinationListener> (&record);
+      Simulator::Schedule (MilliSeconds (joins[i]), &ChannelCoordinator::RegisterListener, coordinator, listener);
+      Simulator::Stop (MilliSeconds (345));
+      Simulator::Run ();
+      coordinator->Dispose ();
+      Simulator::Destroy ();
+      NS_TEST_EXPECT_MSG_EQ (record, MakeRecord (joins[i], 345), "listener registered at " << joins[i] << "ms");
+    }
+
+  // a coordinator joining the clock of another one
+  {
+    std::string first, second;
+    Ptr<ChannelCoordinator> coordinator1 = CreateObject<ChannelCoordinator> ();
+    Ptr<ChannelCoordinator> coordinator2 = CreateObject<ChannelCoordinator> ();
+    coordinator1->Initialize ();
+    coordinator2->Initialize ();
+    Ptr<ChannelCoordinationListener> listener1 = Create<RecordingCoordinationListener> (&first);
+    Ptr<ChannelCoordinationListener> listener2 = Create<RecordingCoordinationListener> (&second);
+    Simulator::Schedule (MilliSeconds (2), &ChannelCoordinator::RegisterListener, coordinator1, listener1);
+    Simulator::Schedule (MilliSeconds (70), &ChannelCoordinator::RegisterListener, coordinator2, listener2);
+    Simulator::Stop (MilliSeconds (345));
+    Simulator::Run ();
+    coordinator1->Dispose ();
+    coordinator2->Dispose ();
+    Simulator::Destroy ();
+    NS_TEST_EXPECT_MSG_EQ (first, MakeRecord (2, 345), "listener of the coordinator starting the clock");
+    NS_TEST_EXPECT_MSG_EQ (second, MakeRecord (70, 345), "listener of the coordinator joining the clock");
+  }
+
+  // a listener registered before channel coordination starts is notified
+  // of the guard slot starting with it; it unregisters at 120ms and
+  // registers again at 230ms
+  {
+    std::string record;
+    Ptr<ChannelCoordinator> coordinator = CreateObject<ChannelCoordinator> ();
+    Ptr<ChannelCoordinationListener> listener = Create<RecordingCoordinationListener> (&record);
+    coordinator->RegisterListener (listener);
+    coordinator->Initialize ();
+    Simulator::Schedule (MilliSeconds (120), &ChannelCoordinator::UnregisterListener, coordinator, listener);
+    Simulator::Schedule (MilliSeconds (230), &ChannelCoordinator::RegisterListener, coordinator, listener);
+    Simulator::Stop (MilliSeconds (445));
+    Simulator::Run ();
+    coordinator->Dispose ();
+    Simulator::Destroy ();
+    NS_TEST_EXPECT_MSG_EQ (record, MakeRecord (-1, 120) + MakeRecord (230, 445), "listener unregistered from 120ms to 230ms");
+  }
+}
+
 /**
  * \ingroup wave-test
  * \ingroup tests
@@ -334,6 +502,11 @@ public:
    * \param vsaInfo VSA info
    */
   void SendWsa (bool shouldSucceed, const VsaInfo &vsaInfo);
+  /**
+   * Check the number of VSA frames received so far
+   * \param expected the expected number
+   */
+  void TestVsaReceived (uint32_t expected);
 
 private:
   virtual void DoRun (void);
@@ -355,6 +528,7 @@ private:
   bool ReceiveVsa (Ptr<const Packet> pkt,const Address & address, uint32_t, uint32_t);
 
   Ptr<WaveNetDevice>  m_sender; ///< sender
+  uint32_t m_vsaReceived; ///< VSA frames received
 };
 
 ChannelRoutingTestCase::ChannelRoutingTestCase (void)
@@ -394,6 +568,19 @@ ChannelRoutingTestCase::SendWsa (bool shouldSucceed, const VsaInfo &vsaInfo)
   NS_TEST_EXPECT_MSG_EQ (result, shouldSucceed, "test SendWsa method error");
 }
 
+void
+ChannelRoutingTestCase::TestVsaReceived (uint32_t expected)
+{
+  NS_TEST_EXPECT_MSG_EQ (m_vsaReceived, expected, "VSA frames received at " << Now ().GetSeconds ());
+}
+
+bool
+ChannelRoutingTestCase::ReceiveVsa (Ptr<const Packet> pkt,const Address & address, uint32_t, uint32_t)
+{
+  m_vsaReceived++;
+  return true;
+}
+
 void
 ChannelRoutingTestCase::DoRun ()
 {
@@ -521,6 +708,41 @@ ChannelRoutingTestCase::DoRun ()
     Simulator::Run ();
     Simulator::Destroy ();
   }
+
+  // check the repeats of WSA management frames sent in CCHI with alternating access
+  {
+    NetDeviceContainer devices = TestCaseHelper::CreatWaveDevice (2);
+    m_sender = DynamicCast<WaveNetDevice> (devices.Get (0));
+    Ptr<WaveNetDevice> receiver = DynamicCast<WaveNetDevice> (devices.Get (1));
+    receiver->SetWaveVsaCallback (MakeCallback (&ChannelRoutingTestCase::ReceiveVsa, this));
+    m_vsaReceived = 0;
+
+    const SchInfo schInfo = SchInfo (SCH1, false, EXTENDED_ALTERNATING);
+    Simulator::Schedule (Seconds (1.0), &WaveNetDevice::StartSch, m_sender, schInfo);
+
+    // 50 frames in 5s is one every 100ms.  Started at 1.06s in SCHI, the
+    // first frame and every repeat wait for the next CCHI, so frames are
+    // sent at 1.1s, 1.2s, ..., 2.0s
+    Ptr<Packet> packet = Create<Packet> (100);
+    const Mac48Address dest = Mac48Address::GetBroadcast ();
+    const VsaInfo vsaInfo = VsaInfo (dest, OrganizationIdentifier (), 3, packet, CCH, 50, VSA_TRANSMIT_IN_CCHI);
+    Simulator::Schedule (Seconds (1.06), &ChannelRoutingTestCase::SendWsa, this, true, vsaInfo);
+    Simulator::Schedule (Seconds (1.099), &ChannelRoutingTestCase::TestVsaReceived, this, 0);
+    Simulator::Schedule (Seconds (1.15), &ChannelRoutingTestCase::TestVsaReceived, this, 1);
+    Simulator::Schedule (Seconds (1.55), &ChannelRoutingTestCase::TestVsaReceived, this, 5);
+    Simulator::Schedule (Seconds (2.05), &ChannelRoutingTestCase::TestVsaReceived, this, 10);
+    // the repeat of 2.06s waits for 2.1s when the VSA is stopped
+    Simulator::Schedule (Seconds (2.08), &WaveNetDevice::StopVsa, m_sender, CCH);
+
+    // a first frame waiting for CCHI is dropped as well
+    Simulator::Schedule (Seconds (2.56), &ChannelRoutingTestCase::SendWsa, this, true, vsaInfo);
+    Simulator::Schedule (Seconds (2.58), &WaveNetDevice::StopVsa, m_sender, CCH);
+    Simulator::Schedule (Seconds (2.99), &ChannelRoutingTestCase::TestVsaReceived, this, 10);
+
+    Simulator::Stop (Seconds (3.0));
+    Simulator::Run ();
+    Simulator::Destroy ();
+  }
 }
 
 /**
@@ -1198,6 +1420,7 @@ WaveMacTestSuite::WaveMacTestSuite ()
 {
   // TestDuration for TestCase can be QUICK, EXTENSIVE or TAKES_FOREVER
   AddTestCase (new ChannelCoordinationTestCase, TestCase::QUICK);
+  AddTestCase (new ChannelCoordinationJoinTestCase, TestCase::QUICK);
   AddTestCase (new ChannelRoutingTestCase, TestCase::QUICK);
   AddTestCase (new ChannelAccessTestCase, TestCase::QUICK);
   AddTestCase (new AnnexC_TestCase, TestCase::QUICK);
@@ -0,0 +1,429 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#include <vector>
+#include "ns3/test.h"
+#include "ns3/rng-seed-manager.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/double.h"
+#include "ns3/uinteger.h"
+#include "ns3/node-container.h"
+#include "ns3/mobility-helper.h"
+#include "ns3/constant-velocity-mobility-model.h"
+#include "ns3/yans-wifi-helper.h"
+#include "ns3/wifi-80211p-helper.h"
+#include "ns3/wave-mac-helper.h"
+#include "ns3/internet-stack-helper.h"
+#include "ns3/ipv4-address-helper.h"
+#include "ns3/wave-bsm-stats.h"
+#include "ns3/wave-bsm-helper.h"
+
+using namespace ns3;
+
+/**
+ * \ingroup wave-test
+ * \ingroup tests
+ *
+ * \brief The counts of BSMs kept by a per-range loop over the coverage
+ * areas, the way WaveBsmStats was fed before it recorded range buckets.
+ */
+class PerRangeBsmCounts
+{
+public:
+  PerRangeBsmCounts ()
+    : m_expected (10, 0),
+      m_inRange (10, 0),
+      m_totalExpected (10, 0),
+      m_totalInRange (10, 0)
+  {
+  }
+  /**
+   * \param rangesSq the coverage areas, as the squares of their ranges
+   */
+  void SetRangesSq (const std::vector<double> &rangesSq)
+  {
+    m_rangesSq = rangesSq;
+  }
+  /**
+   * \param distSq the square of the distance of an expected reception
+   */
+  void CountExpected (double distSq)
+  {
+    for (size_t index = 1; index <= m_rangesSq.size (); index++)
+      {
+        if (distSq <= m_rangesSq[index - 1])
+          {
+            m_expected[index - 1]++;
+            m_totalExpected[index - 1]++;
+          }
+      }
+  }
+  /**
+   * \param distSq the square of the distance of a reception
+   */
+  void CountInRange (double distSq)
+  {
+    for (size_t index = 1; index <= m_rangesSq.size (); index++)
+      {
+        if (distSq <= m_rangesSq[index - 1])
+          {
+            m_inRange[index - 1]++;
+            m_totalInRange[index - 1]++;
+          }
+      }
+  }
+  /**
+   * \param counts the counts of the packets received
+   * \param expected the counts of the packets expected
+   * \param index index for statistics
+   * \returns the packet delivery ratio
+   */
+  static double GetPdr (const std::vector<int64_t> &counts, const std::vector<int64_t> &expected, int index)
+  {
+    double pdr = 0.0;
+    if (expected[index - 1] > 0)
+      {
+        pdr = (double) counts[index - 1] / (double) expected[index - 1];
+        if (pdr > 1.0)
+          {
+            pdr = 1.0;
+          }
+      }
+    return pdr;
+  }
+
+  std::vector<double> m_rangesSq; ///< ranges squared, by index
+  std::vector<int64_t> m_expected; ///< packet expected receive counts, by index - 1
+  std::vector<int64_t> m_inRange; ///< packet in coverage receive counts, by index - 1
+  std::vector<int64_t> m_totalExpected; ///< total packet expected receive counts, by index - 1
+  std::vector<int64_t> m_totalInRange; ///< total packet in coverage receive counts, by index - 1
+};
+
+/**
+ * \ingroup wave-test
+ * \ingroup tests
+ *
+ * \brief This test case feeds WaveBsmStats and a per-range loop with the
+ * same distances and checks that they count the same.
+ * In particular, it checks the following:
+ * - unsorted and duplicate ranges, and distances on their boundaries
+ * - ranges set again unchanged, as every application does
+ * - ranges changed after counts exist
+ * - the counts set to 0 every interval against the cumulative counts
+ * - the cumulative counts reset
+ */
+class WaveBsmStatsTestCase : public TestCase
+{
+public:
+  WaveBsmStatsTestCase (void);
+  virtual ~WaveBsmStatsTestCase (void);
+
+private:
+  /**
+   * Count receptions at distances in both stats
+   * \param seed the first distance
+   * \param n the number of distances
+   */
+  void Count (uint32_t seed, uint32_t n);
+  /**
+   * Set the ranges of both stats
+   * \param rangesSq the ranges squared
+   */
+  void SetRangesSq (const std::vector<double> &rangesSq);
+  /**
+   * Check that both stats agree
+   * \param step the step of the test
+   */
+  void Check (const std::string &step);
+  virtual void DoRun (void);
+
+  Ptr<WaveBsmStats> m_stats; ///< the stats under test
+  PerRangeBsmCounts m_reference; ///< the reference counts
+};
+
+WaveBsmStatsTestCase::WaveBsmStatsTestCase (void)
+  : TestCase ("wave-bsm-stats")
+{
+}
+WaveBsmStatsTestCase::~WaveBsmStatsTestCase (void)
+{
+}
+
+void
+WaveBsmStatsTestCase::Count (uint32_t seed, uint32_t n)
+{
+  for (uint32_t i = 0; i != n; ++i)
+    {
+      // distances up to 200 m, the multiples of 100 m ^ 2 land on range
+      // boundaries
+      uint32_t k = seed + i;
+      double distSq = (k * 7919) % 400 * 100.0 + ((k % 3) == 0 ? 0.0 : 37.5);
+      m_stats->CountExpectedRxPkt (distSq);
+      m_reference.CountExpected (distSq);
+      // two out of three expected packets are received
+      if ((k % 3) != 2)
+        {
+          m_stats->CountRxPktInRange (distSq);
+          m_reference.CountInRange (distSq);
+        }
+    }
+}
+
+void
+WaveBsmStatsTestCase::SetRangesSq (const std::vector<double> &rangesSq)
+{
+  m_stats->SetTxSafetyRangesSq (rangesSq);
+  m_reference.SetRangesSq (rangesSq);
+}
+
+void
+WaveBsmStatsTestCase::Check (const std::string &step)
+{
+  for (int index = 1; index <= 10; index++)
+    {
+      NS_TEST_EXPECT_MSG_EQ (m_stats->GetExpectedRxPktCount (index), m_reference.m_expected[index - 1],
+                             step << ": expected count of range " << index);
+      NS_TEST_EXPECT_MSG_EQ (m_stats->GetRxPktInRangeCount (index), m_reference.m_inRange[index - 1],
+                             step << ": in range count of range " << index);
+      NS_TEST_EXPECT_MSG_EQ_TOL (m_stats->GetBsmPdr (index),
+                                 PerRangeBsmCounts::GetPdr (m_reference.m_inRange, m_reference.m_expected, index), 1e-12,
+                                 step << ": PDR of range " << index);
+      NS_TEST_EXPECT_MSG_EQ_TOL (m_stats->GetCumulativeBsmPdr (index),
+                                 PerRangeBsmCounts::GetPdr (m_reference.m_totalInRange, m_reference.m_totalExpected, index), 1e-12,
+                                 step << ": cumulative PDR of range " << index);
+    }
+}
+
+void
+WaveBsmStatsTestCase::DoRun (void)
+{
+  m_stats = CreateObject<WaveBsmStats> ();
+
+  // unsorted ranges with a duplicate, from 10 m to 150 m
+  std::vector<double> rangesSq;
+  rangesSq.push_back (2500.0);
+  rangesSq.push_back (100.0);
+  rangesSq.push_back (10000.0);
+  rangesSq.push_back (100.0);
+  rangesSq.push_back (22500.0);
+  rangesSq.push_back (900.0);
+  SetRangesSq (rangesSq);
+  Count (0, 500);
+  Check ("first interval");
+
+  // every application sets the same ranges
+  SetRangesSq (rangesSq);
+  Count (500, 100);
+  Check ("ranges set again");
+
+  // the counts of an interval are set to 0 at its end, the cumulative
+  // counts go on
+  for (int index = 1; index <= 10; index++)
+    {
+      m_stats->SetExpectedRxPktCount (index, 0);
+      m_stats->SetRxPktInRangeCount (index, 0);
+      m_reference.m_expected[index - 1] = 0;
+      m_reference.m_inRange[index - 1] = 0;
+    }
+  Check ("interval reset");
+  Count (600, 300);
+  Check ("second interval");
+
+  // counts so far stay with their index when the ranges change
+  rangesSq.clear ();
+  rangesSq.push_back (40000.0);
+  rangesSq.push_back (400.0);
+  rangesSq.push_back (6400.0);
+  rangesSq.push_back (400.0);
+  SetRangesSq (rangesSq);
+  Check ("ranges changed");
+  Count (900, 400);
+  Check ("third interval");
+
+  // the cumulative counts restart
+  for (int index = 1; index <= 10; index++)
+    {
+      m_stats->ResetTotalRxPktCounts (index);
+      m_reference.m_totalExpected[index - 1] = 0;
+      m_reference.m_totalInRange[index - 1] = 0;
+    }
+  Check ("cumulative reset");
+  Count (1300, 200);
+  m_stats->IncExpectedRxPktCount (2);
+  m_reference.m_expected[1]++;
+  m_reference.m_totalExpected[1]++;
+  Check ("after cumulative reset");
+
+  m_stats = 0;
+}
+
+/**
+ * \ingroup wave-test
+ * \ingroup tests
+ *
+ * \brief This test case runs the same small VANET with BSMs installed
+ * with and without the high-scale mode of WaveBsmHelper, and checks that
+ * both count the same BSMs sent, received, expected to be received and
+ * received in range.
+ */
+class WaveBsmHighScaleTestCase : public TestCase
+{
+public:
+  WaveBsmHighScaleTestCase (void);
+  virtual ~WaveBsmHighScaleTestCase (void);
+
+private:
+  /// The BSM counts of a run
+  struct Counts
+  {
+    int64_t tx; ///< BSMs sent
+    int64_t rx; ///< BSMs received
+    std::vector<int64_t> expected; ///< expected receptions, by range index - 1
+    std::vector<int64_t> inRange; ///< receptions in range, by range index - 1
+  };
+  /**
+   * Run the scenario
+   * \param highScale whether to install the BSMs in high-scale mode
+   * \returns the BSM counts of the run
+   */
+  Counts RunScenario (bool highScale);
+  virtual void DoRun (void);
+};
+
+WaveBsmHighScaleTestCase::WaveBsmHighScaleTestCase (void)
+  : TestCase ("wave-bsm-high-scale")
+{
+}
+
+WaveBsmHighScaleTestCase::~WaveBsmHighScaleTestCase (void)
+{
+}
+
+WaveBsmHighScaleTestCase::Counts
+WaveBsmHighScaleTestCase::RunScenario (bool highScale)
+{
+  // both runs draw the same numbers
+  RngSeedManager::SetSeed (1);
+  RngSeedManager::SetRun (1);
+
+  // a row of vehicles 40 m apart at different speeds, so that
+  // the distances between them and the grid cells change
+  const uint32_t nNodes = 6;
+  NodeContainer nodes;
+  nodes.Create (nNodes);
+  MobilityHelper mobility;
+  mobility.SetPositionAllocator ("ns3::GridPositionAllocator",
+                                 "MinX", DoubleValue (0.0),
+                                 "MinY", DoubleValue (0.0),
+                                 "DeltaX", DoubleValue (40.0),
+                                 "GridWidth", UintegerValue (nNodes),
+                                 "LayoutType", StringValue ("RowFirst"));
+  mobility.SetMobilityModel ("ns3::ConstantVelocityMobilityModel");
+  mobility.Install (nodes);
+  for (uint32_t i = 0; i < nNodes; i++)
+    {
+      nodes.Get (i)->GetObject<ConstantVelocityMobilityModel> ()->SetVelocity (Vector (5.0 * i, 0.0, 0.0));
+    }
+
+  YansWifiChannelHelper wifiChannel = YansWifiChannelHelper::Default ();
+  YansWifiPhyHelper wifiPhy = YansWifiPhyHelper::Default ();
+  wifiPhy.SetChannel (wifiChannel.Create ());
+  NqosWaveMacHelper wifi80211pMac = NqosWaveMacHelper::Default ();
+  Wifi80211pHelper wifi80211p = Wifi80211pHelper::Default ();
+  wifi80211p.SetRemoteStationManager ("ns3::ConstantRateWifiManager",
+                                      "DataMode", StringValue ("OfdmRate6MbpsBW10MHz"),
+                                      "ControlMode", StringValue ("OfdmRate6MbpsBW10MHz"));
+  NetDeviceContainer devices = wifi80211p.Install (wifiPhy, wifi80211pMac, nodes);
+
+  InternetStackHelper internet;
+  internet.Install (nodes);
+  Ipv4AddressHelper ipv4;
+  ipv4.SetBase ("10.1.0.0", "255.255.255.0");
+  Ipv4InterfaceContainer interfaces = ipv4.Assign (devices);
+
+  std::vector<double> ranges;
+  ranges.push_back (50.0);
+  ranges.push_back (100.0);
+  ranges.push_back (150.0);
+  WaveBsmHelper::GetNodesMoving ().assign (nNodes, 1);
+  WaveBsmHelper waveBsmHelper;
+  waveBsmHelper.SetHighScale (highScale);
+  waveBsmHelper.Install (interfaces, Seconds (3.0), 200, Seconds (0.1), 40, ranges, 0, MilliSeconds (10));
+
+  int64_t stream = 0;
+  stream += mobility.AssignStreams (nodes, stream);
+  stream += wifi80211p.AssignStreams (devices, stream);
+  stream += internet.AssignStreams (nodes, stream);
+  waveBsmHelper.AssignStreams (nodes, stream);
+
+  Simulator::Stop (Seconds (3.0));
+  Simulator::Run ();
+
+  Ptr<WaveBsmStats> stats = waveBsmHelper.GetWaveBsmStats ();
+  Counts counts;
+  counts.tx = stats->GetTxPktCount ();
+  counts.rx = stats->GetRxPktCount ();
+  for (int index = 1; index <= (int) ranges.size (); index++)
+    {
+      counts.expected.push_back (stats->GetExpectedRxPktCount (index));
+      counts.inRange.push_back (stats->GetRxPktInRangeCount (index));
+    }
+  Simulator::Destroy ();
+  return counts;
+}
+
+void
+WaveBsmHighScaleTestCase::DoRun (void)
+{
+  Counts counts = RunScenario (false);
+  Counts highScaleCounts = RunScenario (true);
+
+  NS_TEST_ASSERT_MSG_GT (counts.tx, 0, "no BSM sent");
+  NS_TEST_ASSERT_MSG_GT (counts.rx, 0, "no BSM received");
+  NS_TEST_EXPECT_MSG_EQ (highScaleCounts.tx, counts.tx, "BSMs sent in high-scale mode");
+  NS_TEST_EXPECT_MSG_EQ (highScaleCounts.rx, counts.rx, "BSMs received in high-scale mode");
+  for (size_t index = 1; index <= counts.expected.size (); index++)
+    {
+      NS_TEST_EXPECT_MSG_GT (counts.expected[index - 1], 0, "no BSM expected in range " << index);
+      NS_TEST_EXPECT_MSG_EQ (highScaleCounts.expected[index - 1], counts.expected[index - 1],
+                             "BSMs expected in range " << index << " in high-scale mode");
+      NS_TEST_EXPECT_MSG_EQ (highScaleCounts.inRange[index - 1], counts.inRange[index - 1],
+                             "BSMs received in range " << index << " in high-scale mode");
+    }
+}
+
+/**
+ * \ingroup wave-test
+ * \ingroup tests
+ *
+ * \brief Wave BSM Test Suite
+ */
+class WaveBsmTestSuite : public TestSuite
+{
+public:
+  WaveBsmTestSuite ();
+};
+
+WaveBsmTestSuite::WaveBsmTestSuite ()
+  : TestSuite ("wave-bsm", UNIT)
+{
+  // TestDuration for TestCase can be QUICK, EXTENSIVE or TAKES_FOREVER
+  AddTestCase (new WaveBsmStatsTestCase, TestCase::QUICK);
+  AddTestCase (new WaveBsmHighScaleTestCase, TestCase::QUICK);
+}
+
+// Do not forget to allocate an instance of this TestSuite
+static WaveBsmTestSuite waveBsmTestSuite; ///< the test suite